@@ -0,0 +1,1286 @@
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define CSTRING_IMPLEMENTATION
+#include "../cstring.h"
+
+static volatile int64_t SINK = 0;
+
+double nowSeconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+void printResult(const char *name, double seconds, size_t bytes, size_t iterations) {
+    double nsPerByte = seconds * 1e9 / ((double)bytes * (double)iterations);
+    double mbPerSec = ((double)bytes * (double)iterations) / seconds / (1 << 20);
+    printf("%-44s %10.3f ns/byte %12.1f MB/s\n", name, nsPerByte, mbPerSec);
+}
+
+TString repeatChar(char c, size_t n) {
+    TString s = stringInit(n);
+    stringAppendRepeat(&s, c, n);
+    return s;
+}
+
+int64_t naiveFindFirst(TString s, TString pattern) {
+    for (size_t i = 0; i < s.size; ++i) {
+        size_t match = 0;
+        for (size_t j = 0; i + j < s.size && j < pattern.size; ++j) {
+            if (stringData(&s)[i + j] != stringData(&pattern)[j]) break;
+            ++match;
+        }
+        if (match == pattern.size) return i;
+    }
+    return -1;
+}
+
+void benchFind(const char *name, TString hay, TString pattern, size_t iterations) {
+    char label[128];
+    double start = nowSeconds();
+    for (size_t i = 0; i < iterations; ++i) {
+        SINK += stringFindFirst(hay, pattern);
+    }
+    snprintf(label, sizeof(label), "stringFindFirst/%s", name);
+    printResult(label, nowSeconds() - start, hay.size, iterations);
+
+    start = nowSeconds();
+    for (size_t i = 0; i < iterations; ++i) {
+        SINK += naiveFindFirst(hay, pattern);
+    }
+    snprintf(label, sizeof(label), "naive/%s", name);
+    printResult(label, nowSeconds() - start, hay.size, iterations);
+}
+
+void bench_stringFindFirst() {
+    const size_t n = 1 << 20;
+    srand(1);
+    TString hay = stringRand(n);
+
+    TString shortPattern = stringSubstring(hay, n - 100, 6);
+    benchFind("short", hay, shortPattern, 50);
+
+    TString longPattern = stringSubstring(hay, n - 1000, 300);
+    benchFind("long", hay, longPattern, 50);
+
+    TString absent = stringInitWithCharArr("#absent#");
+    benchFind("absent", hay, absent, 50);
+
+    TString periodicHay = repeatChar('a', n);
+    TString periodicPattern = repeatChar('a', 1000);
+    stringData(&periodicPattern)[500] = 'b';
+    stringData(&periodicHay)[n - 500] = 'b';
+    benchFind("periodic", periodicHay, periodicPattern, 1);
+
+    stringDestroy(&hay);
+    stringDestroy(&shortPattern);
+    stringDestroy(&longPattern);
+    stringDestroy(&absent);
+    stringDestroy(&periodicHay);
+    stringDestroy(&periodicPattern);
+}
+
+void bench_stringPattern() {
+    const size_t records = 100000;
+    const size_t iterations = 20;
+    TString *data = (TString *)malloc(sizeof(TString) * records);
+    size_t totalBytes = 0;
+    srand(2);
+    for (size_t i = 0; i < records; ++i) {
+        data[i] = stringRand(48 + rand() % 32);
+        totalBytes += data[i].size;
+    }
+    const char *needle = "ERROR: connection";
+
+    double start = nowSeconds();
+    for (size_t it = 0; it < iterations; ++it) {
+        for (size_t i = 0; i < records; ++i) {
+            SINK += stringFindFirstCharArr(data[i], needle);
+        }
+    }
+    printResult("stringFindFirstCharArr/records", nowSeconds() - start, totalBytes, iterations);
+
+    TStringPattern pattern = stringPatternCompileCharArr(needle, true);
+    start = nowSeconds();
+    for (size_t it = 0; it < iterations; ++it) {
+        for (size_t i = 0; i < records; ++i) {
+            SINK += stringPatternFind(&pattern, data[i]);
+        }
+    }
+    printResult("stringPatternFind/records", nowSeconds() - start, totalBytes, iterations);
+
+    TStringPattern folded = stringPatternCompileCharArr(needle, false);
+    start = nowSeconds();
+    for (size_t it = 0; it < iterations; ++it) {
+        for (size_t i = 0; i < records; ++i) {
+            SINK += stringPatternFind(&folded, data[i]);
+        }
+    }
+    printResult("stringPatternFind/records-ignore-case", nowSeconds() - start, totalBytes, iterations);
+
+    stringPatternDestroy(&pattern);
+    stringPatternDestroy(&folded);
+    for (size_t i = 0; i < records; ++i) {
+        stringDestroy(&data[i]);
+    }
+    free(data);
+}
+
+TString randomWord(size_t len) {
+    TString s = stringInit(len);
+    for (size_t i = 0; i < len; ++i) {
+        stringData(&s)[i] = 'a' + rand() % 26;
+    }
+    s.size = len;
+    return s;
+}
+
+void benchMultiMatcher(size_t patternCount) {
+    char label[128];
+    const size_t n = 1 << 16;
+    TString hay = stringInit(n);
+    while (hay.size < n) {
+        TString word = randomWord(3 + rand() % 8);
+        for (size_t i = 0; i < word.size && hay.size < n; ++i) {
+            stringData(&hay)[hay.size++] = stringData(&word)[i];
+        }
+        if (hay.size < n) stringData(&hay)[hay.size++] = ' ';
+        stringDestroy(&word);
+    }
+    TStrVec patterns = stringVecInit(patternCount);
+    for (size_t i = 0; i < patternCount; ++i) {
+        TString word = randomWord(6 + rand() % 6);
+        stringVecPushBack(&patterns, word);
+        stringDestroy(&word);
+    }
+
+    double start = nowSeconds();
+    for (size_t i = 0; i < patterns.size; ++i) {
+        SINK += stringContains(hay, patterns.data[i]);
+    }
+    snprintf(label, sizeof(label), "naive stringContains/%zu patterns", patternCount);
+    printResult(label, nowSeconds() - start, hay.size, 1);
+
+    TStringMultiMatcher m = stringMultiMatcherCompile(patterns, true);
+    start = nowSeconds();
+    const size_t iterations = 20;
+    for (size_t i = 0; i < iterations; ++i) {
+        SINK += stringMultiMatcherFindAll(&m, hay, NULL, NULL);
+    }
+    snprintf(label, sizeof(label), "stringMultiMatcherFindAll/%zu patterns", patternCount);
+    printResult(label, nowSeconds() - start, hay.size, iterations);
+
+    stringMultiMatcherDestroy(&m);
+    stringVecDestroy(&patterns);
+    stringDestroy(&hay);
+}
+
+void bench_stringMultiMatcher() {
+    srand(3);
+    benchMultiMatcher(10);
+    benchMultiMatcher(100);
+    benchMultiMatcher(10000);
+}
+
+const char *simdLevelName(ESimdLevel level) {
+    switch (level) {
+        case SIMD_SCALAR:
+            return "scalar";
+        case SIMD_SWAR:
+            return "swar";
+        case SIMD_SSE2:
+            return "sse2";
+        case SIMD_AVX2:
+            return "avx2";
+    }
+    return "?";
+}
+
+void bench_stringCharClass() {
+    char label[128];
+    const size_t n = 1 << 16;
+    const size_t iterations = 2000;
+    TString digits = stringInit(n);
+    TString alphas = stringInit(n);
+    for (size_t i = 0; i < n; ++i) {
+        stringData(&digits)[i] = '0' + rand() % 10;
+        stringData(&alphas)[i] = (rand() % 2 ? 'a' : 'A') + rand() % 26;
+    }
+    digits.size = n;
+    alphas.size = n;
+    TString palindrome = stringDeepCopy(alphas);
+    stringReverse(&palindrome);
+    TString joined = stringConcat(alphas, palindrome);
+
+    ESimdLevel detected = stringGetSimdLevel();
+    for (int level = SIMD_SCALAR; level <= (int)detected; ++level) {
+        stringSetSimdLevel((ESimdLevel)level);
+        const char *name = simdLevelName((ESimdLevel)level);
+
+        double start = nowSeconds();
+        for (size_t i = 0; i < iterations; ++i) {
+            SINK += stringIsDigits(digits);
+        }
+        snprintf(label, sizeof(label), "stringIsDigits/%s", name);
+        printResult(label, nowSeconds() - start, n, iterations);
+
+        start = nowSeconds();
+        for (size_t i = 0; i < iterations; ++i) {
+            SINK += stringIsAlphas(alphas);
+        }
+        snprintf(label, sizeof(label), "stringIsAlphas/%s", name);
+        printResult(label, nowSeconds() - start, n, iterations);
+
+        start = nowSeconds();
+        for (size_t i = 0; i < iterations; ++i) {
+            SINK += stringCount(digits, '7');
+        }
+        snprintf(label, sizeof(label), "stringCount/%s", name);
+        printResult(label, nowSeconds() - start, n, iterations);
+
+        start = nowSeconds();
+        for (size_t i = 0; i < iterations; ++i) {
+            SINK += stringIsPalindrome(joined);
+        }
+        snprintf(label, sizeof(label), "stringIsPalindrome/%s", name);
+        printResult(label, nowSeconds() - start, joined.size, iterations);
+    }
+    stringSetSimdLevel(detected);
+
+    stringDestroy(&digits);
+    stringDestroy(&alphas);
+    stringDestroy(&palindrome);
+    stringDestroy(&joined);
+}
+
+void bench_stringCase() {
+    char label[128];
+    const size_t n = 1 << 16;
+    const size_t iterations = 2000;
+    TString text = stringInit(n);
+    for (size_t i = 0; i < n; ++i) {
+        stringData(&text)[i] = ' ' + rand() % 95;
+    }
+    text.size = n;
+    TString other = stringDeepCopy(text);
+    stringToUpper(&other);
+    TString header = stringInitWithCharArr("Content-Type");
+    TString headerOther = stringInitWithCharArr("content-type");
+
+    ESimdLevel detected = stringGetSimdLevel();
+    for (int level = SIMD_SCALAR; level <= (int)detected; ++level) {
+        stringSetSimdLevel((ESimdLevel)level);
+        const char *name = simdLevelName((ESimdLevel)level);
+
+        double start = nowSeconds();
+        for (size_t i = 0; i < iterations; ++i) {
+            stringToLower(&text);
+            stringToUpper(&text);
+        }
+        snprintf(label, sizeof(label), "stringToLower+stringToUpper/%s", name);
+        printResult(label, nowSeconds() - start, 2 * n, iterations);
+
+        start = nowSeconds();
+        for (size_t i = 0; i < iterations; ++i) {
+            SINK += stringIsEqualIgnoreCase(text, other);
+        }
+        snprintf(label, sizeof(label), "stringIsEqualIgnoreCase/%s", name);
+        printResult(label, nowSeconds() - start, n, iterations);
+
+        start = nowSeconds();
+        for (size_t i = 0; i < iterations * 1000; ++i) {
+            SINK += stringIsEqualIgnoreCase(header, headerOther);
+        }
+        snprintf(label, sizeof(label), "stringIsEqualIgnoreCase/header/%s", name);
+        printResult(label, nowSeconds() - start, header.size, iterations * 1000);
+    }
+    stringSetSimdLevel(detected);
+
+    stringDestroy(&text);
+    stringDestroy(&other);
+    stringDestroy(&header);
+    stringDestroy(&headerOther);
+}
+
+bool naiveIsEqual(TString s1, TString s2) {
+    if (s1.size != s2.size) return false;
+    for (size_t i = 0; i < s1.size; ++i) {
+        if (stringData(&s1)[i] != stringData(&s2)[i]) return false;
+    }
+    return true;
+}
+
+void bench_stringIsEqual() {
+    char label[128];
+    const size_t keys = 1024;
+    const size_t iterations = 2000;
+    const size_t lengths[] = {8, 12, 24, 64};
+    for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); ++l) {
+        TString a[1024];
+        TString b[1024];
+        for (size_t i = 0; i < keys; ++i) {
+            a[i] = stringRand(lengths[l]);
+            b[i] = stringDeepCopy(a[i]);
+            if (i % 2) stringData(&b[i])[lengths[l] - 1] ^= 1;
+        }
+
+        double start = nowSeconds();
+        for (size_t it = 0; it < iterations; ++it) {
+            for (size_t i = 0; i < keys; ++i) {
+                SINK += stringIsEqual(a[i], b[i]);
+            }
+        }
+        snprintf(label, sizeof(label), "stringIsEqual/%zu bytes", lengths[l]);
+        printResult(label, nowSeconds() - start, lengths[l], iterations * keys);
+
+        start = nowSeconds();
+        for (size_t it = 0; it < iterations; ++it) {
+            for (size_t i = 0; i < keys; ++i) {
+                SINK += naiveIsEqual(a[i], b[i]);
+            }
+        }
+        snprintf(label, sizeof(label), "naive equality/%zu bytes", lengths[l]);
+        printResult(label, nowSeconds() - start, lengths[l], iterations * keys);
+
+        for (size_t i = 0; i < keys; ++i) {
+            stringDestroy(&a[i]);
+            stringDestroy(&b[i]);
+        }
+    }
+}
+
+void bench_stringBuilder() {
+    const size_t lines = 100000;
+    const char *key = "metric_name_total=";
+    size_t bytes = 0;
+
+    double start = nowSeconds();
+    TString perByte = {0};
+    for (size_t i = 0; i < lines; ++i) {
+        for (const char *c = key; *c; ++c) {
+            stringPushBack(&perByte, *c);
+        }
+        TString number = stringInitWithInt((int64_t)i * 7919);
+        for (size_t j = 0; j < number.size; ++j) {
+            stringPushBack(&perByte, stringData(&number)[j]);
+        }
+        stringDestroy(&number);
+        stringPushBack(&perByte, '\n');
+    }
+    bytes = perByte.size;
+    printResult("stringPushBack/response", nowSeconds() - start, bytes, 1);
+
+    start = nowSeconds();
+    TString built = {0};
+    size_t keyLen = strlen(key);
+    for (size_t i = 0; i < lines; ++i) {
+        stringAppendChars(&built, key, keyLen);
+        stringAppendInt(&built, (int64_t)i * 7919);
+        stringAppendRepeat(&built, '\n', 1);
+    }
+    printResult("stringAppend/response", nowSeconds() - start, bytes, 1);
+    SINK += stringIsEqual(perByte, built);
+
+    start = nowSeconds();
+    stringReplaceAll(&built, "_total", "_count_sum");
+    printResult("stringReplaceAll/response", nowSeconds() - start, bytes, 1);
+
+    stringDestroy(&perByte);
+    stringDestroy(&built);
+}
+
+size_t handleRequest(TString request) {
+    TString response = stringInit(0);
+    size_t pos = 0;
+    while (pos < request.size) {
+        TString rest = stringSubstring(request, pos, request.size - pos);
+        int64_t end = stringFindFirstCharArr(rest, ";");
+        size_t len = end < 0 ? rest.size : (size_t)end;
+        TString field = stringSubstring(rest, 0, len);
+        int64_t eq = stringFindFirstCharArr(field, "=");
+        if (eq >= 0) {
+            TString key = stringSubstring(field, 0, (size_t)eq);
+            TString value = stringSubstring(field, (size_t)eq + 1, len - (size_t)eq - 1);
+            stringToUpper(&value);
+            TString line = stringJoinCharArr(key, value, ": ");
+            TString next = stringConcat(response, line);
+            stringDestroy(&response);
+            response = next;
+            stringDestroy(&line);
+            stringDestroy(&value);
+            stringDestroy(&key);
+        }
+        stringDestroy(&field);
+        stringDestroy(&rest);
+        pos += len + 1;
+    }
+    size_t size = response.size;
+    stringDestroy(&response);
+    return size;
+}
+
+void bench_stringArena() {
+    const size_t requests = 20000;
+    TString request = stringInitWithCharArr(
+        "user=alice;role=admin;region=eu-west-1;session=4f1c9a7e;"
+        "path=/api/v2/items;method=GET;accept=application/json;lang=en-US");
+
+    double start = nowSeconds();
+    for (size_t i = 0; i < requests; ++i) {
+        SINK += handleRequest(request);
+    }
+    printResult("request/malloc", nowSeconds() - start, request.size, requests);
+
+    TStringArena arena;
+    stringArenaInit(&arena, 1 << 16, NULL);
+    start = nowSeconds();
+    stringSetThreadAllocator(stringArenaAllocator(&arena));
+    for (size_t i = 0; i < requests; ++i) {
+        SINK += handleRequest(request);
+        stringArenaReset(&arena);
+    }
+    stringSetThreadAllocator(NULL);
+    printResult("request/arena", nowSeconds() - start, request.size, requests);
+
+    stringArenaDestroy(&arena);
+    stringDestroy(&request);
+}
+
+void bench_stringTokens() {
+    const size_t tokens = 4000000;
+    size_t bytes = 0;
+    TString line = stringInitWithCharArr("GET /api/items?id=42&sort=name HTTP/1.1");
+
+    double start = nowSeconds();
+    for (size_t i = 0; i < tokens; ++i) {
+        TString id = stringInitWithInt((int64_t)i);
+        TString field = stringSubstring(line, 4 + i % 8, 10);
+        stringToUpper(&field);
+        SINK += stringIsEqual(id, field) + stringLen(id);
+        bytes += id.size + field.size;
+        stringDestroy(&field);
+        stringDestroy(&id);
+    }
+    printResult(CSTRING_SSO_CAPACITY > 0 ? "tokens/inline" : "tokens/heap", nowSeconds() - start, bytes, 1);
+    stringDestroy(&line);
+}
+
+void bench_stringView() {
+    const size_t fields = 200000;
+    TString csv = {0};
+    for (size_t i = 0; i < fields; ++i) {
+        stringAppendCharArr(&csv, " ");
+        stringAppendInt(&csv, (int64_t)(i * 2654435761u % 1000000));
+        stringAppendCharArr(&csv, " ,");
+    }
+
+    TStringPattern separator = stringPatternCompileCharArr(",", true);
+    double start = nowSeconds();
+    size_t pos = 0;
+    while (pos < csv.size) {
+        int64_t comma = stringPatternFindNext(&separator, csv, pos);
+        TString field = stringSubstring(csv, pos, (size_t)comma - pos);
+        stringTrim(&field);
+        SINK += stringToInt(field);
+        stringDestroy(&field);
+        pos = (size_t)comma + 1;
+    }
+    printResult("parse/substring", nowSeconds() - start, csv.size, 1);
+    stringPatternDestroy(&separator);
+
+    start = nowSeconds();
+    TStringView rest = stringViewOf(&csv);
+    TStringView comma = stringViewFromCharArr(",");
+    while (rest.size > 0) {
+        int64_t end = stringViewFindFirst(rest, comma);
+        SINK += stringViewToInt(stringViewTrim(stringViewSubstring(rest, 0, (size_t)end)));
+        rest = stringViewSubstring(rest, (size_t)end + 1, rest.size);
+    }
+    printResult("parse/view", nowSeconds() - start, csv.size, 1);
+
+    stringDestroy(&csv);
+}
+
+void bench_stringSplit() {
+    const size_t records = 20000;
+    TString data = {0};
+    for (size_t i = 0; i < records; ++i) {
+        stringAppendCharArr(&data, "2024-05-01T12:00:00Z,eu-west-1,");
+        stringAppendInt(&data, (int64_t)i);
+        stringAppendCharArr(&data, ",GET,/api/v2/items/");
+        stringAppendInt(&data, (int64_t)(i * 31));
+        stringAppendCharArr(&data, ",200;");
+    }
+
+    double start = nowSeconds();
+    size_t fields = 0;
+    TStringPattern comma = stringPatternCompileCharArr(",", true);
+    size_t pos = 0;
+    while (pos <= data.size) {
+        int64_t end = stringPatternFindNext(&comma, data, pos);
+        if (end < 0) end = (int64_t)data.size;
+        TString field = stringSubstring(data, pos, (size_t)end - pos);
+        fields += field.size > 0;
+        stringDestroy(&field);
+        pos = (size_t)end + 1;
+    }
+    stringPatternDestroy(&comma);
+    printResult("split/find+substring ,", nowSeconds() - start, data.size, 1);
+    SINK += fields;
+
+    const size_t iterations = 50;
+    TStringView field;
+    start = nowSeconds();
+    for (size_t r = 0; r < iterations; ++r) {
+        TStringSplitIter it = stringSplitIter(stringViewOf(&data), ',');
+        while (stringSplitNext(&it, &field)) {
+            SINK += field.size;
+        }
+    }
+    printResult("split/iter ,", nowSeconds() - start, data.size, iterations);
+
+    start = nowSeconds();
+    for (size_t r = 0; r < iterations; ++r) {
+        TStringSplitIter it = stringSplitIterAnyOf(stringViewOf(&data), ",;");
+        while (stringSplitNext(&it, &field)) {
+            SINK += field.size;
+        }
+    }
+    printResult("split/iter any of ,;", nowSeconds() - start, data.size, iterations);
+
+    start = nowSeconds();
+    for (size_t r = 0; r < iterations; ++r) {
+        TStringSplitIter it = stringSplitIterSubstring(stringViewOf(&data), stringViewFromCharArr(",GET,"));
+        while (stringSplitNext(&it, &field)) {
+            SINK += field.size;
+        }
+    }
+    printResult("split/iter substring", nowSeconds() - start, data.size, iterations);
+
+    start = nowSeconds();
+    for (size_t r = 0; r < iterations; ++r) {
+        TStrVec parts = stringSplitCharArr(data, ",");
+        SINK += parts.size;
+        stringVecDestroy(&parts);
+    }
+    printResult("split/stringSplit ,", nowSeconds() - start, data.size, iterations);
+    stringDestroy(&data);
+}
+
+void bench_stringVec() {
+    const size_t tokens = 2000000;
+    char word[16];
+
+    double start = nowSeconds();
+    TStrVec plain = stringVecInit(0);
+    for (size_t i = 0; i < tokens; ++i) {
+        size_t len = 3 + i % 9;
+        memset(word, 'a' + (int)(i % 26), len);
+        stringVecPushBackView(&plain, (TStringView){word, len});
+    }
+    double pushPlain = nowSeconds() - start;
+
+    start = nowSeconds();
+    TStrVec packed = stringVecInitPacked(0, 0);
+    for (size_t i = 0; i < tokens; ++i) {
+        size_t len = 3 + i % 9;
+        memset(word, 'a' + (int)(i % 26), len);
+        stringVecPushBackView(&packed, (TStringView){word, len});
+    }
+    double pushPacked = nowSeconds() - start;
+    size_t bytes = packed.blobSize;
+    printResult("vec push/TString per item", pushPlain, bytes, 1);
+    printResult("vec push/packed", pushPacked, bytes, 1);
+
+    const size_t iterations = 10;
+    start = nowSeconds();
+    for (size_t r = 0; r < iterations; ++r) {
+        for (size_t i = 0; i < plain.size; ++i) {
+            TStringView item = stringViewOf(&plain.data[i]);
+            SINK += memchr(item.data, 'e', item.size) != NULL;
+        }
+    }
+    printResult("vec scan/TString per item", nowSeconds() - start, bytes, iterations);
+
+    start = nowSeconds();
+    for (size_t r = 0; r < iterations; ++r) {
+        TStrVecIter it = stringVecIter(&packed);
+        TStringView item;
+        while (stringVecIterNext(&it, &item)) {
+            SINK += memchr(item.data, 'e', item.size) != NULL;
+        }
+    }
+    printResult("vec scan/packed", nowSeconds() - start, bytes, iterations);
+
+    stringVecDestroy(&plain);
+    stringVecDestroy(&packed);
+}
+
+int compareStrings(const void *a, const void *b) {
+    return stringCompare(*(const TString *)a, *(const TString *)b);
+}
+
+void bench_stringVecSort() {
+    const size_t keys = 1000000;
+    char key[64];
+    TStrVec plain = stringVecInit(keys);
+    TStrVec packed = stringVecInitPacked(keys, keys * 32);
+    srand(7);
+    for (size_t i = 0; i < keys; ++i) {
+        int len = snprintf(key, sizeof(key), "https://example.com/%s/item/%d", rand() % 2 ? "api/v2" : "static",
+                           rand() % 5000000);
+        stringVecPushBackView(&plain, (TStringView){key, (size_t)len});
+        stringVecPushBackView(&packed, (TStringView){key, (size_t)len});
+    }
+    size_t bytes = packed.blobSize;
+
+    TString *copy = (TString *)malloc(sizeof(TString) * keys);
+    memcpy(copy, plain.data, sizeof(TString) * keys);
+    double start = nowSeconds();
+    qsort(copy, keys, sizeof(TString), compareStrings);
+    printResult("sort/qsort stringCompare", nowSeconds() - start, bytes, 1);
+    free(copy);
+
+    start = nowSeconds();
+    stringVecSort(&plain);
+    printResult("sort/stringVecSort", nowSeconds() - start, bytes, 1);
+
+    start = nowSeconds();
+    stringVecSort(&packed);
+    printResult("sort/stringVecSort packed", nowSeconds() - start, bytes, 1);
+
+    start = nowSeconds();
+    stringVecSortIgnoreCase(&packed);
+    printResult("sort/stringVecSortIgnoreCase packed", nowSeconds() - start, bytes, 1);
+
+    stringVecDestroy(&plain);
+    stringVecDestroy(&packed);
+}
+
+// the digit-at-a-time parser stringToInt used before
+int64_t digitLoopToInt(TStringView s) {
+    int64_t sign = 1;
+    size_t i = 0;
+    if (s.size > 0 && s.data[0] == '-') {
+        sign = -1;
+        ++i;
+    }
+    int64_t val = 0;
+    for (; i < s.size; ++i) {
+        int64_t digit = stringCharToInt(s.data[i]);
+        if (val > (INT64_MAX - digit) / 10) return val;
+        val = val * 10 + digit;
+    }
+    return val * sign;
+}
+
+void bench_stringToInt() {
+    const size_t count = 1000000;
+    const size_t rounds = 10;
+    TStrVec numbers = stringVecInitPacked(count, count * 12);
+    char buf[32];
+    srand(9);
+    for (size_t i = 0; i < count; ++i) {
+        // a mix of ids, counters and timestamps
+        int64_t v = rand() % 3 == 0 ? rand() % 1000 : (int64_t)rand() * 1000 + rand() % 1000;
+        int len = snprintf(buf, sizeof(buf), "%" PRId64, rand() % 4 == 0 ? -v : v);
+        stringVecPushBackView(&numbers, (TStringView){buf, (size_t)len});
+    }
+    size_t bytes = numbers.blobSize;
+
+    double start = nowSeconds();
+    for (size_t r = 0; r < rounds; ++r) {
+        for (size_t i = 0; i < count; ++i) {
+            SINK += digitLoopToInt(stringVecGet(&numbers, i));
+        }
+    }
+    printResult("toInt/digit loop", nowSeconds() - start, bytes, rounds);
+
+    start = nowSeconds();
+    for (size_t r = 0; r < rounds; ++r) {
+        for (size_t i = 0; i < count; ++i) {
+            TStringView v = stringVecGet(&numbers, i);
+            memcpy(buf, v.data, v.size);
+            buf[v.size] = '\0';
+            SINK += strtoll(buf, NULL, 10);
+        }
+    }
+    printResult("toInt/strtoll", nowSeconds() - start, bytes, rounds);
+
+    start = nowSeconds();
+    for (size_t r = 0; r < rounds; ++r) {
+        for (size_t i = 0; i < count; ++i) {
+            SINK += stringViewToInt(stringVecGet(&numbers, i));
+        }
+    }
+    printResult("toInt/stringViewToInt", nowSeconds() - start, bytes, rounds);
+    stringVecDestroy(&numbers);
+}
+
+// the digit-at-a-time parser stringToDouble used before
+double digitLoopToDouble(TStringView s) {
+    double number = 0;
+    double decimal = 0;
+    size_t i = s.size > 0 && s.data[0] == '-' ? 1 : 0;
+    for (; i < s.size && s.data[i] != '.'; ++i) {
+        number = number * 10.0 + (double)(s.data[i] - '0');
+    }
+    if (i < s.size) {
+        for (size_t j = s.size - 1; j > i; --j) {
+            decimal = (decimal + (double)(s.data[j] - '0')) / 10;
+        }
+    }
+    return s.size > 0 && s.data[0] == '-' ? -(number + decimal) : number + decimal;
+}
+
+void bench_stringToDouble() {
+    const size_t count = 1000000;
+    TStrVec numbers = stringVecInitPacked(count, count * 20);
+    char buf[64];
+    srand(13);
+    for (size_t i = 0; i < count; ++i) {
+        // latencies, ratios and full-precision values
+        double v = (double)rand() / RAND_MAX * 1000.0;
+        int len = snprintf(buf, sizeof(buf), i % 3 == 0 ? "%.17g" : "%.3f", v);
+        stringVecPushBackView(&numbers, (TStringView){buf, (size_t)len});
+    }
+    size_t bytes = numbers.blobSize;
+    double sum = 0;
+
+    double start = nowSeconds();
+    for (size_t i = 0; i < count; ++i) {
+        sum += digitLoopToDouble(stringVecGet(&numbers, i));
+    }
+    printResult("toDouble/digit loop (inexact)", nowSeconds() - start, bytes, 1);
+
+    start = nowSeconds();
+    for (size_t i = 0; i < count; ++i) {
+        TStringView v = stringVecGet(&numbers, i);
+        TString tmp = {.data = (char *)v.data, .size = v.size, .capacity = v.size};
+        char *copy = stringConvertToCharArr(tmp);
+        sum += strtod(copy, NULL);
+        stringFreeCharArr(&tmp, copy);
+    }
+    printResult("toDouble/stringConvertToCharArr+strtod", nowSeconds() - start, bytes, 1);
+
+    start = nowSeconds();
+    for (size_t i = 0; i < count; ++i) {
+        sum += stringViewToDouble(stringVecGet(&numbers, i));
+    }
+    printResult("toDouble/stringViewToDouble", nowSeconds() - start, bytes, 1);
+    SINK += (int64_t)sum;
+    stringVecDestroy(&numbers);
+}
+
+void bench_stringParseColumn() {
+    const size_t count = 1000000;
+    const size_t batch = 4096;
+    TString column = stringInit(count * 12);
+    char buf[32];
+    srand(12);
+    for (size_t i = 0; i < count; ++i) {
+        int len = snprintf(buf, sizeof(buf), "%d%c", rand() % 2000000 - 1000000, i % 8 == 7 ? '\n' : ',');
+        stringAppendChars(&column, buf, (size_t)len);
+    }
+    int64_t *values = (int64_t *)malloc(sizeof(int64_t) * batch);
+    uint8_t *errors = (uint8_t *)malloc(batch);
+
+    double start = nowSeconds();
+    TStringSplitIter it = stringSplitIterAnyOf(stringViewOf(&column), ",\n");
+    TStringView field;
+    while (stringSplitNext(&it, &field)) {
+        SINK += stringViewToInt(field);
+    }
+    printResult("column/stringSplitNext+stringViewToInt", nowSeconds() - start, column.size, 1);
+
+    start = nowSeconds();
+    TStringView rest = stringViewOf(&column);
+    size_t parsed = 0;
+    while ((parsed = stringParseInts(&rest, ",\n", values, errors, batch)) > 0) {
+        SINK += values[parsed - 1] + errors[0];
+    }
+    printResult("column/stringParseInts", nowSeconds() - start, column.size, 1);
+
+    free(values);
+    free(errors);
+    stringDestroy(&column);
+}
+
+// digit-by-digit push and reverse, as stringInitWithInt used to build numbers
+void pushBackInt(TString *s, int64_t n) {
+    TString digits = stringInit(20);
+    uint64_t v = n < 0 ? 0 - (uint64_t)n : (uint64_t)n;
+    do {
+        stringPushBack(&digits, (char)('0' + v % 10));
+        v /= 10;
+    } while (v > 0);
+    if (n < 0) stringPushBack(&digits, '-');
+    stringReverse(&digits);
+    stringAppendString(s, digits);
+    stringDestroy(&digits);
+}
+
+void bench_stringAppendInt() {
+    const size_t count = 2000000;
+    int64_t *values = (int64_t *)malloc(sizeof(int64_t) * count);
+    srand(17);
+    for (size_t i = 0; i < count; ++i) {
+        // small counters, byte totals and nanosecond timestamps
+        int64_t v = i % 3 == 0 ? rand() % 1000 : (int64_t)rand() * (i % 3 == 1 ? 1 : 1000003);
+        values[i] = i % 5 == 0 ? -v : v;
+    }
+    TString out = stringInit(count * 20);
+    char buf[32];
+
+    double start = nowSeconds();
+    for (size_t i = 0; i < count; ++i) {
+        pushBackInt(&out, values[i]);
+    }
+    size_t bytes = out.size;
+    printResult("appendInt/pushBack+reverse", nowSeconds() - start, bytes, 1);
+
+    out.size = 0;
+    start = nowSeconds();
+    for (size_t i = 0; i < count; ++i) {
+        int len = snprintf(buf, sizeof(buf), "%" PRId64, values[i]);
+        stringAppendChars(&out, buf, (size_t)len);
+    }
+    printResult("appendInt/snprintf+stringAppendChars", nowSeconds() - start, bytes, 1);
+
+    out.size = 0;
+    start = nowSeconds();
+    for (size_t i = 0; i < count; ++i) {
+        stringAppendInt(&out, values[i]);
+    }
+    printResult("appendInt/stringAppendInt", nowSeconds() - start, bytes, 1);
+
+    SINK += out.size;
+    stringDestroy(&out);
+    free(values);
+}
+
+void bench_stringAppendDouble() {
+    const size_t count = 1000000;
+    double *values = (double *)malloc(sizeof(double) * count);
+    srand(19);
+    for (size_t i = 0; i < count; ++i) {
+        // gauges with a few decimals, latencies in seconds and arbitrary ratios
+        if (i % 3 == 0) values[i] = (double)(rand() % 100000) / 100;
+        else if (i % 3 == 1) values[i] = (double)rand() * 1e-9;
+        else values[i] = (double)rand() / (double)(rand() | 1);
+    }
+    TString out = stringInit(count * 24);
+    char buf[32];
+
+    double start = nowSeconds();
+    for (size_t i = 0; i < count; ++i) {
+        int len = snprintf(buf, sizeof(buf), "%.17g", values[i]);
+        stringAppendChars(&out, buf, (size_t)len);
+    }
+    printResult("appendDouble/snprintf %.17g", nowSeconds() - start, out.size, 1);
+
+    out.size = 0;
+    start = nowSeconds();
+    for (size_t i = 0; i < count; ++i) {
+        stringAppendDouble(&out, values[i]);
+    }
+    printResult("appendDouble/stringAppendDouble", nowSeconds() - start, out.size, 1);
+
+    out.size = 0;
+    start = nowSeconds();
+    for (size_t i = 0; i < count; ++i) {
+        int len = snprintf(buf, sizeof(buf), "%.3f", values[i]);
+        stringAppendChars(&out, buf, (size_t)len);
+    }
+    printResult("appendDouble/snprintf %.3f", nowSeconds() - start, out.size, 1);
+
+    out.size = 0;
+    start = nowSeconds();
+    for (size_t i = 0; i < count; ++i) {
+        stringAppendDoubleFixed(&out, values[i], 3);
+    }
+    printResult("appendDouble/stringAppendDoubleFixed", nowSeconds() - start, out.size, 1);
+
+    SINK += out.size;
+    stringDestroy(&out);
+    free(values);
+}
+
+void bench_stringFormat() {
+    const size_t count = 500000;
+    TString service = stringInitWithCharArr("checkout-api");
+    const char *serviceCharArr = "checkout-api";
+    TString out = stringInit(count * 96);
+    char buf[256];
+
+    // the usual pattern: measure with vsnprintf, reserve, format again
+    double start = nowSeconds();
+    for (size_t i = 0; i < count; ++i) {
+        int len = snprintf(NULL, 0, "ts=%zu level=%s svc=%s latency=%.3f status=%d bytes=%zu",
+                           i, "info", serviceCharArr, (double)i * 0.001, 200 + (int)(i % 4), i * 17);
+        stringReserve(&out, out.size + (size_t)len + 1);
+        snprintf(buf, sizeof(buf), "ts=%zu level=%s svc=%s latency=%.3f status=%d bytes=%zu",
+                 i, "info", serviceCharArr, (double)i * 0.001, 200 + (int)(i % 4), i * 17);
+        stringAppendChars(&out, buf, (size_t)len);
+    }
+    size_t bytes = out.size;
+    printResult("format/snprintf twice", nowSeconds() - start, bytes, 1);
+
+    out.size = 0;
+    start = nowSeconds();
+    for (size_t i = 0; i < count; ++i) {
+        stringAppendFormat(&out, "ts=%zu level=%s svc=%S latency=%.3f status=%d bytes=%zu",
+                           i, "info", service, (double)i * 0.001, 200 + (int)(i % 4), i * 17);
+    }
+    printResult("format/stringAppendFormat", nowSeconds() - start, bytes, 1);
+
+    SINK += out.size;
+    stringDestroy(&out);
+    stringDestroy(&service);
+}
+
+uint64_t fnv1a(const char *p, size_t n) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < n; ++i) {
+        h = (h ^ (unsigned char)p[i]) * 0x100000001b3ULL;
+    }
+    return h;
+}
+
+void bench_stringHash() {
+    const size_t sizes[] = {16, 64, 4096};
+    char label[64];
+    TString buf = stringRand(4096);
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+        size_t n = sizes[s];
+        size_t iterations = (64 << 20) / n;
+        double start = nowSeconds();
+        for (size_t i = 0; i < iterations; ++i) {
+            SINK += fnv1a(stringData(&buf), n - (i & 1));
+        }
+        snprintf(label, sizeof(label), "hash/fnv1a %zu", n);
+        printResult(label, nowSeconds() - start, n, iterations);
+
+        start = nowSeconds();
+        for (size_t i = 0; i < iterations; ++i) {
+            SINK += stringHashWithSeed(stringData(&buf), n - (i & 1), 0);
+        }
+        snprintf(label, sizeof(label), "hash/stringHashWithSeed %zu", n);
+        printResult(label, nowSeconds() - start, n, iterations);
+    }
+    stringDestroy(&buf);
+}
+
+void bench_stringHashMap() {
+    const size_t distinct = 100000;
+    const size_t tokens = 4000000;
+    char key[64];
+    TStrVec keys = stringVecInitPacked(distinct, distinct * 24);
+    for (size_t i = 0; i < distinct; ++i) {
+        int len = snprintf(key, sizeof(key), "http_requests_%zu", i);
+        stringVecPushBackView(&keys, (TStringView){key, (size_t)len});
+    }
+    size_t *order = (size_t *)malloc(sizeof(size_t) * tokens);
+    size_t bytes = 0;
+    srand(3);
+    for (size_t i = 0; i < tokens; ++i) {
+        order[i] = (size_t)rand() % distinct;
+        bytes += stringVecGet(&keys, order[i]).size;
+    }
+
+    TStringMap m;
+    stringMapInit(&m, 0);
+    double start = nowSeconds();
+    for (size_t i = 0; i < tokens; ++i) {
+        *stringMapUpsert(&m, stringVecGet(&keys, order[i])) += 1;
+    }
+    printResult("hashmap/stringMapUpsert count", nowSeconds() - start, bytes, 1);
+
+    start = nowSeconds();
+    for (size_t i = 0; i < tokens; ++i) {
+        SINK += *stringMapFind(&m, stringVecGet(&keys, order[i]));
+    }
+    printResult("hashmap/stringMapFind hit", nowSeconds() - start, bytes, 1);
+
+    stringMapDestroy(&m);
+    stringVecDestroy(&keys);
+    free(order);
+}
+
+#define INTERN_BENCH_THREADS 4
+
+typedef struct {
+    TStringInterner *interner;
+    const TStrVec *keys;
+    size_t rounds;
+    int64_t sum;
+} TInternBenchJob;
+
+void *internBenchWorker(void *arg) {
+    TInternBenchJob *job = (TInternBenchJob *)arg;
+    for (size_t r = 0; r < job->rounds; ++r) {
+        TStrVecIter it = stringVecIter(job->keys);
+        TStringView key;
+        while (stringVecIterNext(&it, &key)) {
+            job->sum += stringIntern(job->interner, key);
+        }
+    }
+    return NULL;
+}
+
+void bench_stringInterner() {
+    const size_t distinct = 200000;
+    const size_t rounds = 10;
+    char key[64];
+    TStrVec keys = stringVecInitPacked(distinct, distinct * 32);
+    for (size_t i = 0; i < distinct; ++i) {
+        int len = snprintf(key, sizeof(key), "host-%zu.eu-west-1.example.com", i * 7919 % distinct);
+        stringVecPushBackView(&keys, (TStringView){key, (size_t)len});
+    }
+    size_t bytes = keys.blobSize;
+
+    // baseline: one private copy per occurrence
+    double start = nowSeconds();
+    for (size_t r = 0; r < rounds; ++r) {
+        for (size_t i = 0; i < distinct; ++i) {
+            TStringView v = stringVecGet(&keys, i);
+            TString copy = stringViewToString(v);
+            SINK += copy.size;
+            stringDestroy(&copy);
+        }
+    }
+    printResult("intern/stringDeepCopy per occurrence", nowSeconds() - start, bytes, rounds);
+
+    TStringInterner in;
+    stringInternerInit(&in);
+    TInternBenchJob job = {&in, &keys, rounds, 0};
+    start = nowSeconds();
+    internBenchWorker(&job);
+    printResult("intern/stringIntern 1 thread", nowSeconds() - start, bytes, rounds);
+    SINK += job.sum;
+    stringInternerDestroy(&in);
+
+    stringInternerInit(&in);
+    TInternBenchJob jobs[INTERN_BENCH_THREADS];
+    pthread_t threads[INTERN_BENCH_THREADS];
+    start = nowSeconds();
+    for (size_t t = 0; t < INTERN_BENCH_THREADS; ++t) {
+        jobs[t] = (TInternBenchJob){&in, &keys, rounds, 0};
+        pthread_create(&threads[t], NULL, internBenchWorker, &jobs[t]);
+    }
+    for (size_t t = 0; t < INTERN_BENCH_THREADS; ++t) {
+        pthread_join(threads[t], NULL);
+        SINK += jobs[t].sum;
+    }
+    printResult("intern/stringIntern 4 threads", nowSeconds() - start, bytes, rounds * INTERN_BENCH_THREADS);
+    stringInternerDestroy(&in);
+    stringVecDestroy(&keys);
+}
+
+void bench_stringReadLine() {
+    const size_t lines = 1000000;
+    FILE *f = tmpfile();
+    if (f == NULL) return;
+    for (size_t i = 0; i < lines; ++i) {
+        fprintf(f, "2024-05-01T12:00:%02zu.%06zuZ INFO request id=%zu path=/api/v1/items/%zu status=200\n",
+                i % 60, i % 1000000, i * 7919, i % 977);
+    }
+    size_t bytes = (size_t)ftell(f);
+
+    // what stringScan does: one getc and one push per byte
+    rewind(f);
+    double start = nowSeconds();
+    TString line = stringInit(128);
+    size_t count = 0;
+    int c;
+    while ((c = getc(f)) != EOF) {
+        if (c == '\n') {
+            SINK += line.size;
+            line.size = 0;
+            ++count;
+        } else {
+            stringPushBack(&line, (char)c);
+        }
+    }
+    printResult("readLine/getc+stringPushBack", nowSeconds() - start, bytes, 1);
+
+    rewind(f);
+    start = nowSeconds();
+    char *buf = NULL;
+    size_t cap = 0;
+    ssize_t len;
+    while ((len = getline(&buf, &cap, f)) > 0) {
+        SINK += len;
+    }
+    free(buf);
+    printResult("readLine/getline", nowSeconds() - start, bytes, 1);
+
+    rewind(f);
+    start = nowSeconds();
+    TStringReader r;
+    stringReaderInitFile(&r, f);
+    while (stringReadLine(&r, &line)) {
+        SINK += line.size;
+    }
+    stringReaderDestroy(&r);
+    printResult("readLine/stringReadLine", nowSeconds() - start, bytes, 1);
+
+    rewind(f);
+    start = nowSeconds();
+    TStringView view;
+    stringReaderInitFile(&r, f);
+    while (stringReadLineView(&r, &view)) {
+        SINK += view.size;
+    }
+    stringReaderDestroy(&r);
+    printResult("readLine/stringReadLineView", nowSeconds() - start, bytes, 1);
+
+    rewind(f);
+    start = nowSeconds();
+    stringReaderInitFile(&r, f);
+    while (stringReadToken(&r, &line)) {
+        SINK += line.size;
+    }
+    stringReaderDestroy(&r);
+    printResult("readLine/stringReadToken", nowSeconds() - start, bytes, 1);
+
+    SINK += count;
+    stringDestroy(&line);
+    fclose(f);
+}
+
+void bench_stringWrite() {
+    const size_t count = 1000000;
+    FILE *devNull = fopen("/dev/null", "w");
+    if (devNull == NULL) return;
+    int fd = fileno(devNull);
+    char key[64];
+    TStrVec lines = stringVecInitPacked(count, count * 48);
+    for (size_t i = 0; i < count; ++i) {
+        int len = snprintf(key, sizeof(key), "metric_%zu{host=\"node-%zu\"} %zu", i % 1000, i % 64, i * 31);
+        stringVecPushBackView(&lines, (TStringView){key, (size_t)len});
+    }
+    size_t bytes = lines.blobSize + count - 1;
+    TStringView newline = stringViewFromCharArr("\n");
+
+    // what stringPrint did: one putc per byte
+    double start = nowSeconds();
+    for (size_t i = 0; i < count; ++i) {
+        TStringView line = stringVecGet(&lines, i);
+        if (i > 0) putc('\n', devNull);
+        for (size_t j = 0; j < line.size; ++j) {
+            putc(line.data[j], devNull);
+        }
+    }
+    fflush(devNull);
+    printResult("write/putc per byte", nowSeconds() - start, bytes, 1);
+
+    start = nowSeconds();
+    TString joined = stringInit(bytes);
+    for (size_t i = 0; i < count; ++i) {
+        TStringView line = stringVecGet(&lines, i);
+        if (i > 0) stringPushBack(&joined, '\n');
+        stringAppendChars(&joined, line.data, line.size);
+    }
+    stringWriteFd(fd, joined);
+    printResult("write/join + stringWriteFd", nowSeconds() - start, bytes, 1);
+    stringDestroy(&joined);
+
+    start = nowSeconds();
+    stringVecWriteFile(devNull, &lines, newline);
+    fflush(devNull);
+    printResult("write/stringVecWriteFile", nowSeconds() - start, bytes, 1);
+
+    start = nowSeconds();
+    stringVecWriteFd(fd, &lines, newline);
+    printResult("write/stringVecWriteFd (writev)", nowSeconds() - start, bytes, 1);
+
+    stringVecDestroy(&lines);
+    fclose(devNull);
+}
+
+#define ERROR_BENCH_OPS 20000000
+
+// What every call used to do: store to one process-wide error code.
+static atomic_int SHARED_ERROR_CODE;
+
+typedef struct {
+    bool sharedState;
+    int64_t sum;
+} TErrorBenchJob;
+
+void *errorBenchWorker(void *arg) {
+    TErrorBenchJob *job = (TErrorBenchJob *)arg;
+    TString s = stringInit(64);
+    int64_t sum = 0;
+    for (size_t i = 0; i < ERROR_BENCH_OPS; ++i) {
+        char c = (char)('0' + i % 10);
+        if (s.size == 64) s.size = 0;
+        stringPushBack(&s, c);
+        sum += stringCharToInt(c);
+        if (job->sharedState) {
+            atomic_store_explicit(&SHARED_ERROR_CODE, ERR_NO_ERROR, memory_order_relaxed);
+            atomic_store_explicit(&SHARED_ERROR_CODE, ERR_NO_ERROR, memory_order_relaxed);
+        }
+    }
+    job->sum = sum + (int64_t)s.size;
+    stringDestroy(&s);
+    return NULL;
+}
+
+void bench_errorState() {
+    static const size_t threadCounts[] = {1, 2, 4, 8, 16, 32};
+    char label[64];
+    for (size_t shared = 0; shared < 2; ++shared) {
+        for (size_t k = 0; k < sizeof(threadCounts) / sizeof(threadCounts[0]); ++k) {
+            size_t count = threadCounts[k];
+            TErrorBenchJob jobs[32];
+            pthread_t threads[32];
+            double start = nowSeconds();
+            for (size_t t = 0; t < count; ++t) {
+                jobs[t] = (TErrorBenchJob){shared != 0, 0};
+                pthread_create(&threads[t], NULL, errorBenchWorker, &jobs[t]);
+            }
+            for (size_t t = 0; t < count; ++t) {
+                pthread_join(threads[t], NULL);
+                SINK += jobs[t].sum;
+            }
+            // ns/byte here is wall time per operation over all threads
+            snprintf(label, sizeof(label), "errorState/%s %zu threads", shared ? "shared global" : "thread-local", count);
+            printResult(label, nowSeconds() - start, ERROR_BENCH_OPS, count);
+        }
+    }
+}
+
+int main() {
+    bench_stringFindFirst();
+    bench_stringPattern();
+    bench_stringMultiMatcher();
+    bench_stringCharClass();
+    bench_stringCase();
+    bench_stringIsEqual();
+    bench_stringBuilder();
+    bench_stringArena();
+    bench_stringTokens();
+    bench_stringView();
+    bench_stringSplit();
+    bench_stringVec();
+    bench_stringVecSort();
+    bench_stringHash();
+    bench_stringHashMap();
+    bench_stringInterner();
+    bench_stringToInt();
+    bench_stringParseColumn();
+    bench_stringToDouble();
+    bench_stringAppendInt();
+    bench_stringAppendDouble();
+    bench_stringFormat();
+    bench_stringReadLine();
+    bench_stringWrite();
+    bench_errorState();
+    return 0;
+}
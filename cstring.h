@@ -1,11 +1,38 @@
 #ifndef CSTRING_LIB
 #define CSTRING_LIB
 
+#if !defined(__STDC_VERSION__) || __STDC_VERSION__ < 201112L
+#error "cstring.h requires C11: it uses <stdatomic.h>, _Alignas, _Thread_local and anonymous unions"
+#endif
+
 #include <assert.h>
+#include <errno.h>
 #include <inttypes.h>
+#include <stdarg.h>
+#include <stdatomic.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#if !defined(CSTRING_NO_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CSTRING_X86_SIMD
+#include <immintrin.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CSTRING_POSIX
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+// flockfile is only declared when the POSIX thread-safe stdio functions are
+// exposed, which strict -std=c11 builds do not do by default.
+#if defined(CSTRING_POSIX) && defined(_POSIX_THREAD_SAFE_FUNCTIONS) && \
+    ((defined(_POSIX_C_SOURCE) && _POSIX_C_SOURCE >= 199506L) || defined(__APPLE__))
+#define CSTRING_STDIO_LOCKING
+#endif
 
 typedef enum EErrorCode {
     ERR_NO_ERROR,
@@ -17,29 +44,262 @@ typedef enum EErrorCode {
     ERR_NULL_POINTER,
     ERR_NUMBER_OVERFLOW,
     ERR_INVALID_NUMBER_REPR,
+    ERR_INVALID_FORMAT,
+    ERR_IO,
 } EErrorCode;
 
 #define MAX_ERROR_MSG_LEN 300
-static EErrorCode ERROR_CODE = ERR_NO_ERROR;
-static char ERROR_BUF[MAX_ERROR_MSG_LEN] = {0};
+// Per thread: concurrent callers neither race on the error state nor bounce
+// its cache line between cores.
+static _Thread_local EErrorCode ERROR_CODE = ERR_NO_ERROR;
+static _Thread_local char ERROR_BUF[MAX_ERROR_MSG_LEN] = {0};
 
 int isError();
 const char *getErrorMsg();
 void setError(EErrorCode e);
 void clearError();
 
+typedef enum ESimdLevel {
+    SIMD_SCALAR,
+    SIMD_SWAR,
+    SIMD_SSE2,
+    SIMD_AVX2,
+} ESimdLevel;
+
+typedef struct TStringAllocator {
+    void *(*allocate)(void *ctx, size_t size);
+    void *(*reallocate)(void *ctx, void *ptr, size_t oldSize, size_t newSize);
+    void (*deallocate)(void *ctx, void *ptr, size_t size);
+    void *ctx;
+} TStringAllocator;
+
+// Strings up to this many bytes are stored inside TString itself; 0 disables it.
+// The inline bytes share storage with `data` and `capacity`, so the limit is
+// sizeof(char *) + sizeof(size_t) - 1 (15 on 64-bit targets) and sizeof(TString)
+// does not change. With inline storage enabled, `data` and `capacity` are only
+// meaningful for heap strings: read the bytes through stringData() and the
+// capacity through stringCapacity(). Code that reads the fields directly has to
+// be ported before enabling it.
+#ifndef CSTRING_SSO_CAPACITY
+#define CSTRING_SSO_CAPACITY 0
+#endif
+
+typedef struct TStringArenaChunk TStringArenaChunk;
+
+typedef struct TStringArena {
+    TStringAllocator allocator;
+    const TStringAllocator *parent;
+    TStringArenaChunk *first;
+    TStringArenaChunk *current;
+    char *last;
+    size_t chunkSize;
+} TStringArena;
+
+#if CSTRING_SSO_CAPACITY > 0
+// The top bit of capacity's most significant byte marks an inline string; heap
+// capacities never reach it.
+#define SSO_INLINE_TAG 0x80
+
+typedef struct TString {
+    union {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        struct {
+            size_t capacity;
+            char *data;
+        };
+        struct {
+            unsigned char ssoTag;
+            char sso[sizeof(char *) + sizeof(size_t) - 1];
+        };
+#else
+        struct {
+            char *data;
+            size_t capacity;
+        };
+        struct {
+            char sso[sizeof(char *) + sizeof(size_t) - 1];
+            unsigned char ssoTag;
+        };
+#endif
+    };
+    size_t size;
+    const TStringAllocator *allocator;
+} TString;
+
+_Static_assert(CSTRING_SSO_CAPACITY <= sizeof(((TString *)0)->sso),
+               "CSTRING_SSO_CAPACITY exceeds the bytes of data and capacity");
+#else
 typedef struct TString {
     char *data;
     size_t size;
     size_t capacity;
+    const TStringAllocator *allocator;
 } TString;
+#endif
+
+typedef struct TStringView {
+    const char *data;
+    size_t size;
+} TStringView;
+
+typedef struct TStringTwoWay {
+    size_t critPos;
+    size_t period;
+    bool periodic;
+} TStringTwoWay;
 
+typedef struct TStringPattern {
+    char *data;
+    size_t size;
+    bool caseSensitive;
+    bool compiled;
+    TStringTwoWay twoWay;
+} TStringPattern;
+
+typedef struct TStringMatchIter {
+    const TStringPattern *pattern;
+    TString str;
+    size_t pos;
+} TStringMatchIter;
+
+typedef enum ESplitMode {
+    SPLIT_BY_CHAR,
+    SPLIT_BY_ANY_OF,
+    SPLIT_BY_SUBSTRING,
+} ESplitMode;
+
+// Set maxSplits (0 = unlimited) and skipEmpty after creating the iterator.
+// Skipped empty fields do not count towards maxSplits.
+typedef struct TStringSplitIter {
+    TStringView rest;
+    TStringView delim;
+    ESplitMode mode;
+    char delimChar;
+    uint8_t anyOf[32];
+    size_t maxSplits;
+    size_t splits;
+    bool skipEmpty;
+    bool done;
+} TStringSplitIter;
+
+// A packed vector keeps every item in one blob: item i spans
+// blob[offsets[i], offsets[i + 1]) and `data` stays NULL.
 typedef struct TStrVec {
     TString *data;
     size_t size;
     size_t capacity;
+    bool packed;
+    char *blob;
+    size_t blobSize;
+    size_t blobCapacity;
+    size_t *offsets;
 } TStrVec;
 
+typedef struct TStrVecIter {
+    const TStrVec *vec;
+    size_t pos;
+} TStrVecIter;
+
+typedef struct TStringMatch {
+    size_t pos;
+    size_t pattern;
+} TStringMatch;
+
+typedef struct TStringMultiMatcher {
+    int32_t *delta;
+    int32_t *emit;
+    int32_t *dictLink;
+    int32_t *output;
+    int32_t *sameNext;
+    size_t *patternLens;
+    size_t numStates;
+    size_t numClasses;
+    size_t firstEmitRow;
+    size_t numPatterns;
+    uint8_t classes[256];
+} TStringMultiMatcher;
+
+// Interned strings are named by a 32-bit atom: the shard in the low bits and
+// the entry's position inside that shard above them.
+typedef uint32_t TStringAtom;
+
+#define STRING_ATOM_INVALID UINT32_MAX
+#define INTERN_SHARD_BITS 4
+#define INTERN_SHARDS (1 << INTERN_SHARD_BITS)
+#define INTERN_MAX_BLOCKS 32
+
+typedef struct TStringInternEntry TStringInternEntry;
+typedef struct TStringInternTable TStringInternTable;
+
+// Writers serialize on the shard lock; readers only follow published pointers.
+// Entries never move, and atom blocks double in size instead of reallocating,
+// so a view handed out stays valid until the interner is destroyed.
+typedef struct TStringInternShard {
+    _Alignas(64) atomic_flag lock;
+    _Atomic(TStringInternTable *) table;
+    _Atomic(TStringInternEntry **) blocks[INTERN_MAX_BLOCKS];
+    atomic_size_t count;
+    TStringInternTable *retired;
+    TStringArena arena;
+} TStringInternShard;
+
+typedef struct TStringInterner {
+    TStringInternShard shards[INTERN_SHARDS];
+} TStringInterner;
+
+typedef struct TStringMapSlot {
+    const char *key;
+    size_t size;
+    uint64_t hash;
+    int64_t value;
+} TStringMapSlot;
+
+// Open addressing with one control byte per slot: EMPTY, DELETED or the low
+// 7 bits of the key hash. Probes compare a group of 16 control bytes at once
+// and only touch slots whose byte matches. Keys are copied into `keys`.
+typedef struct TStringMap {
+    int8_t *ctrl;
+    TStringMapSlot *slots;
+    size_t capacity;
+    size_t size;
+    size_t growthLeft;
+    uint64_t seed;
+    TStringArena keys;
+} TStringMap;
+
+typedef struct TStringMapIter {
+    const TStringMap *map;
+    size_t pos;
+} TStringMapIter;
+
+// Block-buffered input from a FILE* or a file descriptor. Lines and tokens
+// are searched for inside the buffer, which only grows for lines longer than
+// a block. FILE* input is read with fread, so it waits for whole blocks;
+// descriptors return whatever read() delivers.
+typedef struct TStringReader {
+    FILE *file;
+    int fd;
+    char *buf;
+    size_t capacity;
+    size_t begin;
+    size_t end;
+    bool eof;
+} TStringReader;
+
+
+ESimdLevel stringGetSimdLevel();
+ESimdLevel stringSetSimdLevel(ESimdLevel level);
+
+const TStringAllocator *stringMallocAllocator();
+const TStringAllocator *stringGetDefaultAllocator();
+void stringSetDefaultAllocator(const TStringAllocator *allocator);
+const TStringAllocator *stringGetThreadAllocator();
+void stringSetThreadAllocator(const TStringAllocator *allocator);
+
+void stringArenaInit(TStringArena *arena, size_t chunkSize, const TStringAllocator *parent);
+const TStringAllocator *stringArenaAllocator(TStringArena *arena);
+void stringArenaReset(TStringArena *arena);
+void stringArenaDestroy(TStringArena *arena);
 
 bool stringCharIsDigit(char c);
 bool stringCharIsAlpha(char c);
@@ -70,11 +330,30 @@ int stringCompare(TString s1, TString s2);
 int64_t stringFindFirst(TString s, TString pattern);
 int64_t stringFindFirstCharArr(TString s, const char *pattern);
 int64_t stringToInt(TString s);
+uint64_t stringToUint(TString s);
+int32_t stringToInt32(TString s);
+
+TStringPattern stringPatternCompile(TString pattern, bool caseSensitive);
+TStringPattern stringPatternCompileCharArr(const char *pattern, bool caseSensitive);
+int64_t stringPatternFind(const TStringPattern *p, TString s);
+int64_t stringPatternFindNext(const TStringPattern *p, TString s, size_t from);
+size_t stringPatternCount(const TStringPattern *p, TString s);
+TStringMatchIter stringPatternIter(const TStringPattern *p, TString s);
+bool stringPatternIterNext(TStringMatchIter *it, size_t *pos);
+void stringPatternDestroy(TStringPattern *p);
+size_t stringCountSubstring(TString s, TString pattern);
 
 TString stringRand(size_t size);
 TString stringInit(size_t capacity);
+char *stringData(const TString *s);
+size_t stringCapacity(const TString *s);
+bool stringIsInline(const TString *s);
+TString stringInitWithAllocator(size_t capacity, const TStringAllocator *allocator);
 TString stringInitWithCharArr(const char *s);
 TString stringInitWithInt(int64_t n);
+TString stringInitWithUint(uint64_t n);
+TString stringInitWithDouble(double d);
+TString stringFormat(const char *format, ...);
 TString stringCopy(TString s);
 TString stringDeepCopy(TString s);
 TString stringSubstring(TString s, size_t pos, size_t len);
@@ -86,13 +365,29 @@ TString stringArrJoin(const TString *s, size_t count, TString delim);
 TString stringArrJoinCharArr(const TString *s, size_t count, const char *delim);
 
 char* stringConvertToCharArr(TString s);
+void stringFreeCharArr(const TString *s, char *arr);
 void stringScan(TString *s);
 void stringPrint(TString s);
 void stringDebug(TString s);
+bool stringWriteFile(FILE *file, TString s);
+bool stringWriteFd(int fd, TString s);
 
 void stringRemoveChar(TString *s, char c);
 void stringSwap(TString *s1, TString *s2);
 void stringPushBack(TString *s, char c);
+void stringReserve(TString *s, size_t capacity);
+void stringAppendChars(TString *s, const char *p, size_t len);
+void stringAppendCharArr(TString *s, const char *p);
+void stringAppendString(TString *s, TString other);
+void stringAppendInt(TString *s, int64_t n);
+void stringAppendUint(TString *s, uint64_t n);
+void stringAppendIntPadded(TString *s, int64_t n, size_t width);
+void stringAppendUintPadded(TString *s, uint64_t n, size_t width);
+void stringAppendDouble(TString *s, double d);
+void stringAppendDoubleFixed(TString *s, double d, size_t precision);
+void stringAppendFormat(TString *s, const char *format, ...);
+void stringAppendFormatV(TString *s, const char *format, va_list ap);
+void stringAppendRepeat(TString *s, char c, size_t count);
 void stringPushFront(TString *s, char c);
 void stringPopBack(TString *s);
 void stringPopFront(TString *s);
@@ -114,6 +409,91 @@ void stringCapitalize(TString *s);
 
 double stringToDouble(TString s);
 
+TStringView stringViewOf(const TString *s);
+TStringView stringViewFromCharArr(const char *s);
+TString stringViewToString(TStringView v);
+bool stringViewIsEqual(TStringView s1, TStringView s2);
+bool stringViewIsEqualIgnoreCase(TStringView s1, TStringView s2);
+bool stringViewStartWith(TStringView s, TStringView pref);
+bool stringViewEndWith(TStringView s, TStringView suffix);
+int stringViewCompare(TStringView s1, TStringView s2);
+int64_t stringViewFindFirst(TStringView s, TStringView pattern);
+int64_t stringViewToInt(TStringView s);
+uint64_t stringViewToUint(TStringView s);
+int32_t stringViewToInt32(TStringView s);
+int64_t stringViewParseInt(TStringView s, size_t *consumed);
+uint64_t stringViewParseUint(TStringView s, size_t *consumed);
+int32_t stringViewParseInt32(TStringView s, size_t *consumed);
+double stringViewToDouble(TStringView s);
+double stringViewParseDouble(TStringView s, size_t *consumed);
+TStringView stringViewSubstring(TStringView s, size_t pos, size_t len);
+TStringView stringViewTrimLeft(TStringView s);
+TStringView stringViewTrimRight(TStringView s);
+TStringView stringViewTrim(TStringView s);
+TStringView stringViewStripPrefix(TStringView s, TStringView pref);
+TStringView stringViewStripSuffix(TStringView s, TStringView suffix);
+
+TStringSplitIter stringSplitIter(TStringView s, char delim);
+TStringSplitIter stringSplitIterAnyOf(TStringView s, const char *delims);
+TStringSplitIter stringSplitIterSubstring(TStringView s, TStringView delim);
+bool stringSplitNext(TStringSplitIter *it, TStringView *field);
+TStrVec stringSplit(TString s, TString delim);
+TStrVec stringSplitCharArr(TString s, const char *delim);
+
+size_t stringParseInts(TStringView *rest, const char *delims, int64_t *out, uint8_t *errors, size_t capacity);
+size_t stringParseUints(TStringView *rest, const char *delims, uint64_t *out, uint8_t *errors, size_t capacity);
+size_t stringParseDoubles(TStringView *rest, const char *delims, double *out, uint8_t *errors, size_t capacity);
+
+void stringReaderInitFile(TStringReader *r, FILE *file);
+void stringReaderInitFd(TStringReader *r, int fd);
+bool stringReadLine(TStringReader *r, TString *line);
+bool stringReadLineView(TStringReader *r, TStringView *line);
+bool stringReadToken(TStringReader *r, TString *token);
+void stringReaderDestroy(TStringReader *r);
+
+TStrVec stringVecInit(size_t capacity);
+TStrVec stringVecInitPacked(size_t capacity, size_t bytes);
+void stringVecReserve(TStrVec *v, size_t capacity, size_t bytes);
+void stringVecPushBack(TStrVec *v, TString s);
+void stringVecPushBackCharArr(TStrVec *v, const char *s);
+void stringVecPushBackView(TStrVec *v, TStringView s);
+TStringView stringVecGet(const TStrVec *v, size_t i);
+TStrVecIter stringVecIter(const TStrVec *v);
+bool stringVecIterNext(TStrVecIter *it, TStringView *item);
+void stringVecClear(TStrVec *v);
+void stringVecSort(TStrVec *v);
+void stringVecSortIgnoreCase(TStrVec *v);
+void stringVecDestroy(TStrVec *v);
+bool stringVecWriteFile(FILE *file, const TStrVec *v, TStringView delim);
+bool stringVecWriteFd(int fd, const TStrVec *v, TStringView delim);
+
+TStringMultiMatcher stringMultiMatcherCompile(TStrVec patterns, bool caseSensitive);
+bool stringMultiMatcherFindFirst(const TStringMultiMatcher *m, TString s, TStringMatch *match);
+size_t stringMultiMatcherFindAll(const TStringMultiMatcher *m, TString s,
+                                 void (*onMatch)(TStringMatch, void *), void *ctx);
+void stringMultiMatcherDestroy(TStringMultiMatcher *m);
+
+void stringInternerInit(TStringInterner *in);
+TStringAtom stringIntern(TStringInterner *in, TStringView s);
+bool stringInternFind(TStringInterner *in, TStringView s, TStringAtom *atom);
+TStringView stringInternGet(TStringInterner *in, TStringAtom atom);
+size_t stringInternerSize(TStringInterner *in);
+void stringInternerDestroy(TStringInterner *in);
+
+uint64_t stringHash(TString s);
+uint64_t stringHashCharArr(const char *s);
+uint64_t stringHashWithSeed(const char *p, size_t n, uint64_t seed);
+uint64_t stringViewHash(TStringView s);
+
+void stringMapInit(TStringMap *m, size_t capacity);
+int64_t *stringMapUpsert(TStringMap *m, TStringView key);
+int64_t *stringMapFind(TStringMap *m, TStringView key);
+bool stringMapRemove(TStringMap *m, TStringView key);
+TStringMapIter stringMapIter(const TStringMap *m);
+bool stringMapIterNext(TStringMapIter *it, TStringView *key, int64_t *value);
+void stringMapClear(TStringMap *m);
+void stringMapDestroy(TStringMap *m);
+
 #endif
 
 // for testing:
@@ -155,8 +535,10 @@ void setError(EErrorCode e) {
     ERROR_CODE = e;
 }
 
+// Nearly every call starts here, so the success path only reads the state.
 void clearError() {
-    setError(ERR_NO_ERROR);
+    if (ERROR_CODE == ERR_NO_ERROR) return;
+    ERROR_CODE = ERR_NO_ERROR;
     *ERROR_BUF = '\0';
 }
 
@@ -177,33 +559,11 @@ bool stringCharOneOf(char c, const char *variants) {
 }
 
 void stringCopyCharArr(TString *dest, const char *s, size_t n) {
-    assert(dest != NULL && dest->data != NULL && dest->capacity >= n);
+    assert(dest != NULL && stringData(dest) != NULL && stringCapacity(dest) >= n);
+    char *data = stringData(dest);
     for (size_t i = 0; i < n && s[i] != '\0'; ++i) {
-        dest->data[i] = s[i];
-    }
-}
-
-int stringCompSubstr(
-    const char *s1, size_t pos1, size_t len1,
-    const char *s2, size_t pos2, size_t len2,
-    bool caseSensative) {
-    if (len1 > len2) return -1 * stringCompSubstr(s2, pos2, len2, s1, pos1, len1, caseSensative);
-    assert(s1 != NULL && s2 != NULL);
-    for (size_t i = 0; i < len1; ++i) {
-        if (caseSensative) {
-            if (s1[pos1 + i] != s2[pos2 + i]) {
-                if (s1[pos1 + 1] < s2[pos2 + i]) return 1;
-                return -1;
-            }
-        } else {
-            if (stringCharToLower(s1[pos1 + i]) != stringCharToLower(s2[pos2 + i])) {
-                if (stringCharToLower(s1[pos1 + 1]) < stringCharToLower(s2[pos2 + i])) return 1;
-                return -1;
-            }
-        }
+        data[i] = s[i];
     }
-    if (len1 != len2) return -1;
-    return 0;
 }
 
 size_t stringLenCharArr(const char *s) {
@@ -213,817 +573,6115 @@ size_t stringLenCharArr(const char *s) {
     return (size_t)(s - begin);
 }
 
-void stringIncreaseCap(TString *s) {
-    assert(s != NULL);
-    size_t newCap = s->capacity * 2;
-    if (newCap == 0) newCap = 1;
-    char *newData = (char *)malloc(sizeof(char) * newCap);
-    if (newData == NULL) {
-        setError(ERR_ALLOCATE_SPACE);
-        return;
-    }
+void *_stringMallocAllocate(void *ctx, size_t size) {
+    (void)ctx;
+    return malloc(size);
+}
 
-    swapPtr((void **)&s->data, (void **)&newData);
-    stringCopyCharArr(s, newData, s->size);
-    free(newData);
-    s->capacity = newCap;
+void *_stringMallocReallocate(void *ctx, void *ptr, size_t oldSize, size_t newSize) {
+    (void)ctx;
+    (void)oldSize;
+    return realloc(ptr, newSize);
 }
 
-// import 
+void _stringMallocDeallocate(void *ctx, void *ptr, size_t size) {
+    (void)ctx;
+    (void)size;
+    free(ptr);
+}
 
-bool stringCharIsDigit(char c) {
-    return ('0' <= c && c <= '9');
+static const TStringAllocator MALLOC_ALLOCATOR = {
+    _stringMallocAllocate,
+    _stringMallocReallocate,
+    _stringMallocDeallocate,
+    NULL,
+};
+// Any thread may replace the default while others allocate; the release store
+// publishes the allocator's fields along with the pointer.
+static _Atomic(const TStringAllocator *) DEFAULT_ALLOCATOR = &MALLOC_ALLOCATOR;
+static _Thread_local const TStringAllocator *THREAD_ALLOCATOR = NULL;
+
+const TStringAllocator *_stringDefaultAllocator() {
+    if (THREAD_ALLOCATOR != NULL) return THREAD_ALLOCATOR;
+    return atomic_load_explicit(&DEFAULT_ALLOCATOR, memory_order_acquire);
 }
 
-bool stringCharIsAlpha(char c) {
-    return (('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z'));
+// A string remembers the allocator that owns its buffer; strings that have
+// never allocated pick up the default at their first allocation.
+const TStringAllocator *_stringAllocatorOf(const TString *s) {
+    return s->allocator != NULL ? s->allocator : _stringDefaultAllocator();
 }
 
-bool stringCharIsAlphanum(char c) {
-    return stringCharIsDigit(c) || stringCharIsAlpha(c);
+void *_stringAllocate(const TStringAllocator *a, size_t size) {
+    return a->allocate(a->ctx, size);
 }
 
-char stringCharToLower(char c) {
-    if ('A' <= c && c <= 'Z') return 'a' + (c - 'A');
-    return c;
+void _stringDeallocate(const TStringAllocator *a, void *ptr, size_t size) {
+    if (ptr != NULL) a->deallocate(a->ctx, ptr, size);
 }
-char stringCharToUpper(char c) {
-    if ('a' <= c && c <= 'z') return 'A' + (c - 'a');
-    return c;
+
+#define ARENA_ALIGN 8
+#define ARENA_DEFAULT_CHUNK 4096
+
+struct TStringArenaChunk {
+    TStringArenaChunk *next;
+    size_t size;
+    size_t used;
+    char data[];
+};
+
+size_t _stringArenaRound(size_t size) {
+    if (size > SIZE_MAX - ARENA_ALIGN) return SIZE_MAX;
+    if (size == 0) return ARENA_ALIGN;
+    return (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
 }
 
-int stringCharToInt(char c) {
-    clearError();
-    if ('0' <= c && c <= '9') 
-        return c - '0';
-    setError(ERR_INVALID_NUMBER_REPR);
-    return -1;
+// Moves to the chunk after the current one, reusing chunks kept by a reset
+// when they are large enough and splicing in a fresh one otherwise.
+TStringArenaChunk *_stringArenaNextChunk(TStringArena *arena, size_t size) {
+    TStringArenaChunk *prev = arena->current;
+    TStringArenaChunk *next = prev != NULL ? prev->next : arena->first;
+    if (next == NULL || next->size < size) {
+        size_t chunkSize = size > arena->chunkSize ? size : arena->chunkSize;
+        if (chunkSize > SIZE_MAX - sizeof(TStringArenaChunk)) return NULL;
+        TStringArenaChunk *chunk = (TStringArenaChunk *)_stringAllocate(arena->parent, sizeof(TStringArenaChunk) + chunkSize);
+        if (chunk == NULL) return NULL;
+        chunk->size = chunkSize;
+        chunk->next = next;
+        if (prev != NULL) {
+            prev->next = chunk;
+        } else {
+            arena->first = chunk;
+        }
+        next = chunk;
+    }
+    next->used = 0;
+    arena->current = next;
+    return next;
 }
 
-bool stringStartWith(TString s, TString pref) {
-    if (s.size < pref.size) return false;
-    return stringCompSubstr(s.data, 0, pref.size, pref.data,
-                            0, pref.size, true /* caseSensative */) == 0;
+void *_stringArenaAllocate(void *ctx, size_t size) {
+    TStringArena *arena = (TStringArena *)ctx;
+    size_t rounded = _stringArenaRound(size);
+    TStringArenaChunk *chunk = arena->current;
+    if (chunk == NULL || chunk->size - chunk->used < rounded) {
+        chunk = _stringArenaNextChunk(arena, rounded);
+        if (chunk == NULL) return NULL;
+    }
+    char *res = chunk->data + chunk->used;
+    chunk->used += rounded;
+    arena->last = res;
+    return res;
 }
 
-bool stringStartWithCharArr(TString s, const char *pref) {
-    if (pref == NULL) return true;
-    size_t len = stringLenCharArr(pref);
-    if (s.size < len) return false;
-    return stringCompSubstr(s.data, 0, len, pref, 0, len, true /* caseSensative */) == 0;
+// Only the most recent allocation can grow or shrink in place; anything else
+// is copied to a new block and the old one is abandoned until the next reset.
+void *_stringArenaReallocate(void *ctx, void *ptr, size_t oldSize, size_t newSize) {
+    TStringArena *arena = (TStringArena *)ctx;
+    TStringArenaChunk *chunk = arena->current;
+    if (ptr == arena->last && chunk != NULL) {
+        size_t offset = (size_t)((char *)ptr - chunk->data);
+        size_t rounded = _stringArenaRound(newSize);
+        if (rounded <= chunk->size - offset) {
+            chunk->used = offset + rounded;
+            return ptr;
+        }
+    }
+    if (newSize <= oldSize) return ptr;
+    char *res = (char *)_stringArenaAllocate(ctx, newSize);
+    if (res == NULL) return NULL;
+    memcpy(res, ptr, oldSize);
+    return res;
 }
 
-bool stringEndWith(TString s, TString pref) {
-    if (s.size < pref.size) return false;
-    return stringCompSubstr(
-               s.data, s.size - pref.size, pref.size,
-               pref.data, 0, pref.size, true /* caseSensative */) == 0;
+void _stringArenaDeallocate(void *ctx, void *ptr, size_t size) {
+    (void)size;
+    TStringArena *arena = (TStringArena *)ctx;
+    if (ptr != arena->last || arena->current == NULL) return;
+    arena->current->used = (size_t)((char *)ptr - arena->current->data);
+    arena->last = NULL;
 }
 
-bool stringEndWithCharArr(TString s, const char *pref) {
-    if (pref == NULL) return true;
-    size_t len = stringLenCharArr(pref);
-    if (s.size < len) return false;
-    return stringCompSubstr(s.data, s.size - len, len, pref, 0, len, true /* caseSensative */) == 0;
+// Detection is idempotent, so threads racing through the lazy init all store
+// the same value; relaxed ordering is enough.
+static _Atomic(int) SIMD_LEVEL = -1;
+
+ESimdLevel _stringDetectSimdLevel() {
+#ifdef CSTRING_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return SIMD_AVX2;
+    if (__builtin_cpu_supports("sse2")) return SIMD_SSE2;
+#endif
+    return SIMD_SWAR;
 }
 
-bool stringIsEqual(TString s1, TString s2) {
-    return stringCompSubstr(s1.data, 0, s1.size, s2.data, 0, s2.size, true /* caseSensative */) == 0;
+ESimdLevel _stringSimdLevel() {
+    int level = atomic_load_explicit(&SIMD_LEVEL, memory_order_relaxed);
+    if (level < 0) {
+        level = _stringDetectSimdLevel();
+        atomic_store_explicit(&SIMD_LEVEL, level, memory_order_relaxed);
+    }
+    return (ESimdLevel)level;
 }
 
-bool stringIsEqualIgnoreCase(TString s1, TString s2) {
-    return stringCompSubstr(s1.data, 0, s1.size, s2.data, 0, s2.size, false /* caseSensative */) == 0;
+ESimdLevel stringGetSimdLevel() {
+    return _stringSimdLevel();
 }
 
-bool stringIsEmpty(TString s) {
-    return s.size == 0;
+ESimdLevel stringSetSimdLevel(ESimdLevel level) {
+    ESimdLevel supported = _stringDetectSimdLevel();
+    if (level > supported) level = supported;
+    atomic_store_explicit(&SIMD_LEVEL, (int)level, memory_order_relaxed);
+    return level;
 }
 
-bool stringIsDigits(TString s) {
-    if (s.size == 0) return false;
-    for (size_t i = 0; i < s.size; ++i) {
-        if (!stringCharIsDigit(s.data[i])) return false;
+// Two-Way string matching (Crochemore-Perrin): O(n + m) time, O(1) space.
+size_t _stringMaxSuffix(const unsigned char *p, size_t m, bool reversed, size_t *period) {
+    // maxSuffix starts at -1 and relies on unsigned wrap-around in p[maxSuffix + k]
+    size_t maxSuffix = SIZE_MAX;
+    size_t j = 0;
+    size_t k = 1;
+    size_t per = 1;
+    while (j + k < m) {
+        unsigned char a = p[j + k];
+        unsigned char b = p[maxSuffix + k];
+        if (reversed ? (b < a) : (a < b)) {
+            j += k;
+            k = 1;
+            per = j - maxSuffix;
+        } else if (a == b) {
+            if (k != per) {
+                ++k;
+            } else {
+                j += per;
+                k = 1;
+            }
+        } else {
+            maxSuffix = j++;
+            k = 1;
+            per = 1;
+        }
     }
-    return true;
+    *period = per;
+    return maxSuffix + 1;
 }
 
-bool stringIsAlphas(TString s) {
-    if (s.size == 0) return false;
-    for (size_t i = 0; i < s.size; ++i) {
-        if (!stringCharIsAlpha(s.data[i])) return false;
+void _stringTwoWayInit(TStringTwoWay *tw, const char *pattern, size_t m) {
+    const unsigned char *p = (const unsigned char *)pattern;
+    size_t period = 0;
+    size_t periodRev = 0;
+    size_t critPos = _stringMaxSuffix(p, m, false, &period);
+    size_t critPosRev = _stringMaxSuffix(p, m, true, &periodRev);
+    if (critPosRev >= critPos) {
+        critPos = critPosRev;
+        period = periodRev;
+    }
+    tw->critPos = critPos;
+    tw->periodic = memcmp(p, p + period, critPos) == 0;
+    if (tw->periodic) {
+        tw->period = period;
+    } else {
+        tw->period = (critPos > m - critPos ? critPos : m - critPos) + 1;
     }
-    return true;
 }
 
-bool stringContains(TString s, TString pattern) {
-    return stringFindFirst(s, pattern) > 0;
+// Lowercases ASCII letters when fold is 0x20 and is the identity when fold is 0.
+unsigned char _stringFoldChar(unsigned char c, unsigned char fold) {
+    return (unsigned char)(c - 'A') < 26 ? (c | fold) : c;
 }
 
-bool stringContainsCharArr(TString s, const char *pattern) {
-    return stringFindFirstCharArr(s, pattern) > 0;
+int64_t _stringTwoWaySearch(const TStringTwoWay *tw, const char *hay, size_t n,
+                            const char *pattern, size_t m, unsigned char fold) {
+    const unsigned char *h = (const unsigned char *)hay;
+    const unsigned char *p = (const unsigned char *)pattern;
+    size_t critPos = tw->critPos;
+    size_t j = 0;
+    if (n < m) return -1;
+
+    if (tw->periodic) {
+        // memory remembers the prefix already matched by the previous shift
+        size_t memory = 0;
+        while (j <= n - m) {
+            size_t i = critPos > memory ? critPos : memory;
+            while (i < m && p[i] == _stringFoldChar(h[i + j], fold)) ++i;
+            if (i >= m) {
+                i = critPos;
+                while (i > memory && p[i - 1] == _stringFoldChar(h[i - 1 + j], fold)) --i;
+                if (i <= memory) return (int64_t)j;
+                j += tw->period;
+                memory = m - tw->period;
+            } else {
+                j += i - critPos + 1;
+                memory = 0;
+            }
+        }
+    } else {
+        while (j <= n - m) {
+            size_t i = critPos;
+            while (i < m && p[i] == _stringFoldChar(h[i + j], fold)) ++i;
+            if (i >= m) {
+                i = critPos;
+                while (i > 0 && p[i - 1] == _stringFoldChar(h[i - 1 + j], fold)) --i;
+                if (i == 0) return (int64_t)j;
+                j += tw->period;
+            } else {
+                j += i - critPos + 1;
+            }
+        }
+    }
+    return -1;
 }
 
-size_t stringLen(TString s) {
-    return s.size;
+unsigned char _stringPatternFold(const TStringPattern *pat) {
+    return pat->caseSensitive ? 0 : 0x20;
 }
 
-bool stringIsPalindrome(TString s) {
-    for (size_t i = 0; i < (s.size + 1) / 2; ++i) {
-        if (s.data[i] != s.data[s.size - i - 1]) {
-            return false;
-        }
+int64_t _stringSearchTwoWayFrom(const TStringPattern *pat, const char *h, size_t n, size_t from) {
+    TStringTwoWay tw;
+    if (pat->compiled) {
+        tw = pat->twoWay;
+    } else {
+        _stringTwoWayInit(&tw, pat->data, pat->size);
     }
-    return true;
+    int64_t res = _stringTwoWaySearch(&tw, h + from, n - from, pat->data, pat->size, _stringPatternFold(pat));
+    return res < 0 ? -1 : res + (int64_t)from;
 }
 
-size_t stringCount(TString s, char c) {
-    if (s.size == 0) return 0;
-    size_t res = 0;
-    for (size_t i = 0; i < s.size; ++i) {
-        res += (s.data[i] == c);
-    }
-    return res;
+size_t _stringMismatchIgnoreCase(const char *a, const char *b, size_t n);
+
+bool _stringMatchesAt(const TStringPattern *pat, const char *h) {
+    if (pat->caseSensitive) return memcmp(h, pat->data, pat->size) == 0;
+    return _stringMismatchIgnoreCase(h, pat->data, pat->size) == pat->size;
 }
 
-int stringCompare(TString s1, TString s2) {
-    return stringCompSubstr(s1.data, 0, s1.size, s2.data, 0, s2.size, false /* caseSensative */);
+// The candidate filters below verify every position whose first and last bytes
+// match. Repetitive input can make that quadratic, so once verification work
+// outgrows the scanned prefix the rest of the haystack is handed to Two-Way.
+bool _stringSearchOverBudget(size_t work, size_t pos, size_t m) {
+    return work > 4 * pos + 16 * m + 256;
 }
 
-int64_t stringFindFirst(TString s, TString pattern) {
-    for (size_t i = 0; i < s.size; ++i) {
-        size_t match = 0;
-        for (size_t j = 0; i + j < s.size && j < pattern.size; ++j) {
-            if (s.data[i + j] != pattern.data[j]) break;
-            ++match;
-        }
-        if (match == pattern.size) return i;
-    }
-    return -1;
+// A haystack byte h can start a match of the (already folded) pattern byte c
+// iff (h | mask) == c, where mask is 0x20 for letters under case folding.
+unsigned char _stringFilterMask(const TStringPattern *pat, char c) {
+    return (!pat->caseSensitive && stringCharIsAlpha(c)) ? 0x20 : 0;
 }
 
-int64_t stringFindFirstCharArr(TString s, const char *pattern) {
-    if (pattern == NULL) {
-        setError(ERR_NULL_POINTER);
-        return -1;
-    }
-    size_t patternLen = stringLenCharArr(pattern);
-    for (size_t i = 0; i < s.size; ++i) {
-        size_t match = 0;
-        for (size_t j = 0; i + j < s.size && j < patternLen; ++j) {
-            if (s.data[i + j] != pattern[j]) break;
-            ++match;
+int64_t _stringSearchScalar(const TStringPattern *pat, const char *h, size_t n, size_t from) {
+    const size_t m = pat->size;
+    const unsigned char first = (unsigned char)pat->data[0];
+    const unsigned char last = (unsigned char)pat->data[m - 1];
+    const unsigned char firstMask = _stringFilterMask(pat, pat->data[0]);
+    const unsigned char lastMask = _stringFilterMask(pat, pat->data[m - 1]);
+    size_t work = 0;
+    for (size_t i = from; i + m <= n; ++i) {
+        if (firstMask == 0) {
+            const char *c = (const char *)memchr(h + i, first, n - m + 1 - i);
+            if (c == NULL) return -1;
+            i = (size_t)(c - h);
+        } else if (((unsigned char)h[i] | firstMask) != first) {
+            continue;
+        }
+        if (((unsigned char)h[i + m - 1] | lastMask) == last) {
+            if (_stringMatchesAt(pat, h + i)) return (int64_t)i;
+            work += m;
+            if (_stringSearchOverBudget(work, i - from, m)) {
+                return _stringSearchTwoWayFrom(pat, h, n, i);
+            }
         }
-        if (match == patternLen) return i;
     }
     return -1;
 }
 
-int64_t stringToInt(TString s) {
-    clearError();
-
-    int64_t sign = 1;
+#ifdef CSTRING_X86_SIMD
+__attribute__((target("sse2")))
+int64_t _stringSearchSse2(const TStringPattern *pat, const char *h, size_t n) {
+    const size_t m = pat->size;
+    const __m128i first = _mm_set1_epi8(pat->data[0]);
+    const __m128i last = _mm_set1_epi8(pat->data[m - 1]);
+    const __m128i firstMask = _mm_set1_epi8((char)_stringFilterMask(pat, pat->data[0]));
+    const __m128i lastMask = _mm_set1_epi8((char)_stringFilterMask(pat, pat->data[m - 1]));
+    size_t work = 0;
     size_t i = 0;
-
-    if (s.data[0] == '-') {
-        if (s.size == 20 && stringCompSubstr(s.data, 0, 20, "-9223372036854775808", 0, 20, false) == 0) {
-            return INT64_MIN;
+    for (; i + m - 1 + 16 <= n; i += 16) {
+        __m128i blockFirst = _mm_or_si128(_mm_loadu_si128((const __m128i *)(h + i)), firstMask);
+        __m128i blockLast = _mm_or_si128(_mm_loadu_si128((const __m128i *)(h + i + m - 1)), lastMask);
+        unsigned mask = (unsigned)_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(first, blockFirst), _mm_cmpeq_epi8(last, blockLast)));
+        while (mask != 0) {
+            size_t pos = i + (size_t)__builtin_ctz(mask);
+            if (_stringMatchesAt(pat, h + pos)) return (int64_t)pos;
+            work += m;
+            mask &= mask - 1;
         }
-        if (s.size == 1) {
-            setError(ERR_INVALID_NUMBER_REPR);
-            return 0;
+        if (_stringSearchOverBudget(work, i, m)) {
+            return _stringSearchTwoWayFrom(pat, h, n, i);
         }
-        sign = -1;
-        ++i;
     }
+    return _stringSearchScalar(pat, h, n, i);
+}
 
-    int64_t val = 0;
-    for (; i < s.size; ++i) {
-        int64_t digit = stringCharToInt(s.data[i]);
-        if (val > (INT64_MAX - digit) / 10) {
-            setError(ERR_NUMBER_OVERFLOW);
-            return val;
+__attribute__((target("avx2")))
+int64_t _stringSearchAvx2(const TStringPattern *pat, const char *h, size_t n) {
+    const size_t m = pat->size;
+    const __m256i first = _mm256_set1_epi8(pat->data[0]);
+    const __m256i last = _mm256_set1_epi8(pat->data[m - 1]);
+    const __m256i firstMask = _mm256_set1_epi8((char)_stringFilterMask(pat, pat->data[0]));
+    const __m256i lastMask = _mm256_set1_epi8((char)_stringFilterMask(pat, pat->data[m - 1]));
+    size_t work = 0;
+    size_t i = 0;
+    for (; i + m - 1 + 32 <= n; i += 32) {
+        __m256i blockFirst = _mm256_or_si256(_mm256_loadu_si256((const __m256i *)(h + i)), firstMask);
+        __m256i blockLast = _mm256_or_si256(_mm256_loadu_si256((const __m256i *)(h + i + m - 1)), lastMask);
+        unsigned mask = (unsigned)_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(first, blockFirst), _mm256_cmpeq_epi8(last, blockLast)));
+        while (mask != 0) {
+            size_t pos = i + (size_t)__builtin_ctz(mask);
+            if (_stringMatchesAt(pat, h + pos)) return (int64_t)pos;
+            work += m;
+            mask &= mask - 1;
         }
-        else {
-            val = val * 10 + digit;
+        if (_stringSearchOverBudget(work, i, m)) {
+            return _stringSearchTwoWayFrom(pat, h, n, i);
         }
     }
-    val = val * sign;
-
-    return val;
+    _mm256_zeroupper();
+    return _stringSearchScalar(pat, h, n, i);
 }
+#endif
 
-TString stringInit(size_t capacity) {
-    TString s = {0};
-    s.data = (char *)malloc(sizeof(char) * capacity);
-    if (s.data == NULL) {
-        setError(ERR_ALLOCATE_SPACE);
-        return s;
+int64_t _stringPatternSearch(const TStringPattern *pat, const char *h, size_t n, size_t from) {
+    const size_t m = pat->size;
+    if (from > n) return -1;
+    if (m == 0) return (int64_t)from;
+    if (m > n - from) return -1;
+    if (m == 1 && pat->caseSensitive) {
+        const char *c = (const char *)memchr(h + from, pat->data[0], n - from);
+        return c == NULL ? -1 : (int64_t)(c - h);
     }
-    s.capacity = capacity;
-    s.size = 0;
-    return s;
-}
+    if (m == 1) return _stringSearchScalar(pat, h, n, from);
 
-TString stringRand(size_t size) {
-    static const char randChars[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
-    size_t len = sizeof(randChars) / sizeof(char) - 1;
-    clearError();
-    TString res = stringInit(size);
-    if (isError()) {
-        return res;
-    }
-    for (size_t i = 0; i < size; ++i) {
-        res.data[i] = randChars[rand() % len];
+    int64_t res = -1;
+    switch (_stringSimdLevel()) {
+#ifdef CSTRING_X86_SIMD
+        case SIMD_AVX2:
+            res = _stringSearchAvx2(pat, h + from, n - from);
+            break;
+        case SIMD_SSE2:
+            res = _stringSearchSse2(pat, h + from, n - from);
+            break;
+#endif
+        default:
+            return _stringSearchScalar(pat, h, n, from);
     }
-    res.size = size;
-    return res;
+    return res < 0 ? -1 : res + (int64_t)from;
 }
 
-TString stringInitWithCharArr(const char *s) {
-    if (s == NULL) return (TString){0};
-    clearError();
-    size_t len = stringLenCharArr(s);
-    TString res = stringInit(len);
-    if (isError()) {
-        return res;
-    }
-    for (size_t i = 0; i < len; ++i) {
-        res.data[i] = s[i];
-    }
-    res.size = len;
-    return res;
+int64_t _stringSearch(const char *h, size_t n, const char *p, size_t m) {
+    TStringPattern pat = {0};
+    pat.data = (char *)p;
+    pat.size = m;
+    pat.caseSensitive = true;
+    return _stringPatternSearch(&pat, h, n, 0);
 }
 
-TString stringInitWithInt(int64_t n) {
-    clearError();
-    TString res = {0};
-    int sign = 1;
-    if (n == 0) return stringInitWithCharArr("0");
-    if (n < 0) {
-        sign = -1;
-        n *= -1;
-    }
-    while (n > 0) {
-        stringPushBack(&res, '0' + n % 10);
-        if (isError()) {
-            return (TString){0};
-        }
-        n /= 10;
-    }
-    if (sign == -1) {
-        stringPushBack(&res, '-');
-        if (isError()) {
-            return (TString){0};
-        }
-    }
-    stringReverse(&res);
-    return res;
-}
+// Character-class kernels. The SWAR versions work on 8 bytes in a uint64_t and
+// rely on every byte staying below 0x80 before the additions, so that the high
+// bit of each byte can act as a per-byte carry flag.
+#define SWAR_ONES 0x0101010101010101ULL
+#define SWAR_HIGHS 0x8080808080808080ULL
 
-TString stringCopy(TString s) {
-    TString res = s;
-    return res;
+uint64_t _stringLoad64(const char *p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
 }
 
-TString stringDeepCopy(TString s) {
-    clearError();
-    TString res = stringInit(s.capacity);
-    if (isError()) return (TString){0};
+// Byte 0 in the low bits regardless of host order.
+uint64_t _stringLoad64Le(const char *p) {
+    uint64_t v = _stringLoad64(p);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
 
-    for (size_t i = 0; i < s.size; ++i) {
-        res.data[i] = s.data[i];
+bool _stringAllInRangeScalar(const char *p, size_t n, unsigned char lo, unsigned char hi, unsigned char orMask) {
+    for (size_t i = 0; i < n; ++i) {
+        if ((unsigned char)(((unsigned char)p[i] | orMask) - lo) > hi - lo) return false;
     }
-    res.size = s.size;
-    return res;
+    return true;
 }
 
-TString stringConcat(TString s1, TString s2) {
-    clearError();
-    TString res = stringInit(s1.size + s2.size);
-    if (isError()) return (TString){0};
-
-    for (size_t i = 0; i < s1.size; ++i) {
-        res.data[i] = s1.data[i];
+bool _stringAllInRangeSwar(const char *p, size_t n, unsigned char lo, unsigned char hi, unsigned char orMask) {
+    const uint64_t mask = SWAR_ONES * orMask;
+    const uint64_t geLo = SWAR_ONES * (0x80 - lo);
+    const uint64_t gtHi = SWAR_ONES * (0x7F - hi);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint64_t x = _stringLoad64(p + i) | mask;
+        if ((x & SWAR_HIGHS) != 0) return false;
+        if (((x + geLo) & SWAR_HIGHS) != SWAR_HIGHS) return false;
+        if (((x + gtHi) & SWAR_HIGHS) != 0) return false;
     }
+    return _stringAllInRangeScalar(p + i, n - i, lo, hi, orMask);
+}
 
-    for (size_t i = 0; i < s2.size; ++i) {
-        res.data[s1.size + i] = s2.data[i];
+size_t _stringCountCharScalar(const char *p, size_t n, char c) {
+    size_t res = 0;
+    for (size_t i = 0; i < n; ++i) {
+        res += (p[i] == c);
     }
-    res.size = s1.size + s2.size;
-
     return res;
 }
 
-TString stringArrConcat(const TString *s, size_t count) {
-    if (s == NULL) {
-        setError(ERR_NULL_POINTER);
-        return (TString){0};
-    }
-    clearError();
-    size_t totalSize = 0;
-    for (size_t i = 0; i < count; ++i) {
-        totalSize += s[i].size;
+size_t _stringCountCharSwar(const char *p, size_t n, char c) {
+    const uint64_t pattern = SWAR_ONES * (unsigned char)c;
+    const uint64_t lows = ~SWAR_HIGHS;
+    size_t res = 0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint64_t y = _stringLoad64(p + i) ^ pattern;
+        // exact zero-byte detection: no borrow can leak between bytes
+        uint64_t zeros = ~(((y & lows) + lows) | y) & SWAR_HIGHS;
+        res += (size_t)__builtin_popcountll(zeros);
     }
+    return res + _stringCountCharScalar(p + i, n - i, c);
+}
 
-    TString res = stringInit(totalSize);
-    if (isError()) return (TString){0};
-
-    size_t ind = 0;
-    for (size_t i = 0; i < count; ++i) {
-        for (size_t j = 0; j < s[i].size; ++j) {
-            res.data[ind++] = s[i].data[j];
-        }
+bool _stringIsPalindromeScalar(const char *p, size_t n) {
+    for (size_t i = 0; i < n / 2; ++i) {
+        if (p[i] != p[n - i - 1]) return false;
     }
-    res.size = totalSize;
-    return res;
+    return true;
 }
 
-TString stringJoin(TString s1, TString s2, TString delim) {
-    clearError();
-    TString res = stringInit(s1.size + delim.size + s2.size);
-    if (isError()) return (TString){0};
-
-    for (size_t i = 0; i < s1.size; ++i) {
-        res.data[i] = s1.data[i];
+bool _stringIsPalindromeSwar(const char *p, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n / 2; i += 8) {
+        if (_stringLoad64(p + i) != __builtin_bswap64(_stringLoad64(p + n - i - 8))) return false;
     }
+    return _stringIsPalindromeScalar(p + i, n - 2 * i);
+}
 
-    for (size_t i = 0; i < delim.size; ++i) {
-        res.data[s1.size + i] = delim.data[i];
+#ifdef CSTRING_X86_SIMD
+__attribute__((target("sse2")))
+bool _stringAllInRangeSse2(const char *p, size_t n, unsigned char lo, unsigned char hi, unsigned char orMask) {
+    const __m128i mask = _mm_set1_epi8((char)orMask);
+    const __m128i low = _mm_set1_epi8((char)lo);
+    const __m128i limit = _mm_set1_epi8((char)(hi - lo));
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i x = _mm_sub_epi8(_mm_or_si128(_mm_loadu_si128((const __m128i *)(p + i)), mask), low);
+        // unsigned x <= limit iff max(x, limit) == limit
+        __m128i ok = _mm_cmpeq_epi8(_mm_max_epu8(x, limit), limit);
+        if (_mm_movemask_epi8(ok) != 0xFFFF) return false;
     }
+    return _stringAllInRangeSwar(p + i, n - i, lo, hi, orMask);
+}
 
-    for (size_t i = 0; i < s2.size; ++i) {
-        res.data[s1.size + delim.size + i] = s2.data[i];
+__attribute__((target("avx2")))
+bool _stringAllInRangeAvx2(const char *p, size_t n, unsigned char lo, unsigned char hi, unsigned char orMask) {
+    const __m256i mask = _mm256_set1_epi8((char)orMask);
+    const __m256i low = _mm256_set1_epi8((char)lo);
+    const __m256i limit = _mm256_set1_epi8((char)(hi - lo));
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        __m256i x = _mm256_sub_epi8(_mm256_or_si256(_mm256_loadu_si256((const __m256i *)(p + i)), mask), low);
+        __m256i y = _mm256_sub_epi8(_mm256_or_si256(_mm256_loadu_si256((const __m256i *)(p + i + 32)), mask), low);
+        __m256i ok = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_max_epu8(x, limit), limit),
+                                      _mm256_cmpeq_epi8(_mm256_max_epu8(y, limit), limit));
+        if (_mm256_movemask_epi8(ok) != -1) return false;
     }
-    res.size = s1.size + delim.size + s2.size;
-
-    return res;
+    _mm256_zeroupper();
+    return _stringAllInRangeSse2(p + i, n - i, lo, hi, orMask);
 }
 
-TString stringJoinCharArr(TString s1, TString s2, const char *delim) {
-    clearError();
+__attribute__((target("sse2")))
+size_t _stringCountCharSse2(const char *p, size_t n, char c) {
+    const __m128i pattern = _mm_set1_epi8(c);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i total = _mm_setzero_si128();
+    size_t i = 0;
+    while (i + 16 <= n) {
+        // byte counters overflow after 255 blocks, so flush them into 64-bit lanes
+        size_t blocks = (n - i) / 16;
+        if (blocks > 255) blocks = 255;
+        __m128i counts = _mm_setzero_si128();
+        for (size_t b = 0; b < blocks; ++b, i += 16) {
+            __m128i eq = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(p + i)), pattern);
+            counts = _mm_sub_epi8(counts, eq);
+        }
+        total = _mm_add_epi64(total, _mm_sad_epu8(counts, zero));
+    }
+    uint64_t lanes[2];
+    _mm_storeu_si128((__m128i *)lanes, total);
+    return (size_t)(lanes[0] + lanes[1]) + _stringCountCharScalar(p + i, n - i, c);
+}
+
+__attribute__((target("avx2")))
+size_t _stringCountCharAvx2(const char *p, size_t n, char c) {
+    const __m256i pattern = _mm256_set1_epi8(c);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i total = _mm256_setzero_si256();
+    size_t i = 0;
+    while (i + 32 <= n) {
+        size_t blocks = (n - i) / 32;
+        if (blocks > 255) blocks = 255;
+        __m256i counts = _mm256_setzero_si256();
+        for (size_t b = 0; b < blocks; ++b, i += 32) {
+            __m256i eq = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(p + i)), pattern);
+            counts = _mm256_sub_epi8(counts, eq);
+        }
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(counts, zero));
+    }
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i *)lanes, total);
+    _mm256_zeroupper();
+    return (size_t)(lanes[0] + lanes[1] + lanes[2] + lanes[3]) + _stringCountCharScalar(p + i, n - i, c);
+}
+
+__attribute__((target("sse2")))
+__m128i _stringReverse128(__m128i x) {
+    // SSE2 has no byte shuffle: swap bytes inside words, then reverse the words
+    x = _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));
+    x = _mm_shufflelo_epi16(x, 0x1B);
+    x = _mm_shufflehi_epi16(x, 0x1B);
+    return _mm_shuffle_epi32(x, 0x4E);
+}
+
+__attribute__((target("sse2")))
+bool _stringIsPalindromeSse2(const char *p, size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= n / 2; i += 16) {
+        __m128i front = _mm_loadu_si128((const __m128i *)(p + i));
+        __m128i back = _stringReverse128(_mm_loadu_si128((const __m128i *)(p + n - i - 16)));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(front, back)) != 0xFFFF) return false;
+    }
+    return _stringIsPalindromeSwar(p + i, n - 2 * i);
+}
+
+__attribute__((target("avx2")))
+bool _stringIsPalindromeAvx2(const char *p, size_t n) {
+    const __m256i reverse = _mm256_setr_epi8(
+        15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+        15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    size_t i = 0;
+    for (; i + 32 <= n / 2; i += 32) {
+        __m256i front = _mm256_loadu_si256((const __m256i *)(p + i));
+        __m256i back = _mm256_loadu_si256((const __m256i *)(p + n - i - 32));
+        back = _mm256_permute2x128_si256(_mm256_shuffle_epi8(back, reverse), back, 0x01);
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(front, back)) != -1) return false;
+    }
+    _mm256_zeroupper();
+    return _stringIsPalindromeSse2(p + i, n - 2 * i);
+}
+#endif
+
+bool _stringAllInRange(const char *p, size_t n, unsigned char lo, unsigned char hi, unsigned char orMask) {
+    switch (_stringSimdLevel()) {
+#ifdef CSTRING_X86_SIMD
+        case SIMD_AVX2:
+            return _stringAllInRangeAvx2(p, n, lo, hi, orMask);
+        case SIMD_SSE2:
+            return _stringAllInRangeSse2(p, n, lo, hi, orMask);
+#endif
+        case SIMD_SWAR:
+            return _stringAllInRangeSwar(p, n, lo, hi, orMask);
+        default:
+            return _stringAllInRangeScalar(p, n, lo, hi, orMask);
+    }
+}
+
+size_t _stringCountChar(const char *p, size_t n, char c) {
+    switch (_stringSimdLevel()) {
+#ifdef CSTRING_X86_SIMD
+        case SIMD_AVX2:
+            return _stringCountCharAvx2(p, n, c);
+        case SIMD_SSE2:
+            return _stringCountCharSse2(p, n, c);
+#endif
+        case SIMD_SWAR:
+            return _stringCountCharSwar(p, n, c);
+        default:
+            return _stringCountCharScalar(p, n, c);
+    }
+}
+
+bool _stringIsPalindromeBuf(const char *p, size_t n) {
+    switch (_stringSimdLevel()) {
+#ifdef CSTRING_X86_SIMD
+        case SIMD_AVX2:
+            return _stringIsPalindromeAvx2(p, n);
+        case SIMD_SSE2:
+            return _stringIsPalindromeSse2(p, n);
+#endif
+        case SIMD_SWAR:
+            return _stringIsPalindromeSwar(p, n);
+        default:
+            return _stringIsPalindromeScalar(p, n);
+    }
+}
+
+// Case kernels flip bit 0x20 of every byte in [lo, lo + 25]: lo = 'A' lowers and
+// lo = 'a' raises. Comparisons fold both sides to lower case in registers.
+void _stringChangeCaseScalar(char *p, size_t n, unsigned char lo) {
+    for (size_t i = 0; i < n; ++i) {
+        if ((unsigned char)((unsigned char)p[i] - lo) < 26) p[i] ^= 0x20;
+    }
+}
+
+uint64_t _stringChangeCase64(uint64_t x, unsigned char lo) {
+    const uint64_t lows = ~SWAR_HIGHS;
+    uint64_t geLo = (x & lows) + SWAR_ONES * (0x80 - lo);
+    uint64_t gtHi = (x & lows) + SWAR_ONES * (0x7F - (lo + 25));
+    uint64_t inRange = geLo & ~gtHi & ~x & SWAR_HIGHS;
+    return x ^ (inRange >> 2);
+}
+
+void _stringChangeCaseSwar(char *p, size_t n, unsigned char lo) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint64_t x = _stringChangeCase64(_stringLoad64(p + i), lo);
+        memcpy(p + i, &x, sizeof(x));
+    }
+    _stringChangeCaseScalar(p + i, n - i, lo);
+}
+
+size_t _stringMismatchIgnoreCaseScalar(const char *a, const char *b, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        if (stringCharToLower(a[i]) != stringCharToLower(b[i])) return i;
+    }
+    return n;
+}
+
+size_t _stringMismatchIgnoreCaseSwar(const char *a, const char *b, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint64_t x = _stringChangeCase64(_stringLoad64(a + i), 'A');
+        uint64_t y = _stringChangeCase64(_stringLoad64(b + i), 'A');
+        if (x != y) break;
+    }
+    return i + _stringMismatchIgnoreCaseScalar(a + i, b + i, n - i);
+}
+
+#ifdef CSTRING_X86_SIMD
+__attribute__((target("sse2")))
+__m128i _stringChangeCase128(__m128i x, unsigned char lo) {
+    const __m128i limit = _mm_set1_epi8(25);
+    __m128i t = _mm_sub_epi8(x, _mm_set1_epi8((char)lo));
+    __m128i inRange = _mm_cmpeq_epi8(_mm_max_epu8(t, limit), limit);
+    return _mm_xor_si128(x, _mm_and_si128(inRange, _mm_set1_epi8(0x20)));
+}
+
+__attribute__((target("sse2")))
+void _stringChangeCaseSse2(char *p, size_t n, unsigned char lo) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i *)(p + i));
+        _mm_storeu_si128((__m128i *)(p + i), _stringChangeCase128(x, lo));
+    }
+    _stringChangeCaseSwar(p + i, n - i, lo);
+}
+
+__attribute__((target("sse2")))
+size_t _stringMismatchIgnoreCaseSse2(const char *a, const char *b, size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i x = _stringChangeCase128(_mm_loadu_si128((const __m128i *)(a + i)), 'A');
+        __m128i y = _stringChangeCase128(_mm_loadu_si128((const __m128i *)(b + i)), 'A');
+        unsigned eq = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(x, y));
+        if (eq != 0xFFFF) return i + (size_t)__builtin_ctz(~eq);
+    }
+    return i + _stringMismatchIgnoreCaseSwar(a + i, b + i, n - i);
+}
+
+__attribute__((target("avx2")))
+__m256i _stringChangeCase256(__m256i x, unsigned char lo) {
+    const __m256i limit = _mm256_set1_epi8(25);
+    __m256i t = _mm256_sub_epi8(x, _mm256_set1_epi8((char)lo));
+    __m256i inRange = _mm256_cmpeq_epi8(_mm256_max_epu8(t, limit), limit);
+    return _mm256_xor_si256(x, _mm256_and_si256(inRange, _mm256_set1_epi8(0x20)));
+}
+
+__attribute__((target("avx2")))
+void _stringChangeCaseAvx2(char *p, size_t n, unsigned char lo) {
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(p + i));
+        _mm256_storeu_si256((__m256i *)(p + i), _stringChangeCase256(x, lo));
+    }
+    _mm256_zeroupper();
+    _stringChangeCaseSse2(p + i, n - i, lo);
+}
+
+__attribute__((target("avx2")))
+size_t _stringMismatchIgnoreCaseAvx2(const char *a, const char *b, size_t n) {
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i x = _stringChangeCase256(_mm256_loadu_si256((const __m256i *)(a + i)), 'A');
+        __m256i y = _stringChangeCase256(_mm256_loadu_si256((const __m256i *)(b + i)), 'A');
+        unsigned eq = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y));
+        if (eq != 0xFFFFFFFFu) return i + (size_t)__builtin_ctz(~eq);
+    }
+    _mm256_zeroupper();
+    return i + _stringMismatchIgnoreCaseSse2(a + i, b + i, n - i);
+}
+#endif
+
+void _stringChangeCase(char *p, size_t n, unsigned char lo) {
+    switch (_stringSimdLevel()) {
+#ifdef CSTRING_X86_SIMD
+        case SIMD_AVX2:
+            _stringChangeCaseAvx2(p, n, lo);
+            return;
+        case SIMD_SSE2:
+            _stringChangeCaseSse2(p, n, lo);
+            return;
+#endif
+        case SIMD_SWAR:
+            _stringChangeCaseSwar(p, n, lo);
+            return;
+        default:
+            _stringChangeCaseScalar(p, n, lo);
+            return;
+    }
+}
+
+size_t _stringMismatchIgnoreCase(const char *a, const char *b, size_t n) {
+    switch (_stringSimdLevel()) {
+#ifdef CSTRING_X86_SIMD
+        case SIMD_AVX2:
+            return _stringMismatchIgnoreCaseAvx2(a, b, n);
+        case SIMD_SSE2:
+            return _stringMismatchIgnoreCaseSse2(a, b, n);
+#endif
+        case SIMD_SWAR:
+            return _stringMismatchIgnoreCaseSwar(a, b, n);
+        default:
+            return _stringMismatchIgnoreCaseScalar(a, b, n);
+    }
+}
+
+// Keys are usually short, so lengths up to 16 are compared with two possibly
+// overlapping word loads per side instead of a call into memcmp.
+bool _stringEqualBuf(const char *a, const char *b, size_t n) {
+    if (n >= 8 && n <= 16) {
+        uint64_t head = _stringLoad64(a) ^ _stringLoad64(b);
+        uint64_t tail = _stringLoad64(a + n - 8) ^ _stringLoad64(b + n - 8);
+        return (head | tail) == 0;
+    }
+    if (n >= 4 && n < 8) {
+        uint32_t x[2];
+        uint32_t y[2];
+        memcpy(&x[0], a, 4);
+        memcpy(&x[1], a + n - 4, 4);
+        memcpy(&y[0], b, 4);
+        memcpy(&y[1], b + n - 4, 4);
+        return ((x[0] ^ y[0]) | (x[1] ^ y[1])) == 0;
+    }
+    if (n < 4) {
+        for (size_t i = 0; i < n; ++i) {
+            if (a[i] != b[i]) return false;
+        }
+        return true;
+    }
+    return memcmp(a, b, n) == 0;
+}
+
+// Lexicographic order over unsigned bytes, shorter prefix first; returns -1, 0 or 1.
+int _stringCompareBuf(const char *a, size_t alen, const char *b, size_t blen, bool caseSensitive) {
+    size_t n = alen < blen ? alen : blen;
+    if (n > 0) {
+        if (caseSensitive) {
+            int res = memcmp(a, b, n);
+            if (res != 0) return res < 0 ? -1 : 1;
+        } else {
+            size_t i = _stringMismatchIgnoreCase(a, b, n);
+            if (i < n) {
+                unsigned char x = (unsigned char)stringCharToLower(a[i]);
+                unsigned char y = (unsigned char)stringCharToLower(b[i]);
+                return x < y ? -1 : 1;
+            }
+        }
+    }
+    if (alen == blen) return 0;
+    return alen < blen ? -1 : 1;
+}
+
+// wyhash-style hashing: every step folds 16 input bytes through one 64x64->128
+// bit multiply, and inputs over 48 bytes run three independent lanes so the
+// multiplies overlap.
+static const uint64_t HASH_SECRET[4] = {
+    0x2d358dccaa6c78a5ULL,
+    0x8bb84b93962eacc9ULL,
+    0x4b33a62ed433d4a3ULL,
+    0x4d5a2da51de1aa47ULL,
+};
+
+void _stringMul128(uint64_t *a, uint64_t *b) {
+#ifdef __SIZEOF_INT128__
+    __uint128_t r = (__uint128_t)*a * *b;
+    *a = (uint64_t)r;
+    *b = (uint64_t)(r >> 64);
+#else
+    uint64_t ha = *a >> 32;
+    uint64_t hb = *b >> 32;
+    uint64_t la = (uint32_t)*a;
+    uint64_t lb = (uint32_t)*b;
+    uint64_t rh = ha * hb;
+    uint64_t rm0 = ha * lb;
+    uint64_t rm1 = hb * la;
+    uint64_t rl = la * lb;
+    uint64_t t = rl + (rm0 << 32);
+    uint64_t c = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+uint64_t _stringHashMix(uint64_t a, uint64_t b) {
+    _stringMul128(&a, &b);
+    return a ^ b;
+}
+
+uint64_t _stringLoad32(const char *p) {
+    uint32_t x;
+    memcpy(&x, p, sizeof(x));
+    return x;
+}
+
+uint64_t _stringHash(const char *p, size_t n, uint64_t seed) {
+    const unsigned char *u = (const unsigned char *)p;
+    seed ^= _stringHashMix(seed ^ HASH_SECRET[0], HASH_SECRET[1]);
+    uint64_t a = 0;
+    uint64_t b = 0;
+    if (n <= 16) {
+        if (n >= 4) {
+            size_t mid = (n >> 3) << 2;
+            a = (_stringLoad32(p) << 32) | _stringLoad32(p + mid);
+            b = (_stringLoad32(p + n - 4) << 32) | _stringLoad32(p + n - 4 - mid);
+        } else if (n > 0) {
+            a = ((uint64_t)u[0] << 16) | ((uint64_t)u[n >> 1] << 8) | u[n - 1];
+        }
+    } else {
+        size_t i = n;
+        if (i > 48) {
+            uint64_t lane1 = seed;
+            uint64_t lane2 = seed;
+            do {
+                seed = _stringHashMix(_stringLoad64(p) ^ HASH_SECRET[1], _stringLoad64(p + 8) ^ seed);
+                lane1 = _stringHashMix(_stringLoad64(p + 16) ^ HASH_SECRET[2], _stringLoad64(p + 24) ^ lane1);
+                lane2 = _stringHashMix(_stringLoad64(p + 32) ^ HASH_SECRET[3], _stringLoad64(p + 40) ^ lane2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= lane1 ^ lane2;
+        }
+        while (i > 16) {
+            seed = _stringHashMix(_stringLoad64(p) ^ HASH_SECRET[1], _stringLoad64(p + 8) ^ seed);
+            p += 16;
+            i -= 16;
+        }
+        a = _stringLoad64(p + i - 16);
+        b = _stringLoad64(p + i - 8);
+    }
+    a ^= HASH_SECRET[1];
+    b ^= seed;
+    _stringMul128(&a, &b);
+    return _stringHashMix(a ^ HASH_SECRET[0] ^ n, b ^ HASH_SECRET[1]);
+}
+
+// Finds the first byte of p that belongs to the delimiter set; the SIMD kernels
+// compare against every member and are used for small sets only.
+#define SPLIT_SIMD_MAX_SET 8
+
+int64_t _stringFindAnyOfScalar(const char *p, size_t n, const uint8_t *bitmap) {
+    for (size_t i = 0; i < n; ++i) {
+        uint8_t c = (uint8_t)p[i];
+        if (bitmap[c >> 3] & (1u << (c & 7))) return (int64_t)i;
+    }
+    return -1;
+}
+
+#ifdef CSTRING_X86_SIMD
+__attribute__((target("sse2")))
+int64_t _stringFindAnyOfSse2(const char *p, size_t n, const char *set, size_t setSize, const uint8_t *bitmap) {
+    __m128i members[SPLIT_SIMD_MAX_SET];
+    for (size_t k = 0; k < setSize; ++k) {
+        members[k] = _mm_set1_epi8(set[k]);
+    }
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i *)(p + i));
+        __m128i hit = _mm_cmpeq_epi8(block, members[0]);
+        for (size_t k = 1; k < setSize; ++k) {
+            hit = _mm_or_si128(hit, _mm_cmpeq_epi8(block, members[k]));
+        }
+        unsigned mask = (unsigned)_mm_movemask_epi8(hit);
+        if (mask != 0) return (int64_t)(i + (size_t)__builtin_ctz(mask));
+    }
+    int64_t res = _stringFindAnyOfScalar(p + i, n - i, bitmap);
+    return res < 0 ? -1 : res + (int64_t)i;
+}
+
+__attribute__((target("avx2")))
+int64_t _stringFindAnyOfAvx2(const char *p, size_t n, const char *set, size_t setSize, const uint8_t *bitmap) {
+    __m256i members[SPLIT_SIMD_MAX_SET];
+    for (size_t k = 0; k < setSize; ++k) {
+        members[k] = _mm256_set1_epi8(set[k]);
+    }
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i *)(p + i));
+        __m256i hit = _mm256_cmpeq_epi8(block, members[0]);
+        for (size_t k = 1; k < setSize; ++k) {
+            hit = _mm256_or_si256(hit, _mm256_cmpeq_epi8(block, members[k]));
+        }
+        unsigned mask = (unsigned)_mm256_movemask_epi8(hit);
+        if (mask != 0) {
+            _mm256_zeroupper();
+            return (int64_t)(i + (size_t)__builtin_ctz(mask));
+        }
+    }
+    _mm256_zeroupper();
+    int64_t res = _stringFindAnyOfSse2(p + i, n - i, set, setSize, bitmap);
+    return res < 0 ? -1 : res + (int64_t)i;
+}
+#endif
+
+int64_t _stringFindAnyOf(const char *p, size_t n, const char *set, size_t setSize, const uint8_t *bitmap) {
+    if (setSize == 0) return -1;
+    if (setSize == 1) {
+        const char *c = (const char *)memchr(p, set[0], n);
+        return c == NULL ? -1 : (int64_t)(c - p);
+    }
+    if (setSize > SPLIT_SIMD_MAX_SET) return _stringFindAnyOfScalar(p, n, bitmap);
+    switch (_stringSimdLevel()) {
+#ifdef CSTRING_X86_SIMD
+        case SIMD_AVX2:
+            return _stringFindAnyOfAvx2(p, n, set, setSize, bitmap);
+        case SIMD_SSE2:
+            return _stringFindAnyOfSse2(p, n, set, setSize, bitmap);
+#endif
+        default:
+            return _stringFindAnyOfScalar(p, n, bitmap);
+    }
+}
+
+int64_t _stringSplitFind(const TStringSplitIter *it, size_t *delimLen) {
+    const TStringView rest = it->rest;
+    if (rest.size == 0) return -1;
+    switch (it->mode) {
+        case SPLIT_BY_CHAR: {
+            *delimLen = 1;
+            const char *c = (const char *)memchr(rest.data, it->delimChar, rest.size);
+            return c == NULL ? -1 : (int64_t)(c - rest.data);
+        }
+        case SPLIT_BY_ANY_OF:
+            *delimLen = 1;
+            return _stringFindAnyOf(rest.data, rest.size, it->delim.data, it->delim.size, it->anyOf);
+        default:
+            // an empty delimiter never splits
+            if (it->delim.size == 0) return -1;
+            *delimLen = it->delim.size;
+            return _stringSearch(rest.data, rest.size, it->delim.data, it->delim.size);
+    }
+}
+
+bool stringIsInline(const TString *s) {
+#if CSTRING_SSO_CAPACITY > 0
+    return (s->ssoTag & SSO_INLINE_TAG) != 0;
+#else
+    (void)s;
+    return false;
+#endif
+}
+
+#if CSTRING_SSO_CAPACITY > 0
+// Only valid for strings without a heap buffer.
+void _stringSetInline(TString *s) {
+    s->data = NULL;
+    s->capacity = 0;
+    s->ssoTag = SSO_INLINE_TAG;
+}
+#endif
+
+// Moves the contents into a buffer of `newCap` bytes; short strings stay inline.
+bool _stringSetCap(TString *s, size_t newCap) {
+    const TStringAllocator *allocator = _stringAllocatorOf(s);
+    char *newData = NULL;
+    if (stringIsInline(s) || s->data == NULL) {
+#if CSTRING_SSO_CAPACITY > 0
+        if (newCap <= CSTRING_SSO_CAPACITY) {
+            if (!stringIsInline(s)) _stringSetInline(s);
+            s->allocator = allocator;
+            return true;
+        }
+#endif
+        newData = (char *)_stringAllocate(allocator, sizeof(char) * newCap);
+        if (newData != NULL && s->size > 0) memcpy(newData, stringData(s), s->size);
+    } else {
+        newData = (char *)allocator->reallocate(allocator->ctx, s->data, s->capacity, sizeof(char) * newCap);
+    }
+    if (newData == NULL) {
+        setError(ERR_ALLOCATE_SPACE);
+        return false;
+    }
+    s->data = newData;
+    s->capacity = newCap;
+    s->allocator = allocator;
+    return true;
+}
+
+// Grows the buffer geometrically so that it holds at least `needed` bytes.
+bool _stringEnsureCap(TString *s, size_t needed) {
+    assert(s != NULL);
+    size_t capacity = stringCapacity(s);
+    if (needed <= capacity) return true;
+    size_t newCap = capacity * 2;
+    if (newCap < capacity || newCap < needed) newCap = needed;
+    return _stringSetCap(s, newCap);
+}
+
+void stringIncreaseCap(TString *s) {
+    _stringEnsureCap(s, stringCapacity(s) + 1);
+}
+
+// import 
+
+const TStringAllocator *stringMallocAllocator() {
+    return &MALLOC_ALLOCATOR;
+}
+
+const TStringAllocator *stringGetDefaultAllocator() {
+    return atomic_load_explicit(&DEFAULT_ALLOCATOR, memory_order_acquire);
+}
+
+void stringSetDefaultAllocator(const TStringAllocator *allocator) {
+    atomic_store_explicit(&DEFAULT_ALLOCATOR, allocator != NULL ? allocator : &MALLOC_ALLOCATOR, memory_order_release);
+}
+
+const TStringAllocator *stringGetThreadAllocator() {
+    return THREAD_ALLOCATOR;
+}
+
+// Overrides the default allocator for the calling thread only; NULL falls back
+// to the process-wide default.
+void stringSetThreadAllocator(const TStringAllocator *allocator) {
+    THREAD_ALLOCATOR = allocator;
+}
+
+// Chunks come from `parent`, or from malloc when it is NULL.
+void stringArenaInit(TStringArena *arena, size_t chunkSize, const TStringAllocator *parent) {
+    if (arena == NULL) {
+        setError(ERR_NULL_POINTER);
+        return;
+    }
+    clearError();
+    *arena = (TStringArena){0};
+    arena->allocator = (TStringAllocator){
+        _stringArenaAllocate,
+        _stringArenaReallocate,
+        _stringArenaDeallocate,
+        arena,
+    };
+    arena->parent = parent != NULL ? parent : &MALLOC_ALLOCATOR;
+    arena->chunkSize = chunkSize != 0 ? chunkSize : ARENA_DEFAULT_CHUNK;
+}
+
+const TStringAllocator *stringArenaAllocator(TStringArena *arena) {
+    if (arena == NULL) return NULL;
+    return &arena->allocator;
+}
+
+// Forgets every allocation at once and keeps the chunks for reuse; strings
+// allocated from the arena must not be touched afterwards.
+void stringArenaReset(TStringArena *arena) {
+    if (arena == NULL) return;
+    arena->current = arena->first;
+    arena->last = NULL;
+    if (arena->first != NULL) arena->first->used = 0;
+}
+
+void stringArenaDestroy(TStringArena *arena) {
+    if (arena == NULL) return;
+    TStringArenaChunk *chunk = arena->first;
+    while (chunk != NULL) {
+        TStringArenaChunk *next = chunk->next;
+        _stringDeallocate(arena->parent, chunk, sizeof(TStringArenaChunk) + chunk->size);
+        chunk = next;
+    }
+    arena->first = NULL;
+    arena->current = NULL;
+    arena->last = NULL;
+}
+
+bool stringCharIsDigit(char c) {
+    return ('0' <= c && c <= '9');
+}
+
+bool stringCharIsAlpha(char c) {
+    return (('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z'));
+}
+
+bool stringCharIsAlphanum(char c) {
+    return stringCharIsDigit(c) || stringCharIsAlpha(c);
+}
+
+char stringCharToLower(char c) {
+    if ('A' <= c && c <= 'Z') return 'a' + (c - 'A');
+    return c;
+}
+char stringCharToUpper(char c) {
+    if ('a' <= c && c <= 'z') return 'A' + (c - 'a');
+    return c;
+}
+
+int stringCharToInt(char c) {
+    clearError();
+    if ('0' <= c && c <= '9') 
+        return c - '0';
+    setError(ERR_INVALID_NUMBER_REPR);
+    return -1;
+}
+
+bool stringStartWith(TString s, TString pref) {
+    return stringViewStartWith(stringViewOf(&s), stringViewOf(&pref));
+}
+
+bool stringStartWithCharArr(TString s, const char *pref) {
+    return stringViewStartWith(stringViewOf(&s), stringViewFromCharArr(pref));
+}
+
+bool stringEndWith(TString s, TString pref) {
+    return stringViewEndWith(stringViewOf(&s), stringViewOf(&pref));
+}
+
+bool stringEndWithCharArr(TString s, const char *pref) {
+    return stringViewEndWith(stringViewOf(&s), stringViewFromCharArr(pref));
+}
+
+bool stringIsEqual(TString s1, TString s2) {
+    return stringViewIsEqual(stringViewOf(&s1), stringViewOf(&s2));
+}
+
+bool stringIsEqualIgnoreCase(TString s1, TString s2) {
+    return stringViewIsEqualIgnoreCase(stringViewOf(&s1), stringViewOf(&s2));
+}
+
+bool stringIsEmpty(TString s) {
+    return s.size == 0;
+}
+
+bool stringIsDigits(TString s) {
+    if (s.size == 0) return false;
+    return _stringAllInRange(stringData(&s), s.size, '0', '9', 0);
+}
+
+bool stringIsAlphas(TString s) {
+    if (s.size == 0) return false;
+    return _stringAllInRange(stringData(&s), s.size, 'a', 'z', 0x20);
+}
+
+bool stringContains(TString s, TString pattern) {
+    return stringFindFirst(s, pattern) >= 0;
+}
+
+bool stringContainsCharArr(TString s, const char *pattern) {
+    return stringFindFirstCharArr(s, pattern) >= 0;
+}
+
+size_t stringLen(TString s) {
+    return s.size;
+}
+
+bool stringIsPalindrome(TString s) {
+    return _stringIsPalindromeBuf(stringData(&s), s.size);
+}
+
+size_t stringCount(TString s, char c) {
+    if (s.size == 0) return 0;
+    return _stringCountChar(stringData(&s), s.size, c);
+}
+
+int stringCompare(TString s1, TString s2) {
+    return stringViewCompare(stringViewOf(&s1), stringViewOf(&s2));
+}
+
+int64_t stringFindFirst(TString s, TString pattern) {
+    return stringViewFindFirst(stringViewOf(&s), stringViewOf(&pattern));
+}
+
+int64_t stringFindFirstCharArr(TString s, const char *pattern) {
+    if (pattern == NULL) {
+        setError(ERR_NULL_POINTER);
+        return -1;
+    }
+    return _stringSearch(stringData(&s), s.size, pattern, stringLenCharArr(pattern));
+}
+
+TStringPattern _stringPatternCompileBuf(const char *pattern, size_t len, bool caseSensitive) {
+    clearError();
+    TStringPattern res = {0};
+    res.data = (char *)malloc(len > 0 ? len : 1);
+    if (res.data == NULL) {
+        setError(ERR_ALLOCATE_SPACE);
+        return res;
+    }
+    if (len > 0) memcpy(res.data, pattern, len);
+    if (!caseSensitive) _stringChangeCase(res.data, len, 'A');
+    res.size = len;
+    res.caseSensitive = caseSensitive;
+    res.compiled = true;
+    _stringTwoWayInit(&res.twoWay, res.data, len);
+    return res;
+}
+
+TStringPattern stringPatternCompile(TString pattern, bool caseSensitive) {
+    return _stringPatternCompileBuf(stringData(&pattern), pattern.size, caseSensitive);
+}
+
+TStringPattern stringPatternCompileCharArr(const char *pattern, bool caseSensitive) {
+    if (pattern == NULL) {
+        setError(ERR_NULL_POINTER);
+        return (TStringPattern){0};
+    }
+    return _stringPatternCompileBuf(pattern, stringLenCharArr(pattern), caseSensitive);
+}
+
+int64_t stringPatternFind(const TStringPattern *p, TString s) {
+    return stringPatternFindNext(p, s, 0);
+}
+
+int64_t stringPatternFindNext(const TStringPattern *p, TString s, size_t from) {
+    if (p == NULL) {
+        setError(ERR_NULL_POINTER);
+        return -1;
+    }
+    return _stringPatternSearch(p, stringData(&s), s.size, from);
+}
+
+size_t stringPatternCount(const TStringPattern *p, TString s) {
+    if (p == NULL) {
+        setError(ERR_NULL_POINTER);
+        return 0;
+    }
+    size_t res = 0;
+    size_t pos = 0;
+    TStringMatchIter it = stringPatternIter(p, s);
+    while (stringPatternIterNext(&it, &pos)) {
+        ++res;
+    }
+    return res;
+}
+
+TStringMatchIter stringPatternIter(const TStringPattern *p, TString s) {
+    TStringMatchIter it = {0};
+    it.pattern = p;
+    it.str = s;
+    return it;
+}
+
+bool stringPatternIterNext(TStringMatchIter *it, size_t *pos) {
+    if (it == NULL || it->pattern == NULL || pos == NULL) {
+        setError(ERR_NULL_POINTER);
+        return false;
+    }
+    int64_t res = _stringPatternSearch(it->pattern, stringData(&it->str), it->str.size, it->pos);
+    if (res < 0) {
+        it->pos = it->str.size + 1;
+        return false;
+    }
+    *pos = (size_t)res;
+    // matches do not overlap; an empty pattern advances by one byte
+    it->pos = (size_t)res + (it->pattern->size > 0 ? it->pattern->size : 1);
+    return true;
+}
+
+void stringPatternDestroy(TStringPattern *p) {
+    if (p == NULL) return;
+    if (p->compiled) free(p->data);
+    *p = (TStringPattern){0};
+}
+
+size_t stringCountSubstring(TString s, TString pattern) {
+    TStringPattern pat = {0};
+    pat.data = stringData(&pattern);
+    pat.size = pattern.size;
+    pat.caseSensitive = true;
+    return stringPatternCount(&pat, s);
+}
+
+int64_t stringToInt(TString s) {
+    return stringViewToInt(stringViewOf(&s));
+}
+
+uint64_t stringToUint(TString s) {
+    return stringViewToUint(stringViewOf(&s));
+}
+
+int32_t stringToInt32(TString s) {
+    return stringViewToInt32(stringViewOf(&s));
+}
+
+bool _stringIsEightDigits(uint64_t x) {
+    const uint64_t highs = 0xF0F0F0F0F0F0F0F0ULL;
+    return ((x & highs) | (((x + 0x0606060606060606ULL) & highs) >> 4)) == 0x3333333333333333ULL;
+}
+
+// Converts eight ASCII digits loaded little-endian: adjacent digits are
+// combined into pairs, then pairs into quads, then the two quads.
+uint64_t _stringEightDigits(uint64_t x) {
+    const uint64_t mask = 0x000000FF000000FFULL;
+    x -= 0x3030303030303030ULL;
+    x = (x * 10) + (x >> 8);
+    return (((x & mask) * 0x000F424000000064ULL) + (((x >> 16) & mask) * 0x0000271000000001ULL)) >> 32;
+}
+
+static const uint64_t POW10[] = {
+    1ULL,
+    10ULL,
+    100ULL,
+    1000ULL,
+    10000ULL,
+    100000ULL,
+    1000000ULL,
+    10000000ULL,
+    100000000ULL,
+    1000000000ULL,
+    10000000000ULL,
+    100000000000ULL,
+    1000000000000ULL,
+    10000000000000ULL,
+    100000000000000ULL,
+    1000000000000000ULL,
+    10000000000000000ULL,
+    100000000000000000ULL,
+    1000000000000000000ULL,
+    10000000000000000000ULL,
+};
+
+// Number of leading bytes of a little-endian word that are ASCII digits.
+size_t _stringDigitRun(uint64_t x) {
+    const uint64_t highs = 0xF0F0F0F0F0F0F0F0ULL;
+    uint64_t y = ((x & highs) | (((x + 0x0606060606060606ULL) & highs) >> 4)) ^ 0x3333333333333333ULL;
+    uint64_t nonDigits = (((y & ~SWAR_HIGHS) + ~SWAR_HIGHS) | y) & SWAR_HIGHS;
+    return nonDigits == 0 ? 8 : (size_t)__builtin_ctzll(nonDigits) / 8;
+}
+
+// Value of the first `k` (1..8) digits of a little-endian word: they are
+// shifted to the top and the freed low bytes are filled with '0'.
+uint64_t _stringLeadingDigits(uint64_t x, size_t k) {
+    if (k == 8) return _stringEightDigits(x);
+    return _stringEightDigits((x << (64 - 8 * k)) | (0x3030303030303030ULL >> (8 * k)));
+}
+
+// Reads a run of digits into `value`. Up to 19 significant digits cannot
+// overflow, so they are taken up to eight at a time without checks; only a
+// 20th digit needs one. On overflow the rest of the run is still consumed.
+size_t _stringParseDigits(const char *p, size_t n, uint64_t *value, bool *overflow) {
+    size_t i = 0;
+    while (i < n && p[i] == '0') ++i;
+    const size_t first = i;
+    uint64_t v = 0;
+    bool more = true;
+    while (more && n >= 8 && i < n && i - first <= 11) {
+        uint64_t x = 0;
+        size_t avail = n - i;
+        if (avail >= 8) {
+            x = _stringLoad64Le(p + i);
+        } else {
+            // reread the last word of the input and drop the bytes already parsed
+            x = _stringLoad64Le(p + n - 8) >> (8 * (8 - avail));
+        }
+        size_t k = _stringDigitRun(x);
+        if (k == 0) break;
+        v = v * POW10[k] + _stringLeadingDigits(x, k);
+        i += k;
+        more = k == 8;
+    }
+    while (more && i < n && i - first < 19 && stringCharIsDigit(p[i])) {
+        v = v * 10 + (uint64_t)(p[i] - '0');
+        ++i;
+    }
+    *overflow = false;
+    if (i < n && stringCharIsDigit(p[i])) {
+        uint64_t digit = (uint64_t)(p[i] - '0');
+        if (v > (UINT64_MAX - digit) / 10) {
+            *overflow = true;
+        } else {
+            v = v * 10 + digit;
+        }
+        ++i;
+        while (i < n && stringCharIsDigit(p[i])) {
+            *overflow = true;
+            ++i;
+        }
+    }
+    *value = v;
+    return i;
+}
+
+// Parses an optional sign followed by at least one digit; returns the number
+// of bytes consumed, or 0 when `s` does not start with a number.
+size_t _stringParseMagnitude(TStringView s, bool allowMinus, bool *negative, uint64_t *magnitude, bool *overflow) {
+    size_t i = 0;
+    *negative = false;
+    if (s.size > 0 && (s.data[0] == '+' || (s.data[0] == '-' && allowMinus))) {
+        *negative = s.data[0] == '-';
+        i = 1;
+    }
+    size_t digits = _stringParseDigits(s.data + i, s.size - i, magnitude, overflow);
+    return digits == 0 ? 0 : i + digits;
+}
+
+EErrorCode _stringParseSigned(TStringView s, int64_t min, int64_t max, int64_t *value, size_t *consumed) {
+    bool negative = false;
+    bool overflow = false;
+    uint64_t magnitude = 0;
+    *consumed = _stringParseMagnitude(s, true, &negative, &magnitude, &overflow);
+    *value = 0;
+    if (*consumed == 0) return ERR_INVALID_NUMBER_REPR;
+    uint64_t limit = negative ? (uint64_t)(-(min + 1)) + 1 : (uint64_t)max;
+    if (overflow || magnitude > limit) {
+        *value = negative ? min : max;
+        return ERR_NUMBER_OVERFLOW;
+    }
+    *value = negative && magnitude > 0 ? -(int64_t)(magnitude - 1) - 1 : (int64_t)magnitude;
+    return ERR_NO_ERROR;
+}
+
+EErrorCode _stringParseUnsigned(TStringView s, uint64_t *value, size_t *consumed) {
+    bool negative = false;
+    bool overflow = false;
+    *consumed = _stringParseMagnitude(s, false, &negative, value, &overflow);
+    if (*consumed == 0) {
+        *value = 0;
+        return ERR_INVALID_NUMBER_REPR;
+    }
+    if (overflow) {
+        *value = UINT64_MAX;
+        return ERR_NUMBER_OVERFLOW;
+    }
+    return ERR_NO_ERROR;
+}
+
+// The error state is written once per call rather than once per digit.
+void _stringReportParse(EErrorCode e) {
+    if (e != ERR_NO_ERROR) {
+        setError(e);
+    } else {
+        clearError();
+    }
+}
+
+// Parses the longest numeric prefix of `s`: an optional '+' or '-' and then
+// digits. `consumed` receives the bytes used, 0 if there is no number. Values
+// out of range saturate and set ERR_NUMBER_OVERFLOW.
+int64_t stringViewParseInt(TStringView s, size_t *consumed) {
+    int64_t value = 0;
+    size_t used = 0;
+    _stringReportParse(_stringParseSigned(s, INT64_MIN, INT64_MAX, &value, &used));
+    if (consumed != NULL) *consumed = used;
+    return value;
+}
+
+uint64_t stringViewParseUint(TStringView s, size_t *consumed) {
+    uint64_t value = 0;
+    size_t used = 0;
+    _stringReportParse(_stringParseUnsigned(s, &value, &used));
+    if (consumed != NULL) *consumed = used;
+    return value;
+}
+
+int32_t stringViewParseInt32(TStringView s, size_t *consumed) {
+    int64_t value = 0;
+    size_t used = 0;
+    _stringReportParse(_stringParseSigned(s, INT32_MIN, INT32_MAX, &value, &used));
+    if (consumed != NULL) *consumed = used;
+    return (int32_t)value;
+}
+
+// The whole view must be a number; trailing bytes make it ERR_INVALID_NUMBER_REPR.
+int64_t stringViewToInt(TStringView s) {
+    int64_t value = 0;
+    size_t used = 0;
+    EErrorCode e = _stringParseSigned(s, INT64_MIN, INT64_MAX, &value, &used);
+    if (e == ERR_NO_ERROR && used != s.size) {
+        e = ERR_INVALID_NUMBER_REPR;
+        value = 0;
+    }
+    _stringReportParse(e);
+    return value;
+}
+
+uint64_t stringViewToUint(TStringView s) {
+    uint64_t value = 0;
+    size_t used = 0;
+    EErrorCode e = _stringParseUnsigned(s, &value, &used);
+    if (e == ERR_NO_ERROR && used != s.size) {
+        e = ERR_INVALID_NUMBER_REPR;
+        value = 0;
+    }
+    _stringReportParse(e);
+    return value;
+}
+
+int32_t stringViewToInt32(TStringView s) {
+    int64_t value = 0;
+    size_t used = 0;
+    EErrorCode e = _stringParseSigned(s, INT32_MIN, INT32_MAX, &value, &used);
+    if (e == ERR_NO_ERROR && used != s.size) {
+        e = ERR_INVALID_NUMBER_REPR;
+        value = 0;
+    }
+    _stringReportParse(e);
+    return (int32_t)value;
+}
+
+TString stringInit(size_t capacity) {
+    return stringInitWithAllocator(capacity, NULL);
+}
+
+char *stringData(const TString *s) {
+#if CSTRING_SSO_CAPACITY > 0
+    if (stringIsInline(s)) return (char *)s->sso;
+#endif
+    return s->data;
+}
+
+size_t stringCapacity(const TString *s) {
+    return stringIsInline(s) ? CSTRING_SSO_CAPACITY : s->capacity;
+}
+
+TString stringInitWithAllocator(size_t capacity, const TStringAllocator *allocator) {
+    TString s = {0};
+    s.allocator = allocator != NULL ? allocator : _stringDefaultAllocator();
+#if CSTRING_SSO_CAPACITY > 0
+    if (capacity <= CSTRING_SSO_CAPACITY) {
+        _stringSetInline(&s);
+        return s;
+    }
+#endif
+    s.data = (char *)_stringAllocate(s.allocator, sizeof(char) * capacity);
+    if (stringData(&s) == NULL) {
+        setError(ERR_ALLOCATE_SPACE);
+        return (TString){0};
+    }
+    s.capacity = capacity;
+    s.size = 0;
+    return s;
+}
+
+TString stringRand(size_t size) {
+    static const char randChars[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+    size_t len = sizeof(randChars) / sizeof(char) - 1;
+    clearError();
+    TString res = stringInit(size);
+    if (isError()) {
+        return res;
+    }
+    char *data = stringData(&res);
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = randChars[rand() % len];
+    }
+    res.size = size;
+    return res;
+}
+
+TString stringInitWithCharArr(const char *s) {
+    if (s == NULL) return (TString){0};
+    clearError();
+    size_t len = stringLenCharArr(s);
+    TString res = stringInit(len);
+    if (isError()) {
+        return res;
+    }
+    stringAppendChars(&res, s, len);
+    return res;
+}
+
+TString stringInitWithInt(int64_t n) {
+    // sized by the digit count, so short numbers can stay inline
+    TString res = {0};
+    stringAppendInt(&res, n);
+    if (isError()) stringDestroy(&res);
+    return res;
+}
+
+TString stringInitWithUint(uint64_t n) {
+    // sized by the digit count, so short numbers can stay inline
+    TString res = {0};
+    stringAppendUint(&res, n);
+    if (isError()) stringDestroy(&res);
+    return res;
+}
+
+TString stringInitWithDouble(double d) {
+    clearError();
+    TString res = stringInit(32);
+    if (isError()) return (TString){0};
+    stringAppendDouble(&res, d);
+    if (isError()) stringDestroy(&res);
+    return res;
+}
+
+TString stringCopy(TString s) {
+    TString res = s;
+    return res;
+}
+
+TString stringDeepCopy(TString s) {
+    clearError();
+    TString res = stringInit(stringCapacity(&s));
+    if (isError()) return (TString){0};
+
+    stringAppendString(&res, s);
+    return res;
+}
+
+TString stringConcat(TString s1, TString s2) {
+    clearError();
+    TString res = stringInit(s1.size + s2.size);
+    if (isError()) return (TString){0};
+
+    stringAppendString(&res, s1);
+    stringAppendString(&res, s2);
+
+    return res;
+}
+
+TString stringArrConcat(const TString *s, size_t count) {
+    if (s == NULL) {
+        setError(ERR_NULL_POINTER);
+        return (TString){0};
+    }
+    clearError();
+    size_t totalSize = 0;
+    for (size_t i = 0; i < count; ++i) {
+        totalSize += s[i].size;
+    }
+
+    TString res = stringInit(totalSize);
+    if (isError()) return (TString){0};
+
+    for (size_t i = 0; i < count; ++i) {
+        stringAppendString(&res, s[i]);
+    }
+    return res;
+}
+
+TString stringJoin(TString s1, TString s2, TString delim) {
+    clearError();
+    TString res = stringInit(s1.size + delim.size + s2.size);
+    if (isError()) return (TString){0};
+
+    stringAppendString(&res, s1);
+    stringAppendString(&res, delim);
+    stringAppendString(&res, s2);
+
+    return res;
+}
+
+TString stringJoinCharArr(TString s1, TString s2, const char *delim) {
+    clearError();
     size_t delimSize = stringLenCharArr(delim);
     TString res = stringInit(s1.size + delimSize + s2.size);
     if (isError()) return (TString){0};
 
-    for (size_t i = 0; i < s1.size; ++i) {
-        res.data[i] = s1.data[i];
+    stringAppendString(&res, s1);
+    stringAppendChars(&res, delim, delimSize);
+    stringAppendString(&res, s2);
+
+    return res;
+}
+
+TString stringArrJoin(const TString *s, size_t count, TString delim) {
+    if (s == NULL) {
+        setError(ERR_NULL_POINTER);
+        return (TString){0};
+    }
+
+    clearError();
+    size_t totalSize = 0;
+    for (size_t i = 0; i < count; ++i) {
+        totalSize += s[i].size;
+        if (i + 1 < count) totalSize += delim.size;
+    }
+
+    TString res = stringInit(totalSize);
+    if (isError()) return (TString){0};
+
+    for (size_t i = 0; i < count; ++i) {
+        stringAppendString(&res, s[i]);
+        if (i + 1 < count) stringAppendString(&res, delim);
+    }
+    return res;
+}
+
+TString stringArrJoinCharArr(const TString *s, size_t count, const char *delim) {
+    if (s == NULL || delim == NULL) {
+        setError(ERR_NULL_POINTER);
+        return (TString){0};
+    }
+
+    clearError();
+    size_t totalSize = 0;
+    size_t delimSize = stringLenCharArr(delim);
+    for (size_t i = 0; i < count; ++i) {
+        totalSize += s[i].size;
+        if (i + 1 < count) totalSize += delimSize;
+    }
+
+    TString res = stringInit(totalSize);
+    if (isError()) return (TString){0};
+
+    for (size_t i = 0; i < count; ++i) {
+        stringAppendString(&res, s[i]);
+        if (i + 1 < count) stringAppendChars(&res, delim, delimSize);
+    }
+    return res;
+}
+
+TString stringSubstring(TString s, size_t pos, size_t len) {
+    clearError();
+    TString res = stringInit(len);
+    if (isError()) return (TString){0};
+    char *data = stringData(&res);
+    const char *src = stringData(&s);
+    for (size_t i = 0; i < len && pos + i < s.size; ++i) {
+        data[i] = src[pos + i];
+    }
+    res.size = len;
+    return res;
+}
+
+char* stringConvertToCharArr(TString s) {
+    if (stringData(&s) == NULL)
+        return NULL;
+
+    clearError();
+    // the result belongs to the string's allocator; release it with stringFreeCharArr
+    char *res = (char *)_stringAllocate(_stringAllocatorOf(&s), s.size + 1);
+
+    if (res == NULL) {
+        setError(ERR_NULL_POINTER);
+        return NULL;
+    }
+    memcpy(res, stringData(&s), s.size * sizeof(char));
+    res[s.size] = '\0';
+    return res;
+}
+
+// Releases the result of stringConvertToCharArr(*s) through the allocator it
+// came from. `s` must still have the size it had when it was converted.
+void stringFreeCharArr(const TString *s, char *arr) {
+    if (s == NULL) {
+        setError(ERR_NULL_POINTER);
+        return;
+    }
+    clearError();
+    _stringDeallocate(_stringAllocatorOf(s), arr, s->size + 1);
+}
+
+void stringScan(TString *s) {
+    if (s == NULL) {
+        setError(ERR_NULL_POINTER);
+        return;
+    }
+    clearError();
+    stringDestroy(s);
+    char c = getchar();
+    while ((c == ' ' || c == '\n' || c == '\t') && c != EOF) {
+        c = getchar();
+    }
+    if (c == EOF) {
+        setError(ERR_EOF_NOT_EXPECTED);
+        return;
+    }
+
+    while (c != EOF &&
+           c != '\n' &&
+           c != ' ' &&
+           c != '\t') {
+        stringPushBack(s, c);
+        if (isError()) return;
+        c = getchar();
+    }
+}
+
+void stringPrint(TString s) {
+    const char *data = stringData(&s);
+    if (data == NULL || s.size == 0) return;
+    fwrite(data, 1, s.size, stdout);
+}
+
+// Writes all of `p`, carrying on after short writes and EINTR.
+bool _stringWriteAllFd(int fd, const char *p, size_t n) {
+#ifdef CSTRING_POSIX
+    while (n > 0) {
+        ssize_t written = write(fd, p, n);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            setError(ERR_IO);
+            return false;
+        }
+        p += written;
+        n -= (size_t)written;
+    }
+    return true;
+#else
+    (void)fd;
+    (void)p;
+    (void)n;
+    setError(ERR_INVALID_STATE);
+    return false;
+#endif
+}
+
+// Writes the whole string with a single fwrite. Sets ERR_IO on failure.
+bool stringWriteFile(FILE *file, TString s) {
+    if (file == NULL) {
+        setError(ERR_NULL_POINTER);
+        return false;
+    }
+    clearError();
+    if (s.size > 0 && fwrite(stringData(&s), 1, s.size, file) != s.size) {
+        setError(ERR_IO);
+        return false;
+    }
+    return true;
+}
+
+bool stringWriteFd(int fd, TString s) {
+    clearError();
+    return _stringWriteAllFd(fd, stringData(&s), s.size);
+}
+
+void stringDebug(TString s) {
+    if (stringData(&s) == NULL) {
+        printf("[NULL, size = %zu, cap = %zu]\n", s.size, stringCapacity(&s));
+        return;
+    } else {
+        printf("[");
+        stringPrint(s);
+        printf(", size = %zu, cap = %zu]\n", s.size, stringCapacity(&s));
+    }
+}
+
+void stringRemoveChar(TString *s, char c) {
+    size_t newSize = 0;
+    char *data = stringData(s);
+    for (size_t i = 0; i < s->size; ++i) {
+        if (data[i] != c) {
+            data[newSize] = data[i];
+            ++newSize;
+        }
+    }
+    s->size = newSize;
+}
+
+void stringSwap(TString *s1, TString *s2) {
+    if (s1 == NULL || s2 == NULL) {
+        setError(ERR_NULL_POINTER);
+        return;
+    }
+    TString tmp = *s1;
+    *s1 = *s2;
+    *s2 = tmp;
+}
+
+void stringPushBack(TString *s, char c) {
+    if (s == NULL) {
+        setError(ERR_NULL_POINTER);
+        return;
+    }
+
+    clearError();
+    if (s->size >= stringCapacity(s) && !_stringEnsureCap(s, stringCapacity(s) > 0 ? s->size + 1 : 10)) return;
+
+    stringData(s)[s->size] = c;
+    s->size++;
+}
+
+void stringReserve(TString *s, size_t capacity) {
+    if (s == NULL) {
+        setError(ERR_NULL_POINTER);
+        return;
+    }
+    clearError();
+    if (capacity <= stringCapacity(s)) return;
+    _stringSetCap(s, capacity);
+}
+
+void stringAppendChars(TString *s, const char *p, size_t len) {
+    if (s == NULL || (p == NULL && len > 0)) {
+        setError(ERR_NULL_POINTER);
+        return;
+    }
+    clearError();
+    if (len == 0) return;
+    // p may point into s itself, which realloc can move
+    const char *data = stringData(s);
+    bool aliased = data != NULL && p >= data && p < data + stringCapacity(s);
+    size_t offset = aliased ? (size_t)(p - data) : 0;
+    if (!_stringEnsureCap(s, s->size + len)) return;
+    if (aliased) p = stringData(s) + offset;
+    memmove(stringData(s) + s->size, p, len);
+    s->size += len;
+}
+
+void stringAppendCharArr(TString *s, const char *p) {
+    if (p == NULL) {
+        setError(ERR_NULL_POINTER);
+        return;
+    }
+    stringAppendChars(s, p, stringLenCharArr(p));
+}
+
+void stringAppendString(TString *s, TString other) {
+    stringAppendChars(s, stringData(&other), other.size);
+}
+
+static const char DIGIT_PAIRS[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+// Number of decimal digits of v: log2 from the bit length, scaled by
+// 1233/4096 ~ log10(2), then corrected with one table lookup.
+size_t _stringCountDigits(uint64_t v) {
+    v |= 1;
+    size_t bits = 64 - (size_t)__builtin_clzll(v);
+    size_t t = (bits * 1233) >> 12;
+    return t + 1 - (v < POW10[t]);
+}
+
+// Writes the digits of v so that the last one lands just before `end`, two
+// at a time; once the value fits in 32 bits the cheaper arithmetic is used.
+void _stringWriteDigits(char *end, uint64_t v) {
+    while (v > UINT32_MAX) {
+        uint64_t q = v / 100;
+        size_t r = (size_t)(v - q * 100) * 2;
+        *--end = DIGIT_PAIRS[r + 1];
+        *--end = DIGIT_PAIRS[r];
+        v = q;
+    }
+    uint32_t w = (uint32_t)v;
+    while (w >= 100) {
+        uint32_t q = w / 100;
+        size_t r = (size_t)(w - q * 100) * 2;
+        *--end = DIGIT_PAIRS[r + 1];
+        *--end = DIGIT_PAIRS[r];
+        w = q;
+    }
+    if (w >= 10) {
+        *--end = DIGIT_PAIRS[w * 2 + 1];
+        *--end = DIGIT_PAIRS[w * 2];
+    } else {
+        *--end = (char)('0' + w);
+    }
+}
+
+// Appends an optional '-', zeros up to `width` characters in total and the
+// digits of `v`, straight into the string's buffer.
+void _stringAppendNumber(TString *s, bool negative, uint64_t v, size_t width) {
+    if (s == NULL) {
+        setError(ERR_NULL_POINTER);
+        return;
+    }
+    clearError();
+    size_t digits = _stringCountDigits(v);
+    size_t len = digits + negative;
+    if (len < width) len = width;
+    if (!_stringEnsureCap(s, s->size + len)) return;
+    char *p = stringData(s) + s->size;
+    if (negative) *p = '-';
+    memset(p + negative, '0', len - digits - negative);
+    _stringWriteDigits(p + len, v);
+    s->size += len;
+}
+
+void stringAppendInt(TString *s, int64_t n) {
+    // negate in unsigned arithmetic so that INT64_MIN does not overflow
+    _stringAppendNumber(s, n < 0, n < 0 ? 0 - (uint64_t)n : (uint64_t)n, 0);
+}
+
+void stringAppendUint(TString *s, uint64_t n) {
+    _stringAppendNumber(s, false, n, 0);
+}
+
+// Pads with zeros after the sign to at least `width` characters, like "%0*d".
+void stringAppendIntPadded(TString *s, int64_t n, size_t width) {
+    _stringAppendNumber(s, n < 0, n < 0 ? 0 - (uint64_t)n : (uint64_t)n, width);
+}
+
+void stringAppendUintPadded(TString *s, uint64_t n, size_t width) {
+    _stringAppendNumber(s, false, n, width);
+}
+
+void stringAppendRepeat(TString *s, char c, size_t count) {
+    if (s == NULL) {
+        setError(ERR_NULL_POINTER);
+        return;
+    }
+    clearError();
+    if (count == 0) return;
+    if (!_stringEnsureCap(s, s->size + count)) return;
+    memset(stringData(s) + s->size, c, count);
+    s->size += count;
+}
+
+void stringPushFront(TString *s, char c) {
+    stringReverse(s);
+    stringPushBack(s, c);
+    stringReverse(s);
+}
+
+void stringPopBack(TString *s) {
+    if (s == NULL) {
+        setError(ERR_NULL_POINTER);
+        return;
+    }
+    if (stringIsEmpty(*s)) {
+        setError(ERR_EMPTY_STRING_POP);
+        return;
+    }
+    --(s->size);
+}
+
+void stringPopFront(TString *s) {
+    if (s == NULL) {
+        setError(ERR_NULL_POINTER);
+        return;
+    }
+    if (stringIsEmpty(*s)) {
+        setError(ERR_EMPTY_STRING_POP);
+        return;
+    }
+    char *data = stringData(s);
+    memmove(data, data + 1, s->size - 1);
+    --(s->size);
+}
+
+void stringTrimLeft(TString *s) {
+    if (s == NULL || s->size == 0) return;
+
+    TStringView rest = stringViewTrimLeft(stringViewOf(s));
+    memmove(stringData(s), rest.data, rest.size);
+    s->size = rest.size;
+}
+
+void stringTrimRight(TString *s) {
+    if (s == NULL || s->size == 0) return;
+
+    s->size = stringViewTrimRight(stringViewOf(s)).size;
+}
+
+void stringTrim(TString *s) {
+    stringTrimRight(s);
+    stringTrimLeft(s);
+}
+
+void stringPadRight(TString *s, size_t newLen, char padChar) {
+    if (s == NULL) {
+        setError(ERR_NULL_POINTER);
+        return;
+    }
+    if (s->size >= newLen) return;
+    stringAppendRepeat(s, padChar, newLen - s->size);
+}
+
+void stringPadLeft(TString *s, size_t newLen, char padChar) {
+    if (s == NULL) {
+        setError(ERR_NULL_POINTER);
+        return;
+    }
+    if (s->size >= newLen) return;
+    stringReverse(s);
+    stringPadRight(s, newLen, padChar);
+    stringReverse(s);
+}
+
+void stringReplaceAll(TString *s, const char *oldS, const char *newS) {
+    if (s == NULL || s->size == 0 || oldS == NULL || newS == NULL) return;
+    TStringPattern pattern = {0};
+    pattern.data = (char *)oldS;
+    pattern.size = stringLenCharArr(oldS);
+    pattern.caseSensitive = true;
+    if (pattern.size == 0) return;
+    int64_t found = _stringPatternSearch(&pattern, stringData(s), s->size, 0);
+    if (found < 0) return;
+
+    clearError();
+    // count the matches first so the result is allocated at its exact size
+    size_t newSubstrLen = stringLenCharArr(newS);
+    size_t count = 0;
+    for (int64_t at = found; at >= 0; at = _stringPatternSearch(&pattern, stringData(s), s->size, (size_t)at + pattern.size)) {
+        ++count;
+    }
+    size_t total = s->size - count * pattern.size + count * newSubstrLen;
+    TString res = {0};
+    res.allocator = s->allocator;
+    stringReserve(&res, total);
+    if (isError()) return;
+    // the reservation is exact, so none of the appends below can grow or fail
+    const char *src = stringData(s);
+    size_t pos = 0;
+    while (found >= 0) {
+        stringAppendChars(&res, src + pos, (size_t)found - pos);
+        stringAppendChars(&res, newS, newSubstrLen);
+        pos = (size_t)found + pattern.size;
+        found = _stringPatternSearch(&pattern, src, s->size, pos);
+    }
+    stringAppendChars(&res, src + pos, s->size - pos);
+    stringDestroy(s);
+    *s = res;
+}
+
+void stringToUpper(TString *s) {
+    if (s == NULL || s->size == 0) return;
+    _stringChangeCase(stringData(s), s->size, 'a');
+}
+
+void stringToLower(TString *s) {
+    if (s == NULL || s->size == 0) return;
+    _stringChangeCase(stringData(s), s->size, 'A');
+}
+
+void stringReverse(TString *s) {
+    if (s == NULL || s->size == 0) return;
+    char *data = stringData(s);
+    for (size_t i = 0; i < (s->size) / 2; ++i) {
+        char tmp = data[i];
+        data[i] = data[s->size - i - 1];
+        data[s->size - i - 1] = tmp;
+    }
+}
+
+void stringFilter(TString *s, bool (*predicate)(char)) {
+    if (s == NULL || predicate == NULL) {
+        setError(ERR_NULL_POINTER);
+        return;
+    }
+    size_t i = 0;
+    size_t j = 0;
+
+    char *data = stringData(s);
+    while (j < s->size) {
+        if (predicate(data[j])) {
+            data[i] = data[j];
+            ++i;
+        }
+        ++j;
+    }
+
+    s->size = i;
+}
+
+void stringMap(TString *s, char (*func)(char)) {
+    if (s == NULL || func == NULL) {
+        setError(ERR_NULL_POINTER);
+        return;
+    }
+    char *data = stringData(s);
+    for (size_t i = 0; i < s->size; ++i) {
+        data[i] = func(data[i]);
+    }
+}
+
+void stringMapIndex(TString *s, char (*func)(size_t, char)) {
+    if (s == NULL || func == NULL) {
+        setError(ERR_NULL_POINTER);
+        return;
+    }
+    char *data = stringData(s);
+    for (size_t i = 0; i < s->size; ++i) {
+        data[i] = func(i, data[i]);
+    }
+}
+
+void stringRemove(TString *s, size_t pos, size_t len) {
+    if (s == NULL) {
+        setError(ERR_NULL_POINTER);
+        return;
+    }
+
+    if (pos >= s->size) return;
+    if (len > s->size - pos) len = s->size - pos;
+    char *data = stringData(s);
+    for (size_t i = pos; i + len < s->size; ++i) {
+        data[i] = data[i + len];
+    }
+    s->size -= len;
+}
+
+void stringDestroy(TString *s) {
+    if (s == NULL) return;
+    if (!stringIsInline(s)) _stringDeallocate(_stringAllocatorOf(s), s->data, s->capacity);
+    *s = (TString){0};
+}
+
+bool isSeparator(char symbol) {
+    return symbol == ' ' || symbol == '\t' || symbol == '\n' || symbol == ',' || symbol == '.';
+}
+
+void stringCapitalize(TString *s) {
+    if (s == NULL || s->size == 0) {
+        return;
+    }
+    char *data = stringData(s);
+    if ('a' <= data[0] && data[0] <= 'z') {
+        data[0] = stringCharToUpper(data[0]);
+    }
+    for (size_t i = 1; i < s->size; ++i) {
+        if (isSeparator(data[i - 1]) && 'a' <= data[i] && data[i] <= 'z') {
+            data[i] = stringCharToUpper(data[i]);
+        }
+    }
+}
+
+double stringToDouble(TString s) {
+    return stringViewToDouble(stringViewOf(&s));
+}
+
+// Normalized 128-bit approximations of 5^q for q in [-342, 308], high word
+// first, as used by the Eisel-Lemire algorithm.
+#define POW5_MIN_EXP -342
+#define POW5_MAX_EXP 308
+
+static const uint64_t POW5_128[] = {
+    0xeef453d6923bd65aULL, 0x113faa2906a13b3fULL,
+    0x9558b4661b6565f8ULL, 0x4ac7ca59a424c507ULL,
+    0xbaaee17fa23ebf76ULL, 0x5d79bcf00d2df649ULL,
+    0xe95a99df8ace6f53ULL, 0xf4d82c2c107973dcULL,
+    0x91d8a02bb6c10594ULL, 0x79071b9b8a4be869ULL,
+    0xb64ec836a47146f9ULL, 0x9748e2826cdee284ULL,
+    0xe3e27a444d8d98b7ULL, 0xfd1b1b2308169b25ULL,
+    0x8e6d8c6ab0787f72ULL, 0xfe30f0f5e50e20f7ULL,
+    0xb208ef855c969f4fULL, 0xbdbd2d335e51a935ULL,
+    0xde8b2b66b3bc4723ULL, 0xad2c788035e61382ULL,
+    0x8b16fb203055ac76ULL, 0x4c3bcb5021afcc31ULL,
+    0xaddcb9e83c6b1793ULL, 0xdf4abe242a1bbf3dULL,
+    0xd953e8624b85dd78ULL, 0xd71d6dad34a2af0dULL,
+    0x87d4713d6f33aa6bULL, 0x8672648c40e5ad68ULL,
+    0xa9c98d8ccb009506ULL, 0x680efdaf511f18c2ULL,
+    0xd43bf0effdc0ba48ULL, 0x0212bd1b2566def2ULL,
+    0x84a57695fe98746dULL, 0x014bb630f7604b57ULL,
+    0xa5ced43b7e3e9188ULL, 0x419ea3bd35385e2dULL,
+    0xcf42894a5dce35eaULL, 0x52064cac828675b9ULL,
+    0x818995ce7aa0e1b2ULL, 0x7343efebd1940993ULL,
+    0xa1ebfb4219491a1fULL, 0x1014ebe6c5f90bf8ULL,
+    0xca66fa129f9b60a6ULL, 0xd41a26e077774ef6ULL,
+    0xfd00b897478238d0ULL, 0x8920b098955522b4ULL,
+    0x9e20735e8cb16382ULL, 0x55b46e5f5d5535b0ULL,
+    0xc5a890362fddbc62ULL, 0xeb2189f734aa831dULL,
+    0xf712b443bbd52b7bULL, 0xa5e9ec7501d523e4ULL,
+    0x9a6bb0aa55653b2dULL, 0x47b233c92125366eULL,
+    0xc1069cd4eabe89f8ULL, 0x999ec0bb696e840aULL,
+    0xf148440a256e2c76ULL, 0xc00670ea43ca250dULL,
+    0x96cd2a865764dbcaULL, 0x380406926a5e5728ULL,
+    0xbc807527ed3e12bcULL, 0xc605083704f5ecf2ULL,
+    0xeba09271e88d976bULL, 0xf7864a44c633682eULL,
+    0x93445b8731587ea3ULL, 0x7ab3ee6afbe0211dULL,
+    0xb8157268fdae9e4cULL, 0x5960ea05bad82964ULL,
+    0xe61acf033d1a45dfULL, 0x6fb92487298e33bdULL,
+    0x8fd0c16206306babULL, 0xa5d3b6d479f8e056ULL,
+    0xb3c4f1ba87bc8696ULL, 0x8f48a4899877186cULL,
+    0xe0b62e2929aba83cULL, 0x331acdabfe94de87ULL,
+    0x8c71dcd9ba0b4925ULL, 0x9ff0c08b7f1d0b14ULL,
+    0xaf8e5410288e1b6fULL, 0x07ecf0ae5ee44dd9ULL,
+    0xdb71e91432b1a24aULL, 0xc9e82cd9f69d6150ULL,
+    0x892731ac9faf056eULL, 0xbe311c083a225cd2ULL,
+    0xab70fe17c79ac6caULL, 0x6dbd630a48aaf406ULL,
+    0xd64d3d9db981787dULL, 0x092cbbccdad5b108ULL,
+    0x85f0468293f0eb4eULL, 0x25bbf56008c58ea5ULL,
+    0xa76c582338ed2621ULL, 0xaf2af2b80af6f24eULL,
+    0xd1476e2c07286faaULL, 0x1af5af660db4aee1ULL,
+    0x82cca4db847945caULL, 0x50d98d9fc890ed4dULL,
+    0xa37fce126597973cULL, 0xe50ff107bab528a0ULL,
+    0xcc5fc196fefd7d0cULL, 0x1e53ed49a96272c8ULL,
+    0xff77b1fcbebcdc4fULL, 0x25e8e89c13bb0f7aULL,
+    0x9faacf3df73609b1ULL, 0x77b191618c54e9acULL,
+    0xc795830d75038c1dULL, 0xd59df5b9ef6a2417ULL,
+    0xf97ae3d0d2446f25ULL, 0x4b0573286b44ad1dULL,
+    0x9becce62836ac577ULL, 0x4ee367f9430aec32ULL,
+    0xc2e801fb244576d5ULL, 0x229c41f793cda73fULL,
+    0xf3a20279ed56d48aULL, 0x6b43527578c1110fULL,
+    0x9845418c345644d6ULL, 0x830a13896b78aaa9ULL,
+    0xbe5691ef416bd60cULL, 0x23cc986bc656d553ULL,
+    0xedec366b11c6cb8fULL, 0x2cbfbe86b7ec8aa8ULL,
+    0x94b3a202eb1c3f39ULL, 0x7bf7d71432f3d6a9ULL,
+    0xb9e08a83a5e34f07ULL, 0xdaf5ccd93fb0cc53ULL,
+    0xe858ad248f5c22c9ULL, 0xd1b3400f8f9cff68ULL,
+    0x91376c36d99995beULL, 0x23100809b9c21fa1ULL,
+    0xb58547448ffffb2dULL, 0xabd40a0c2832a78aULL,
+    0xe2e69915b3fff9f9ULL, 0x16c90c8f323f516cULL,
+    0x8dd01fad907ffc3bULL, 0xae3da7d97f6792e3ULL,
+    0xb1442798f49ffb4aULL, 0x99cd11cfdf41779cULL,
+    0xdd95317f31c7fa1dULL, 0x40405643d711d583ULL,
+    0x8a7d3eef7f1cfc52ULL, 0x482835ea666b2572ULL,
+    0xad1c8eab5ee43b66ULL, 0xda3243650005eecfULL,
+    0xd863b256369d4a40ULL, 0x90bed43e40076a82ULL,
+    0x873e4f75e2224e68ULL, 0x5a7744a6e804a291ULL,
+    0xa90de3535aaae202ULL, 0x711515d0a205cb36ULL,
+    0xd3515c2831559a83ULL, 0x0d5a5b44ca873e03ULL,
+    0x8412d9991ed58091ULL, 0xe858790afe9486c2ULL,
+    0xa5178fff668ae0b6ULL, 0x626e974dbe39a872ULL,
+    0xce5d73ff402d98e3ULL, 0xfb0a3d212dc8128fULL,
+    0x80fa687f881c7f8eULL, 0x7ce66634bc9d0b99ULL,
+    0xa139029f6a239f72ULL, 0x1c1fffc1ebc44e80ULL,
+    0xc987434744ac874eULL, 0xa327ffb266b56220ULL,
+    0xfbe9141915d7a922ULL, 0x4bf1ff9f0062baa8ULL,
+    0x9d71ac8fada6c9b5ULL, 0x6f773fc3603db4a9ULL,
+    0xc4ce17b399107c22ULL, 0xcb550fb4384d21d3ULL,
+    0xf6019da07f549b2bULL, 0x7e2a53a146606a48ULL,
+    0x99c102844f94e0fbULL, 0x2eda7444cbfc426dULL,
+    0xc0314325637a1939ULL, 0xfa911155fefb5308ULL,
+    0xf03d93eebc589f88ULL, 0x793555ab7eba27caULL,
+    0x96267c7535b763b5ULL, 0x4bc1558b2f3458deULL,
+    0xbbb01b9283253ca2ULL, 0x9eb1aaedfb016f16ULL,
+    0xea9c227723ee8bcbULL, 0x465e15a979c1cadcULL,
+    0x92a1958a7675175fULL, 0x0bfacd89ec191ec9ULL,
+    0xb749faed14125d36ULL, 0xcef980ec671f667bULL,
+    0xe51c79a85916f484ULL, 0x82b7e12780e7401aULL,
+    0x8f31cc0937ae58d2ULL, 0xd1b2ecb8b0908810ULL,
+    0xb2fe3f0b8599ef07ULL, 0x861fa7e6dcb4aa15ULL,
+    0xdfbdcece67006ac9ULL, 0x67a791e093e1d49aULL,
+    0x8bd6a141006042bdULL, 0xe0c8bb2c5c6d24e0ULL,
+    0xaecc49914078536dULL, 0x58fae9f773886e18ULL,
+    0xda7f5bf590966848ULL, 0xaf39a475506a899eULL,
+    0x888f99797a5e012dULL, 0x6d8406c952429603ULL,
+    0xaab37fd7d8f58178ULL, 0xc8e5087ba6d33b83ULL,
+    0xd5605fcdcf32e1d6ULL, 0xfb1e4a9a90880a64ULL,
+    0x855c3be0a17fcd26ULL, 0x5cf2eea09a55067fULL,
+    0xa6b34ad8c9dfc06fULL, 0xf42faa48c0ea481eULL,
+    0xd0601d8efc57b08bULL, 0xf13b94daf124da26ULL,
+    0x823c12795db6ce57ULL, 0x76c53d08d6b70858ULL,
+    0xa2cb1717b52481edULL, 0x54768c4b0c64ca6eULL,
+    0xcb7ddcdda26da268ULL, 0xa9942f5dcf7dfd09ULL,
+    0xfe5d54150b090b02ULL, 0xd3f93b35435d7c4cULL,
+    0x9efa548d26e5a6e1ULL, 0xc47bc5014a1a6dafULL,
+    0xc6b8e9b0709f109aULL, 0x359ab6419ca1091bULL,
+    0xf867241c8cc6d4c0ULL, 0xc30163d203c94b62ULL,
+    0x9b407691d7fc44f8ULL, 0x79e0de63425dcf1dULL,
+    0xc21094364dfb5636ULL, 0x985915fc12f542e4ULL,
+    0xf294b943e17a2bc4ULL, 0x3e6f5b7b17b2939dULL,
+    0x979cf3ca6cec5b5aULL, 0xa705992ceecf9c42ULL,
+    0xbd8430bd08277231ULL, 0x50c6ff782a838353ULL,
+    0xece53cec4a314ebdULL, 0xa4f8bf5635246428ULL,
+    0x940f4613ae5ed136ULL, 0x871b7795e136be99ULL,
+    0xb913179899f68584ULL, 0x28e2557b59846e3fULL,
+    0xe757dd7ec07426e5ULL, 0x331aeada2fe589cfULL,
+    0x9096ea6f3848984fULL, 0x3ff0d2c85def7621ULL,
+    0xb4bca50b065abe63ULL, 0x0fed077a756b53a9ULL,
+    0xe1ebce4dc7f16dfbULL, 0xd3e8495912c62894ULL,
+    0x8d3360f09cf6e4bdULL, 0x64712dd7abbbd95cULL,
+    0xb080392cc4349decULL, 0xbd8d794d96aacfb3ULL,
+    0xdca04777f541c567ULL, 0xecf0d7a0fc5583a0ULL,
+    0x89e42caaf9491b60ULL, 0xf41686c49db57244ULL,
+    0xac5d37d5b79b6239ULL, 0x311c2875c522ced5ULL,
+    0xd77485cb25823ac7ULL, 0x7d633293366b828bULL,
+    0x86a8d39ef77164bcULL, 0xae5dff9c02033197ULL,
+    0xa8530886b54dbdebULL, 0xd9f57f830283fdfcULL,
+    0xd267caa862a12d66ULL, 0xd072df63c324fd7bULL,
+    0x8380dea93da4bc60ULL, 0x4247cb9e59f71e6dULL,
+    0xa46116538d0deb78ULL, 0x52d9be85f074e608ULL,
+    0xcd795be870516656ULL, 0x67902e276c921f8bULL,
+    0x806bd9714632dff6ULL, 0x00ba1cd8a3db53b6ULL,
+    0xa086cfcd97bf97f3ULL, 0x80e8a40eccd228a4ULL,
+    0xc8a883c0fdaf7df0ULL, 0x6122cd128006b2cdULL,
+    0xfad2a4b13d1b5d6cULL, 0x796b805720085f81ULL,
+    0x9cc3a6eec6311a63ULL, 0xcbe3303674053bb0ULL,
+    0xc3f490aa77bd60fcULL, 0xbedbfc4411068a9cULL,
+    0xf4f1b4d515acb93bULL, 0xee92fb5515482d44ULL,
+    0x991711052d8bf3c5ULL, 0x751bdd152d4d1c4aULL,
+    0xbf5cd54678eef0b6ULL, 0xd262d45a78a0635dULL,
+    0xef340a98172aace4ULL, 0x86fb897116c87c34ULL,
+    0x9580869f0e7aac0eULL, 0xd45d35e6ae3d4da0ULL,
+    0xbae0a846d2195712ULL, 0x8974836059cca109ULL,
+    0xe998d258869facd7ULL, 0x2bd1a438703fc94bULL,
+    0x91ff83775423cc06ULL, 0x7b6306a34627ddcfULL,
+    0xb67f6455292cbf08ULL, 0x1a3bc84c17b1d542ULL,
+    0xe41f3d6a7377eecaULL, 0x20caba5f1d9e4a93ULL,
+    0x8e938662882af53eULL, 0x547eb47b7282ee9cULL,
+    0xb23867fb2a35b28dULL, 0xe99e619a4f23aa43ULL,
+    0xdec681f9f4c31f31ULL, 0x6405fa00e2ec94d4ULL,
+    0x8b3c113c38f9f37eULL, 0xde83bc408dd3dd04ULL,
+    0xae0b158b4738705eULL, 0x9624ab50b148d445ULL,
+    0xd98ddaee19068c76ULL, 0x3badd624dd9b0957ULL,
+    0x87f8a8d4cfa417c9ULL, 0xe54ca5d70a80e5d6ULL,
+    0xa9f6d30a038d1dbcULL, 0x5e9fcf4ccd211f4cULL,
+    0xd47487cc8470652bULL, 0x7647c3200069671fULL,
+    0x84c8d4dfd2c63f3bULL, 0x29ecd9f40041e073ULL,
+    0xa5fb0a17c777cf09ULL, 0xf468107100525890ULL,
+    0xcf79cc9db955c2ccULL, 0x7182148d4066eeb4ULL,
+    0x81ac1fe293d599bfULL, 0xc6f14cd848405530ULL,
+    0xa21727db38cb002fULL, 0xb8ada00e5a506a7cULL,
+    0xca9cf1d206fdc03bULL, 0xa6d90811f0e4851cULL,
+    0xfd442e4688bd304aULL, 0x908f4a166d1da663ULL,
+    0x9e4a9cec15763e2eULL, 0x9a598e4e043287feULL,
+    0xc5dd44271ad3cdbaULL, 0x40eff1e1853f29fdULL,
+    0xf7549530e188c128ULL, 0xd12bee59e68ef47cULL,
+    0x9a94dd3e8cf578b9ULL, 0x82bb74f8301958ceULL,
+    0xc13a148e3032d6e7ULL, 0xe36a52363c1faf01ULL,
+    0xf18899b1bc3f8ca1ULL, 0xdc44e6c3cb279ac1ULL,
+    0x96f5600f15a7b7e5ULL, 0x29ab103a5ef8c0b9ULL,
+    0xbcb2b812db11a5deULL, 0x7415d448f6b6f0e7ULL,
+    0xebdf661791d60f56ULL, 0x111b495b3464ad21ULL,
+    0x936b9fcebb25c995ULL, 0xcab10dd900beec34ULL,
+    0xb84687c269ef3bfbULL, 0x3d5d514f40eea742ULL,
+    0xe65829b3046b0afaULL, 0x0cb4a5a3112a5112ULL,
+    0x8ff71a0fe2c2e6dcULL, 0x47f0e785eaba72abULL,
+    0xb3f4e093db73a093ULL, 0x59ed216765690f56ULL,
+    0xe0f218b8d25088b8ULL, 0x306869c13ec3532cULL,
+    0x8c974f7383725573ULL, 0x1e414218c73a13fbULL,
+    0xafbd2350644eeacfULL, 0xe5d1929ef90898faULL,
+    0xdbac6c247d62a583ULL, 0xdf45f746b74abf39ULL,
+    0x894bc396ce5da772ULL, 0x6b8bba8c328eb783ULL,
+    0xab9eb47c81f5114fULL, 0x066ea92f3f326564ULL,
+    0xd686619ba27255a2ULL, 0xc80a537b0efefebdULL,
+    0x8613fd0145877585ULL, 0xbd06742ce95f5f36ULL,
+    0xa798fc4196e952e7ULL, 0x2c48113823b73704ULL,
+    0xd17f3b51fca3a7a0ULL, 0xf75a15862ca504c5ULL,
+    0x82ef85133de648c4ULL, 0x9a984d73dbe722fbULL,
+    0xa3ab66580d5fdaf5ULL, 0xc13e60d0d2e0ebbaULL,
+    0xcc963fee10b7d1b3ULL, 0x318df905079926a8ULL,
+    0xffbbcfe994e5c61fULL, 0xfdf17746497f7052ULL,
+    0x9fd561f1fd0f9bd3ULL, 0xfeb6ea8bedefa633ULL,
+    0xc7caba6e7c5382c8ULL, 0xfe64a52ee96b8fc0ULL,
+    0xf9bd690a1b68637bULL, 0x3dfdce7aa3c673b0ULL,
+    0x9c1661a651213e2dULL, 0x06bea10ca65c084eULL,
+    0xc31bfa0fe5698db8ULL, 0x486e494fcff30a62ULL,
+    0xf3e2f893dec3f126ULL, 0x5a89dba3c3efccfaULL,
+    0x986ddb5c6b3a76b7ULL, 0xf89629465a75e01cULL,
+    0xbe89523386091465ULL, 0xf6bbb397f1135823ULL,
+    0xee2ba6c0678b597fULL, 0x746aa07ded582e2cULL,
+    0x94db483840b717efULL, 0xa8c2a44eb4571cdcULL,
+    0xba121a4650e4ddebULL, 0x92f34d62616ce413ULL,
+    0xe896a0d7e51e1566ULL, 0x77b020baf9c81d17ULL,
+    0x915e2486ef32cd60ULL, 0x0ace1474dc1d122eULL,
+    0xb5b5ada8aaff80b8ULL, 0x0d819992132456baULL,
+    0xe3231912d5bf60e6ULL, 0x10e1fff697ed6c69ULL,
+    0x8df5efabc5979c8fULL, 0xca8d3ffa1ef463c1ULL,
+    0xb1736b96b6fd83b3ULL, 0xbd308ff8a6b17cb2ULL,
+    0xddd0467c64bce4a0ULL, 0xac7cb3f6d05ddbdeULL,
+    0x8aa22c0dbef60ee4ULL, 0x6bcdf07a423aa96bULL,
+    0xad4ab7112eb3929dULL, 0x86c16c98d2c953c6ULL,
+    0xd89d64d57a607744ULL, 0xe871c7bf077ba8b7ULL,
+    0x87625f056c7c4a8bULL, 0x11471cd764ad4972ULL,
+    0xa93af6c6c79b5d2dULL, 0xd598e40d3dd89bcfULL,
+    0xd389b47879823479ULL, 0x4aff1d108d4ec2c3ULL,
+    0x843610cb4bf160cbULL, 0xcedf722a585139baULL,
+    0xa54394fe1eedb8feULL, 0xc2974eb4ee658828ULL,
+    0xce947a3da6a9273eULL, 0x733d226229feea32ULL,
+    0x811ccc668829b887ULL, 0x0806357d5a3f525fULL,
+    0xa163ff802a3426a8ULL, 0xca07c2dcb0cf26f7ULL,
+    0xc9bcff6034c13052ULL, 0xfc89b393dd02f0b5ULL,
+    0xfc2c3f3841f17c67ULL, 0xbbac2078d443ace2ULL,
+    0x9d9ba7832936edc0ULL, 0xd54b944b84aa4c0dULL,
+    0xc5029163f384a931ULL, 0x0a9e795e65d4df11ULL,
+    0xf64335bcf065d37dULL, 0x4d4617b5ff4a16d5ULL,
+    0x99ea0196163fa42eULL, 0x504bced1bf8e4e45ULL,
+    0xc06481fb9bcf8d39ULL, 0xe45ec2862f71e1d6ULL,
+    0xf07da27a82c37088ULL, 0x5d767327bb4e5a4cULL,
+    0x964e858c91ba2655ULL, 0x3a6a07f8d510f86fULL,
+    0xbbe226efb628afeaULL, 0x890489f70a55368bULL,
+    0xeadab0aba3b2dbe5ULL, 0x2b45ac74ccea842eULL,
+    0x92c8ae6b464fc96fULL, 0x3b0b8bc90012929dULL,
+    0xb77ada0617e3bbcbULL, 0x09ce6ebb40173744ULL,
+    0xe55990879ddcaabdULL, 0xcc420a6a101d0515ULL,
+    0x8f57fa54c2a9eab6ULL, 0x9fa946824a12232dULL,
+    0xb32df8e9f3546564ULL, 0x47939822dc96abf9ULL,
+    0xdff9772470297ebdULL, 0x59787e2b93bc56f7ULL,
+    0x8bfbea76c619ef36ULL, 0x57eb4edb3c55b65aULL,
+    0xaefae51477a06b03ULL, 0xede622920b6b23f1ULL,
+    0xdab99e59958885c4ULL, 0xe95fab368e45ecedULL,
+    0x88b402f7fd75539bULL, 0x11dbcb0218ebb414ULL,
+    0xaae103b5fcd2a881ULL, 0xd652bdc29f26a119ULL,
+    0xd59944a37c0752a2ULL, 0x4be76d3346f0495fULL,
+    0x857fcae62d8493a5ULL, 0x6f70a4400c562ddbULL,
+    0xa6dfbd9fb8e5b88eULL, 0xcb4ccd500f6bb952ULL,
+    0xd097ad07a71f26b2ULL, 0x7e2000a41346a7a7ULL,
+    0x825ecc24c873782fULL, 0x8ed400668c0c28c8ULL,
+    0xa2f67f2dfa90563bULL, 0x728900802f0f32faULL,
+    0xcbb41ef979346bcaULL, 0x4f2b40a03ad2ffb9ULL,
+    0xfea126b7d78186bcULL, 0xe2f610c84987bfa8ULL,
+    0x9f24b832e6b0f436ULL, 0x0dd9ca7d2df4d7c9ULL,
+    0xc6ede63fa05d3143ULL, 0x91503d1c79720dbbULL,
+    0xf8a95fcf88747d94ULL, 0x75a44c6397ce912aULL,
+    0x9b69dbe1b548ce7cULL, 0xc986afbe3ee11abaULL,
+    0xc24452da229b021bULL, 0xfbe85badce996168ULL,
+    0xf2d56790ab41c2a2ULL, 0xfae27299423fb9c3ULL,
+    0x97c560ba6b0919a5ULL, 0xdccd879fc967d41aULL,
+    0xbdb6b8e905cb600fULL, 0x5400e987bbc1c920ULL,
+    0xed246723473e3813ULL, 0x290123e9aab23b68ULL,
+    0x9436c0760c86e30bULL, 0xf9a0b6720aaf6521ULL,
+    0xb94470938fa89bceULL, 0xf808e40e8d5b3e69ULL,
+    0xe7958cb87392c2c2ULL, 0xb60b1d1230b20e04ULL,
+    0x90bd77f3483bb9b9ULL, 0xb1c6f22b5e6f48c2ULL,
+    0xb4ecd5f01a4aa828ULL, 0x1e38aeb6360b1af3ULL,
+    0xe2280b6c20dd5232ULL, 0x25c6da63c38de1b0ULL,
+    0x8d590723948a535fULL, 0x579c487e5a38ad0eULL,
+    0xb0af48ec79ace837ULL, 0x2d835a9df0c6d851ULL,
+    0xdcdb1b2798182244ULL, 0xf8e431456cf88e65ULL,
+    0x8a08f0f8bf0f156bULL, 0x1b8e9ecb641b58ffULL,
+    0xac8b2d36eed2dac5ULL, 0xe272467e3d222f3fULL,
+    0xd7adf884aa879177ULL, 0x5b0ed81dcc6abb0fULL,
+    0x86ccbb52ea94baeaULL, 0x98e947129fc2b4e9ULL,
+    0xa87fea27a539e9a5ULL, 0x3f2398d747b36224ULL,
+    0xd29fe4b18e88640eULL, 0x8eec7f0d19a03aadULL,
+    0x83a3eeeef9153e89ULL, 0x1953cf68300424acULL,
+    0xa48ceaaab75a8e2bULL, 0x5fa8c3423c052dd7ULL,
+    0xcdb02555653131b6ULL, 0x3792f412cb06794dULL,
+    0x808e17555f3ebf11ULL, 0xe2bbd88bbee40bd0ULL,
+    0xa0b19d2ab70e6ed6ULL, 0x5b6aceaeae9d0ec4ULL,
+    0xc8de047564d20a8bULL, 0xf245825a5a445275ULL,
+    0xfb158592be068d2eULL, 0xeed6e2f0f0d56712ULL,
+    0x9ced737bb6c4183dULL, 0x55464dd69685606bULL,
+    0xc428d05aa4751e4cULL, 0xaa97e14c3c26b886ULL,
+    0xf53304714d9265dfULL, 0xd53dd99f4b3066a8ULL,
+    0x993fe2c6d07b7fabULL, 0xe546a8038efe4029ULL,
+    0xbf8fdb78849a5f96ULL, 0xde98520472bdd033ULL,
+    0xef73d256a5c0f77cULL, 0x963e66858f6d4440ULL,
+    0x95a8637627989aadULL, 0xdde7001379a44aa8ULL,
+    0xbb127c53b17ec159ULL, 0x5560c018580d5d52ULL,
+    0xe9d71b689dde71afULL, 0xaab8f01e6e10b4a6ULL,
+    0x9226712162ab070dULL, 0xcab3961304ca70e8ULL,
+    0xb6b00d69bb55c8d1ULL, 0x3d607b97c5fd0d22ULL,
+    0xe45c10c42a2b3b05ULL, 0x8cb89a7db77c506aULL,
+    0x8eb98a7a9a5b04e3ULL, 0x77f3608e92adb242ULL,
+    0xb267ed1940f1c61cULL, 0x55f038b237591ed3ULL,
+    0xdf01e85f912e37a3ULL, 0x6b6c46dec52f6688ULL,
+    0x8b61313bbabce2c6ULL, 0x2323ac4b3b3da015ULL,
+    0xae397d8aa96c1b77ULL, 0xabec975e0a0d081aULL,
+    0xd9c7dced53c72255ULL, 0x96e7bd358c904a21ULL,
+    0x881cea14545c7575ULL, 0x7e50d64177da2e54ULL,
+    0xaa242499697392d2ULL, 0xdde50bd1d5d0b9e9ULL,
+    0xd4ad2dbfc3d07787ULL, 0x955e4ec64b44e864ULL,
+    0x84ec3c97da624ab4ULL, 0xbd5af13bef0b113eULL,
+    0xa6274bbdd0fadd61ULL, 0xecb1ad8aeacdd58eULL,
+    0xcfb11ead453994baULL, 0x67de18eda5814af2ULL,
+    0x81ceb32c4b43fcf4ULL, 0x80eacf948770ced7ULL,
+    0xa2425ff75e14fc31ULL, 0xa1258379a94d028dULL,
+    0xcad2f7f5359a3b3eULL, 0x096ee45813a04330ULL,
+    0xfd87b5f28300ca0dULL, 0x8bca9d6e188853fcULL,
+    0x9e74d1b791e07e48ULL, 0x775ea264cf55347eULL,
+    0xc612062576589ddaULL, 0x95364afe032a819eULL,
+    0xf79687aed3eec551ULL, 0x3a83ddbd83f52205ULL,
+    0x9abe14cd44753b52ULL, 0xc4926a9672793543ULL,
+    0xc16d9a0095928a27ULL, 0x75b7053c0f178294ULL,
+    0xf1c90080baf72cb1ULL, 0x5324c68b12dd6339ULL,
+    0x971da05074da7beeULL, 0xd3f6fc16ebca5e04ULL,
+    0xbce5086492111aeaULL, 0x88f4bb1ca6bcf585ULL,
+    0xec1e4a7db69561a5ULL, 0x2b31e9e3d06c32e6ULL,
+    0x9392ee8e921d5d07ULL, 0x3aff322e62439fd0ULL,
+    0xb877aa3236a4b449ULL, 0x09befeb9fad487c3ULL,
+    0xe69594bec44de15bULL, 0x4c2ebe687989a9b4ULL,
+    0x901d7cf73ab0acd9ULL, 0x0f9d37014bf60a11ULL,
+    0xb424dc35095cd80fULL, 0x538484c19ef38c95ULL,
+    0xe12e13424bb40e13ULL, 0x2865a5f206b06fbaULL,
+    0x8cbccc096f5088cbULL, 0xf93f87b7442e45d4ULL,
+    0xafebff0bcb24aafeULL, 0xf78f69a51539d749ULL,
+    0xdbe6fecebdedd5beULL, 0xb573440e5a884d1cULL,
+    0x89705f4136b4a597ULL, 0x31680a88f8953031ULL,
+    0xabcc77118461cefcULL, 0xfdc20d2b36ba7c3eULL,
+    0xd6bf94d5e57a42bcULL, 0x3d32907604691b4dULL,
+    0x8637bd05af6c69b5ULL, 0xa63f9a49c2c1b110ULL,
+    0xa7c5ac471b478423ULL, 0x0fcf80dc33721d54ULL,
+    0xd1b71758e219652bULL, 0xd3c36113404ea4a9ULL,
+    0x83126e978d4fdf3bULL, 0x645a1cac083126eaULL,
+    0xa3d70a3d70a3d70aULL, 0x3d70a3d70a3d70a4ULL,
+    0xccccccccccccccccULL, 0xcccccccccccccccdULL,
+    0x8000000000000000ULL, 0x0000000000000000ULL,
+    0xa000000000000000ULL, 0x0000000000000000ULL,
+    0xc800000000000000ULL, 0x0000000000000000ULL,
+    0xfa00000000000000ULL, 0x0000000000000000ULL,
+    0x9c40000000000000ULL, 0x0000000000000000ULL,
+    0xc350000000000000ULL, 0x0000000000000000ULL,
+    0xf424000000000000ULL, 0x0000000000000000ULL,
+    0x9896800000000000ULL, 0x0000000000000000ULL,
+    0xbebc200000000000ULL, 0x0000000000000000ULL,
+    0xee6b280000000000ULL, 0x0000000000000000ULL,
+    0x9502f90000000000ULL, 0x0000000000000000ULL,
+    0xba43b74000000000ULL, 0x0000000000000000ULL,
+    0xe8d4a51000000000ULL, 0x0000000000000000ULL,
+    0x9184e72a00000000ULL, 0x0000000000000000ULL,
+    0xb5e620f480000000ULL, 0x0000000000000000ULL,
+    0xe35fa931a0000000ULL, 0x0000000000000000ULL,
+    0x8e1bc9bf04000000ULL, 0x0000000000000000ULL,
+    0xb1a2bc2ec5000000ULL, 0x0000000000000000ULL,
+    0xde0b6b3a76400000ULL, 0x0000000000000000ULL,
+    0x8ac7230489e80000ULL, 0x0000000000000000ULL,
+    0xad78ebc5ac620000ULL, 0x0000000000000000ULL,
+    0xd8d726b7177a8000ULL, 0x0000000000000000ULL,
+    0x878678326eac9000ULL, 0x0000000000000000ULL,
+    0xa968163f0a57b400ULL, 0x0000000000000000ULL,
+    0xd3c21bcecceda100ULL, 0x0000000000000000ULL,
+    0x84595161401484a0ULL, 0x0000000000000000ULL,
+    0xa56fa5b99019a5c8ULL, 0x0000000000000000ULL,
+    0xcecb8f27f4200f3aULL, 0x0000000000000000ULL,
+    0x813f3978f8940984ULL, 0x4000000000000000ULL,
+    0xa18f07d736b90be5ULL, 0x5000000000000000ULL,
+    0xc9f2c9cd04674edeULL, 0xa400000000000000ULL,
+    0xfc6f7c4045812296ULL, 0x4d00000000000000ULL,
+    0x9dc5ada82b70b59dULL, 0xf020000000000000ULL,
+    0xc5371912364ce305ULL, 0x6c28000000000000ULL,
+    0xf684df56c3e01bc6ULL, 0xc732000000000000ULL,
+    0x9a130b963a6c115cULL, 0x3c7f400000000000ULL,
+    0xc097ce7bc90715b3ULL, 0x4b9f100000000000ULL,
+    0xf0bdc21abb48db20ULL, 0x1e86d40000000000ULL,
+    0x96769950b50d88f4ULL, 0x1314448000000000ULL,
+    0xbc143fa4e250eb31ULL, 0x17d955a000000000ULL,
+    0xeb194f8e1ae525fdULL, 0x5dcfab0800000000ULL,
+    0x92efd1b8d0cf37beULL, 0x5aa1cae500000000ULL,
+    0xb7abc627050305adULL, 0xf14a3d9e40000000ULL,
+    0xe596b7b0c643c719ULL, 0x6d9ccd05d0000000ULL,
+    0x8f7e32ce7bea5c6fULL, 0xe4820023a2000000ULL,
+    0xb35dbf821ae4f38bULL, 0xdda2802c8a800000ULL,
+    0xe0352f62a19e306eULL, 0xd50b2037ad200000ULL,
+    0x8c213d9da502de45ULL, 0x4526f422cc340000ULL,
+    0xaf298d050e4395d6ULL, 0x9670b12b7f410000ULL,
+    0xdaf3f04651d47b4cULL, 0x3c0cdd765f114000ULL,
+    0x88d8762bf324cd0fULL, 0xa5880a69fb6ac800ULL,
+    0xab0e93b6efee0053ULL, 0x8eea0d047a457a00ULL,
+    0xd5d238a4abe98068ULL, 0x72a4904598d6d880ULL,
+    0x85a36366eb71f041ULL, 0x47a6da2b7f864750ULL,
+    0xa70c3c40a64e6c51ULL, 0x999090b65f67d924ULL,
+    0xd0cf4b50cfe20765ULL, 0xfff4b4e3f741cf6dULL,
+    0x82818f1281ed449fULL, 0xbff8f10e7a8921a4ULL,
+    0xa321f2d7226895c7ULL, 0xaff72d52192b6a0dULL,
+    0xcbea6f8ceb02bb39ULL, 0x9bf4f8a69f764490ULL,
+    0xfee50b7025c36a08ULL, 0x02f236d04753d5b4ULL,
+    0x9f4f2726179a2245ULL, 0x01d762422c946590ULL,
+    0xc722f0ef9d80aad6ULL, 0x424d3ad2b7b97ef5ULL,
+    0xf8ebad2b84e0d58bULL, 0xd2e0898765a7deb2ULL,
+    0x9b934c3b330c8577ULL, 0x63cc55f49f88eb2fULL,
+    0xc2781f49ffcfa6d5ULL, 0x3cbf6b71c76b25fbULL,
+    0xf316271c7fc3908aULL, 0x8bef464e3945ef7aULL,
+    0x97edd871cfda3a56ULL, 0x97758bf0e3cbb5acULL,
+    0xbde94e8e43d0c8ecULL, 0x3d52eeed1cbea317ULL,
+    0xed63a231d4c4fb27ULL, 0x4ca7aaa863ee4bddULL,
+    0x945e455f24fb1cf8ULL, 0x8fe8caa93e74ef6aULL,
+    0xb975d6b6ee39e436ULL, 0xb3e2fd538e122b44ULL,
+    0xe7d34c64a9c85d44ULL, 0x60dbbca87196b616ULL,
+    0x90e40fbeea1d3a4aULL, 0xbc8955e946fe31cdULL,
+    0xb51d13aea4a488ddULL, 0x6babab6398bdbe41ULL,
+    0xe264589a4dcdab14ULL, 0xc696963c7eed2dd1ULL,
+    0x8d7eb76070a08aecULL, 0xfc1e1de5cf543ca2ULL,
+    0xb0de65388cc8ada8ULL, 0x3b25a55f43294bcbULL,
+    0xdd15fe86affad912ULL, 0x49ef0eb713f39ebeULL,
+    0x8a2dbf142dfcc7abULL, 0x6e3569326c784337ULL,
+    0xacb92ed9397bf996ULL, 0x49c2c37f07965404ULL,
+    0xd7e77a8f87daf7fbULL, 0xdc33745ec97be906ULL,
+    0x86f0ac99b4e8dafdULL, 0x69a028bb3ded71a3ULL,
+    0xa8acd7c0222311bcULL, 0xc40832ea0d68ce0cULL,
+    0xd2d80db02aabd62bULL, 0xf50a3fa490c30190ULL,
+    0x83c7088e1aab65dbULL, 0x792667c6da79e0faULL,
+    0xa4b8cab1a1563f52ULL, 0x577001b891185938ULL,
+    0xcde6fd5e09abcf26ULL, 0xed4c0226b55e6f86ULL,
+    0x80b05e5ac60b6178ULL, 0x544f8158315b05b4ULL,
+    0xa0dc75f1778e39d6ULL, 0x696361ae3db1c721ULL,
+    0xc913936dd571c84cULL, 0x03bc3a19cd1e38e9ULL,
+    0xfb5878494ace3a5fULL, 0x04ab48a04065c723ULL,
+    0x9d174b2dcec0e47bULL, 0x62eb0d64283f9c76ULL,
+    0xc45d1df942711d9aULL, 0x3ba5d0bd324f8394ULL,
+    0xf5746577930d6500ULL, 0xca8f44ec7ee36479ULL,
+    0x9968bf6abbe85f20ULL, 0x7e998b13cf4e1ecbULL,
+    0xbfc2ef456ae276e8ULL, 0x9e3fedd8c321a67eULL,
+    0xefb3ab16c59b14a2ULL, 0xc5cfe94ef3ea101eULL,
+    0x95d04aee3b80ece5ULL, 0xbba1f1d158724a12ULL,
+    0xbb445da9ca61281fULL, 0x2a8a6e45ae8edc97ULL,
+    0xea1575143cf97226ULL, 0xf52d09d71a3293bdULL,
+    0x924d692ca61be758ULL, 0x593c2626705f9c56ULL,
+    0xb6e0c377cfa2e12eULL, 0x6f8b2fb00c77836cULL,
+    0xe498f455c38b997aULL, 0x0b6dfb9c0f956447ULL,
+    0x8edf98b59a373fecULL, 0x4724bd4189bd5eacULL,
+    0xb2977ee300c50fe7ULL, 0x58edec91ec2cb657ULL,
+    0xdf3d5e9bc0f653e1ULL, 0x2f2967b66737e3edULL,
+    0x8b865b215899f46cULL, 0xbd79e0d20082ee74ULL,
+    0xae67f1e9aec07187ULL, 0xecd8590680a3aa11ULL,
+    0xda01ee641a708de9ULL, 0xe80e6f4820cc9495ULL,
+    0x884134fe908658b2ULL, 0x3109058d147fdcddULL,
+    0xaa51823e34a7eedeULL, 0xbd4b46f0599fd415ULL,
+    0xd4e5e2cdc1d1ea96ULL, 0x6c9e18ac7007c91aULL,
+    0x850fadc09923329eULL, 0x03e2cf6bc604ddb0ULL,
+    0xa6539930bf6bff45ULL, 0x84db8346b786151cULL,
+    0xcfe87f7cef46ff16ULL, 0xe612641865679a63ULL,
+    0x81f14fae158c5f6eULL, 0x4fcb7e8f3f60c07eULL,
+    0xa26da3999aef7749ULL, 0xe3be5e330f38f09dULL,
+    0xcb090c8001ab551cULL, 0x5cadf5bfd3072cc5ULL,
+    0xfdcb4fa002162a63ULL, 0x73d9732fc7c8f7f6ULL,
+    0x9e9f11c4014dda7eULL, 0x2867e7fddcdd9afaULL,
+    0xc646d63501a1511dULL, 0xb281e1fd541501b8ULL,
+    0xf7d88bc24209a565ULL, 0x1f225a7ca91a4226ULL,
+    0x9ae757596946075fULL, 0x3375788de9b06958ULL,
+    0xc1a12d2fc3978937ULL, 0x0052d6b1641c83aeULL,
+    0xf209787bb47d6b84ULL, 0xc0678c5dbd23a49aULL,
+    0x9745eb4d50ce6332ULL, 0xf840b7ba963646e0ULL,
+    0xbd176620a501fbffULL, 0xb650e5a93bc3d898ULL,
+    0xec5d3fa8ce427affULL, 0xa3e51f138ab4cebeULL,
+    0x93ba47c980e98cdfULL, 0xc66f336c36b10137ULL,
+    0xb8a8d9bbe123f017ULL, 0xb80b0047445d4184ULL,
+    0xe6d3102ad96cec1dULL, 0xa60dc059157491e5ULL,
+    0x9043ea1ac7e41392ULL, 0x87c89837ad68db2fULL,
+    0xb454e4a179dd1877ULL, 0x29babe4598c311fbULL,
+    0xe16a1dc9d8545e94ULL, 0xf4296dd6fef3d67aULL,
+    0x8ce2529e2734bb1dULL, 0x1899e4a65f58660cULL,
+    0xb01ae745b101e9e4ULL, 0x5ec05dcff72e7f8fULL,
+    0xdc21a1171d42645dULL, 0x76707543f4fa1f73ULL,
+    0x899504ae72497ebaULL, 0x6a06494a791c53a8ULL,
+    0xabfa45da0edbde69ULL, 0x0487db9d17636892ULL,
+    0xd6f8d7509292d603ULL, 0x45a9d2845d3c42b6ULL,
+    0x865b86925b9bc5c2ULL, 0x0b8a2392ba45a9b2ULL,
+    0xa7f26836f282b732ULL, 0x8e6cac7768d7141eULL,
+    0xd1ef0244af2364ffULL, 0x3207d795430cd926ULL,
+    0x8335616aed761f1fULL, 0x7f44e6bd49e807b8ULL,
+    0xa402b9c5a8d3a6e7ULL, 0x5f16206c9c6209a6ULL,
+    0xcd036837130890a1ULL, 0x36dba887c37a8c0fULL,
+    0x802221226be55a64ULL, 0xc2494954da2c9789ULL,
+    0xa02aa96b06deb0fdULL, 0xf2db9baa10b7bd6cULL,
+    0xc83553c5c8965d3dULL, 0x6f92829494e5acc7ULL,
+    0xfa42a8b73abbf48cULL, 0xcb772339ba1f17f9ULL,
+    0x9c69a97284b578d7ULL, 0xff2a760414536efbULL,
+    0xc38413cf25e2d70dULL, 0xfef5138519684abaULL,
+    0xf46518c2ef5b8cd1ULL, 0x7eb258665fc25d69ULL,
+    0x98bf2f79d5993802ULL, 0xef2f773ffbd97a61ULL,
+    0xbeeefb584aff8603ULL, 0xaafb550ffacfd8faULL,
+    0xeeaaba2e5dbf6784ULL, 0x95ba2a53f983cf38ULL,
+    0x952ab45cfa97a0b2ULL, 0xdd945a747bf26183ULL,
+    0xba756174393d88dfULL, 0x94f971119aeef9e4ULL,
+    0xe912b9d1478ceb17ULL, 0x7a37cd5601aab85dULL,
+    0x91abb422ccb812eeULL, 0xac62e055c10ab33aULL,
+    0xb616a12b7fe617aaULL, 0x577b986b314d6009ULL,
+    0xe39c49765fdf9d94ULL, 0xed5a7e85fda0b80bULL,
+    0x8e41ade9fbebc27dULL, 0x14588f13be847307ULL,
+    0xb1d219647ae6b31cULL, 0x596eb2d8ae258fc8ULL,
+    0xde469fbd99a05fe3ULL, 0x6fca5f8ed9aef3bbULL,
+    0x8aec23d680043beeULL, 0x25de7bb9480d5854ULL,
+    0xada72ccc20054ae9ULL, 0xaf561aa79a10ae6aULL,
+    0xd910f7ff28069da4ULL, 0x1b2ba1518094da04ULL,
+    0x87aa9aff79042286ULL, 0x90fb44d2f05d0842ULL,
+    0xa99541bf57452b28ULL, 0x353a1607ac744a53ULL,
+    0xd3fa922f2d1675f2ULL, 0x42889b8997915ce8ULL,
+    0x847c9b5d7c2e09b7ULL, 0x69956135febada11ULL,
+    0xa59bc234db398c25ULL, 0x43fab9837e699095ULL,
+    0xcf02b2c21207ef2eULL, 0x94f967e45e03f4bbULL,
+    0x8161afb94b44f57dULL, 0x1d1be0eebac278f5ULL,
+    0xa1ba1ba79e1632dcULL, 0x6462d92a69731732ULL,
+    0xca28a291859bbf93ULL, 0x7d7b8f7503cfdcfeULL,
+    0xfcb2cb35e702af78ULL, 0x5cda735244c3d43eULL,
+    0x9defbf01b061adabULL, 0x3a0888136afa64a7ULL,
+    0xc56baec21c7a1916ULL, 0x088aaa1845b8fdd0ULL,
+    0xf6c69a72a3989f5bULL, 0x8aad549e57273d45ULL,
+    0x9a3c2087a63f6399ULL, 0x36ac54e2f678864bULL,
+    0xc0cb28a98fcf3c7fULL, 0x84576a1bb416a7ddULL,
+    0xf0fdf2d3f3c30b9fULL, 0x656d44a2a11c51d5ULL,
+    0x969eb7c47859e743ULL, 0x9f644ae5a4b1b325ULL,
+    0xbc4665b596706114ULL, 0x873d5d9f0dde1feeULL,
+    0xeb57ff22fc0c7959ULL, 0xa90cb506d155a7eaULL,
+    0x9316ff75dd87cbd8ULL, 0x09a7f12442d588f2ULL,
+    0xb7dcbf5354e9beceULL, 0x0c11ed6d538aeb2fULL,
+    0xe5d3ef282a242e81ULL, 0x8f1668c8a86da5faULL,
+    0x8fa475791a569d10ULL, 0xf96e017d694487bcULL,
+    0xb38d92d760ec4455ULL, 0x37c981dcc395a9acULL,
+    0xe070f78d3927556aULL, 0x85bbe253f47b1417ULL,
+    0x8c469ab843b89562ULL, 0x93956d7478ccec8eULL,
+    0xaf58416654a6babbULL, 0x387ac8d1970027b2ULL,
+    0xdb2e51bfe9d0696aULL, 0x06997b05fcc0319eULL,
+    0x88fcf317f22241e2ULL, 0x441fece3bdf81f03ULL,
+    0xab3c2fddeeaad25aULL, 0xd527e81cad7626c3ULL,
+    0xd60b3bd56a5586f1ULL, 0x8a71e223d8d3b074ULL,
+    0x85c7056562757456ULL, 0xf6872d5667844e49ULL,
+    0xa738c6bebb12d16cULL, 0xb428f8ac016561dbULL,
+    0xd106f86e69d785c7ULL, 0xe13336d701beba52ULL,
+    0x82a45b450226b39cULL, 0xecc0024661173473ULL,
+    0xa34d721642b06084ULL, 0x27f002d7f95d0190ULL,
+    0xcc20ce9bd35c78a5ULL, 0x31ec038df7b441f4ULL,
+    0xff290242c83396ceULL, 0x7e67047175a15271ULL,
+    0x9f79a169bd203e41ULL, 0x0f0062c6e984d386ULL,
+    0xc75809c42c684dd1ULL, 0x52c07b78a3e60868ULL,
+    0xf92e0c3537826145ULL, 0xa7709a56ccdf8a82ULL,
+    0x9bbcc7a142b17ccbULL, 0x88a66076400bb691ULL,
+    0xc2abf989935ddbfeULL, 0x6acff893d00ea435ULL,
+    0xf356f7ebf83552feULL, 0x0583f6b8c4124d43ULL,
+    0x98165af37b2153deULL, 0xc3727a337a8b704aULL,
+    0xbe1bf1b059e9a8d6ULL, 0x744f18c0592e4c5cULL,
+    0xeda2ee1c7064130cULL, 0x1162def06f79df73ULL,
+    0x9485d4d1c63e8be7ULL, 0x8addcb5645ac2ba8ULL,
+    0xb9a74a0637ce2ee1ULL, 0x6d953e2bd7173692ULL,
+    0xe8111c87c5c1ba99ULL, 0xc8fa8db6ccdd0437ULL,
+    0x910ab1d4db9914a0ULL, 0x1d9c9892400a22a2ULL,
+    0xb54d5e4a127f59c8ULL, 0x2503beb6d00cab4bULL,
+    0xe2a0b5dc971f303aULL, 0x2e44ae64840fd61dULL,
+    0x8da471a9de737e24ULL, 0x5ceaecfed289e5d2ULL,
+    0xb10d8e1456105dadULL, 0x7425a83e872c5f47ULL,
+    0xdd50f1996b947518ULL, 0xd12f124e28f77719ULL,
+    0x8a5296ffe33cc92fULL, 0x82bd6b70d99aaa6fULL,
+    0xace73cbfdc0bfb7bULL, 0x636cc64d1001550bULL,
+    0xd8210befd30efa5aULL, 0x3c47f7e05401aa4eULL,
+    0x8714a775e3e95c78ULL, 0x65acfaec34810a71ULL,
+    0xa8d9d1535ce3b396ULL, 0x7f1839a741a14d0dULL,
+    0xd31045a8341ca07cULL, 0x1ede48111209a050ULL,
+    0x83ea2b892091e44dULL, 0x934aed0aab460432ULL,
+    0xa4e4b66b68b65d60ULL, 0xf81da84d5617853fULL,
+    0xce1de40642e3f4b9ULL, 0x36251260ab9d668eULL,
+    0x80d2ae83e9ce78f3ULL, 0xc1d72b7c6b426019ULL,
+    0xa1075a24e4421730ULL, 0xb24cf65b8612f81fULL,
+    0xc94930ae1d529cfcULL, 0xdee033f26797b627ULL,
+    0xfb9b7cd9a4a7443cULL, 0x169840ef017da3b1ULL,
+    0x9d412e0806e88aa5ULL, 0x8e1f289560ee864eULL,
+    0xc491798a08a2ad4eULL, 0xf1a6f2bab92a27e2ULL,
+    0xf5b5d7ec8acb58a2ULL, 0xae10af696774b1dbULL,
+    0x9991a6f3d6bf1765ULL, 0xacca6da1e0a8ef29ULL,
+    0xbff610b0cc6edd3fULL, 0x17fd090a58d32af3ULL,
+    0xeff394dcff8a948eULL, 0xddfc4b4cef07f5b0ULL,
+    0x95f83d0a1fb69cd9ULL, 0x4abdaf101564f98eULL,
+    0xbb764c4ca7a4440fULL, 0x9d6d1ad41abe37f1ULL,
+    0xea53df5fd18d5513ULL, 0x84c86189216dc5edULL,
+    0x92746b9be2f8552cULL, 0x32fd3cf5b4e49bb4ULL,
+    0xb7118682dbb66a77ULL, 0x3fbc8c33221dc2a1ULL,
+    0xe4d5e82392a40515ULL, 0x0fabaf3feaa5334aULL,
+    0x8f05b1163ba6832dULL, 0x29cb4d87f2a7400eULL,
+    0xb2c71d5bca9023f8ULL, 0x743e20e9ef511012ULL,
+    0xdf78e4b2bd342cf6ULL, 0x914da9246b255416ULL,
+    0x8bab8eefb6409c1aULL, 0x1ad089b6c2f7548eULL,
+    0xae9672aba3d0c320ULL, 0xa184ac2473b529b1ULL,
+    0xda3c0f568cc4f3e8ULL, 0xc9e5d72d90a2741eULL,
+    0x8865899617fb1871ULL, 0x7e2fa67c7a658892ULL,
+    0xaa7eebfb9df9de8dULL, 0xddbb901b98feeab7ULL,
+    0xd51ea6fa85785631ULL, 0x552a74227f3ea565ULL,
+    0x8533285c936b35deULL, 0xd53a88958f87275fULL,
+    0xa67ff273b8460356ULL, 0x8a892abaf368f137ULL,
+    0xd01fef10a657842cULL, 0x2d2b7569b0432d85ULL,
+    0x8213f56a67f6b29bULL, 0x9c3b29620e29fc73ULL,
+    0xa298f2c501f45f42ULL, 0x8349f3ba91b47b8fULL,
+    0xcb3f2f7642717713ULL, 0x241c70a936219a73ULL,
+    0xfe0efb53d30dd4d7ULL, 0xed238cd383aa0110ULL,
+    0x9ec95d1463e8a506ULL, 0xf4363804324a40aaULL,
+    0xc67bb4597ce2ce48ULL, 0xb143c6053edcd0d5ULL,
+    0xf81aa16fdc1b81daULL, 0xdd94b7868e94050aULL,
+    0x9b10a4e5e9913128ULL, 0xca7cf2b4191c8326ULL,
+    0xc1d4ce1f63f57d72ULL, 0xfd1c2f611f63a3f0ULL,
+    0xf24a01a73cf2dccfULL, 0xbc633b39673c8cecULL,
+    0x976e41088617ca01ULL, 0xd5be0503e085d813ULL,
+    0xbd49d14aa79dbc82ULL, 0x4b2d8644d8a74e18ULL,
+    0xec9c459d51852ba2ULL, 0xddf8e7d60ed1219eULL,
+    0x93e1ab8252f33b45ULL, 0xcabb90e5c942b503ULL,
+    0xb8da1662e7b00a17ULL, 0x3d6a751f3b936243ULL,
+    0xe7109bfba19c0c9dULL, 0x0cc512670a783ad4ULL,
+    0x906a617d450187e2ULL, 0x27fb2b80668b24c5ULL,
+    0xb484f9dc9641e9daULL, 0xb1f9f660802dedf6ULL,
+    0xe1a63853bbd26451ULL, 0x5e7873f8a0396973ULL,
+    0x8d07e33455637eb2ULL, 0xdb0b487b6423e1e8ULL,
+    0xb049dc016abc5e5fULL, 0x91ce1a9a3d2cda62ULL,
+    0xdc5c5301c56b75f7ULL, 0x7641a140cc7810fbULL,
+    0x89b9b3e11b6329baULL, 0xa9e904c87fcb0a9dULL,
+    0xac2820d9623bf429ULL, 0x546345fa9fbdcd44ULL,
+    0xd732290fbacaf133ULL, 0xa97c177947ad4095ULL,
+    0x867f59a9d4bed6c0ULL, 0x49ed8eabcccc485dULL,
+    0xa81f301449ee8c70ULL, 0x5c68f256bfff5a74ULL,
+    0xd226fc195c6a2f8cULL, 0x73832eec6fff3111ULL,
+    0x83585d8fd9c25db7ULL, 0xc831fd53c5ff7eabULL,
+    0xa42e74f3d032f525ULL, 0xba3e7ca8b77f5e55ULL,
+    0xcd3a1230c43fb26fULL, 0x28ce1bd2e55f35ebULL,
+    0x80444b5e7aa7cf85ULL, 0x7980d163cf5b81b3ULL,
+    0xa0555e361951c366ULL, 0xd7e105bcc332621fULL,
+    0xc86ab5c39fa63440ULL, 0x8dd9472bf3fefaa7ULL,
+    0xfa856334878fc150ULL, 0xb14f98f6f0feb951ULL,
+    0x9c935e00d4b9d8d2ULL, 0x6ed1bf9a569f33d3ULL,
+    0xc3b8358109e84f07ULL, 0x0a862f80ec4700c8ULL,
+    0xf4a642e14c6262c8ULL, 0xcd27bb612758c0faULL,
+    0x98e7e9cccfbd7dbdULL, 0x8038d51cb897789cULL,
+    0xbf21e44003acdd2cULL, 0xe0470a63e6bd56c3ULL,
+    0xeeea5d5004981478ULL, 0x1858ccfce06cac74ULL,
+    0x95527a5202df0ccbULL, 0x0f37801e0c43ebc8ULL,
+    0xbaa718e68396cffdULL, 0xd30560258f54e6baULL,
+    0xe950df20247c83fdULL, 0x47c6b82ef32a2069ULL,
+    0x91d28b7416cdd27eULL, 0x4cdc331d57fa5441ULL,
+    0xb6472e511c81471dULL, 0xe0133fe4adf8e952ULL,
+    0xe3d8f9e563a198e5ULL, 0x58180fddd97723a6ULL,
+    0x8e679c2f5e44ff8fULL, 0x570f09eaa7ea7648ULL,
+};
+
+static const double POW10_EXACT[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+double _stringDoubleFromBits(uint64_t bits) {
+    double d;
+    memcpy(&d, &bits, sizeof(d));
+    return d;
+}
+
+// Eisel-Lemire: w * 10^q rounded to the nearest double, as raw bits without
+// the sign. Returns false in the rare cases the truncated product cannot
+// decide the rounding.
+bool _stringEiselLemire(uint64_t w, int64_t q, uint64_t *bits) {
+    if (w == 0 || q < POW5_MIN_EXP) {
+        *bits = 0;
+        return true;
+    }
+    if (q > POW5_MAX_EXP) {
+        *bits = 0x7FF0000000000000ULL;
+        return true;
+    }
+    const int lz = __builtin_clzll(w);
+    w <<= lz;
+    const size_t index = 2 * (size_t)(q - POW5_MIN_EXP);
+    uint64_t lo = w;
+    uint64_t hi = POW5_128[index];
+    _stringMul128(&lo, &hi);
+    if ((hi & 0x1FF) == 0x1FF) {
+        uint64_t lo2 = w;
+        uint64_t hi2 = POW5_128[index + 1];
+        _stringMul128(&lo2, &hi2);
+        lo += hi2;
+        if (hi2 > lo) ++hi;
+        if (lo == UINT64_MAX && (q < -27 || q > 55)) return false;
+    }
+    const int upper = (int)(hi >> 63);
+    const int shift = upper + 9;
+    uint64_t mantissa = hi >> shift;
+    int32_t power2 = (int32_t)((((152170 + 65536) * q) >> 16) + 63) + upper - lz + 1023;
+    if (power2 <= 0) {
+        // subnormal
+        if (-power2 + 1 >= 64) {
+            *bits = 0;
+            return true;
+        }
+        mantissa >>= -power2 + 1;
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+        power2 = mantissa < (1ULL << 52) ? 0 : 1;
+        *bits = mantissa | ((uint64_t)power2 << 52);
+        return true;
+    }
+    // exactly halfway between two doubles: round to even
+    if (lo <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1 && (mantissa << shift) == hi) {
+        mantissa &= ~1ULL;
+    }
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+    if (mantissa >= (2ULL << 52)) {
+        mantissa = 1ULL << 52;
+        ++power2;
+    }
+    mantissa &= ~(1ULL << 52);
+    if (power2 >= 0x7FF) {
+        *bits = 0x7FF0000000000000ULL;
+        return true;
+    }
+    *bits = mantissa | ((uint64_t)power2 << 52);
+    return true;
+}
+
+// Exact fallback for inputs Eisel-Lemire cannot settle: the digits are
+// handed to strtod as "<digits>e<exp>", which has no locale-dependent
+// decimal point.
+double _stringParseDoubleSlow(const char *p, size_t n, int64_t exp10) {
+    char local[128];
+    size_t cap = n + 32;
+    char *buf = cap <= sizeof(local) ? local : (char *)malloc(cap);
+    if (buf == NULL) return 0;
+    size_t len = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (p[i] != '.') buf[len++] = p[i];
+    }
+    snprintf(buf + len, cap - len, "e%" PRId64, exp10);
+    double res = strtod(buf, NULL);
+    if (buf != local) free(buf);
+    return res;
+}
+
+bool _stringMatchWordIgnoreCase(const char *p, size_t n, const char *word) {
+    size_t m = strlen(word);
+    if (n < m) return false;
+    return _stringMismatchIgnoreCase(p, word, m) == m;
+}
+
+// Parses [+-](digits[.digits] | .digits)[(e|E)[+-]digits], "inf", "infinity"
+// or "nan" (case-insensitive) from the start of `s`. At most 19 significant
+// digits are kept; when more follow, the result is confirmed by also rounding
+// the next larger 19-digit value and only falls back to the slow path if the
+// two disagree.
+EErrorCode _stringParseDoublePrefix(TStringView s, double *value, size_t *consumed) {
+    const char *p = s.data;
+    const size_t n = s.size;
+    size_t i = 0;
+    bool negative = false;
+    *value = 0;
+    *consumed = 0;
+    if (i < n && (p[i] == '+' || p[i] == '-')) {
+        negative = p[i] == '-';
+        ++i;
+    }
+    const uint64_t sign = negative ? 1ULL << 63 : 0;
+    if (i < n && (p[i] | 0x20) == 'i' && _stringMatchWordIgnoreCase(p + i, n - i, "inf")) {
+        i += _stringMatchWordIgnoreCase(p + i, n - i, "infinity") ? 8 : 3;
+        *value = _stringDoubleFromBits(sign | 0x7FF0000000000000ULL);
+        *consumed = i;
+        return ERR_NO_ERROR;
+    }
+    if (i < n && (p[i] | 0x20) == 'n' && _stringMatchWordIgnoreCase(p + i, n - i, "nan")) {
+        *value = _stringDoubleFromBits(sign | 0x7FF8000000000000ULL);
+        *consumed = i + 3;
+        return ERR_NO_ERROR;
+    }
+
+    const size_t start = i;
+    uint64_t w = 0;
+    size_t digits = 0;
+    int64_t exp10 = 0;
+    bool truncated = false;
+    bool any = false;
+    while (i < n && p[i] == '0') {
+        ++i;
+        any = true;
+    }
+    // eight integer digits at a time while they fit into the 19 kept
+    while (n - i >= 8 && digits <= 11) {
+        uint64_t x = _stringLoad64Le(p + i);
+        if (!_stringIsEightDigits(x)) break;
+        w = w * 100000000ULL + _stringEightDigits(x);
+        digits += 8;
+        i += 8;
+        any = true;
+    }
+    for (; i < n && stringCharIsDigit(p[i]); ++i) {
+        any = true;
+        if (w == 0 && p[i] == '0') continue;
+        if (digits < 19) {
+            w = w * 10 + (uint64_t)(p[i] - '0');
+            ++digits;
+        } else {
+            ++exp10;
+            truncated = true;
+        }
+    }
+    size_t fractionDigits = 0;
+    if (i < n && p[i] == '.') {
+        ++i;
+        const size_t fraction = i;
+        while (n - i >= 8 && digits != 0 && digits <= 11) {
+            uint64_t x = _stringLoad64Le(p + i);
+            if (!_stringIsEightDigits(x)) break;
+            w = w * 100000000ULL + _stringEightDigits(x);
+            digits += 8;
+            exp10 -= 8;
+            i += 8;
+        }
+        for (; i < n && stringCharIsDigit(p[i]); ++i) {
+            if (w == 0 && p[i] == '0') {
+                --exp10;
+            } else if (digits < 19) {
+                w = w * 10 + (uint64_t)(p[i] - '0');
+                ++digits;
+                --exp10;
+            } else {
+                truncated = true;
+            }
+        }
+        fractionDigits = i - fraction;
+        any = any || fractionDigits > 0;
+    }
+    if (!any) return ERR_INVALID_NUMBER_REPR;
+    const size_t mantissaEnd = i;
+
+    int64_t exponent = 0;
+    if (i < n && (p[i] | 0x20) == 'e') {
+        size_t j = i + 1;
+        bool expNegative = false;
+        if (j < n && (p[j] == '+' || p[j] == '-')) {
+            expNegative = p[j] == '-';
+            ++j;
+        }
+        if (j < n && stringCharIsDigit(p[j])) {
+            for (; j < n && stringCharIsDigit(p[j]); ++j) {
+                // anything this large is already zero or infinity
+                if (exponent < 100000) exponent = exponent * 10 + (p[j] - '0');
+            }
+            if (expNegative) exponent = -exponent;
+            i = j;
+        }
+    }
+    *consumed = i;
+
+    const int64_t q = exp10 + exponent;
+    uint64_t bits = 0;
+    if (w == 0) {
+        bits = 0;
+    } else if (!truncated && q >= -22 && q <= 22 && w <= (1ULL << 53)) {
+        // both operands are exact, so one correctly rounded operation suffices
+        double d = (double)w;
+        d = q < 0 ? d / POW10_EXACT[-q] : d * POW10_EXACT[q];
+        *value = negative ? -d : d;
+        return ERR_NO_ERROR;
+    } else {
+        uint64_t upper = 0;
+        bool exact = _stringEiselLemire(w, q, &bits);
+        if (exact && truncated) exact = _stringEiselLemire(w + 1, q, &upper) && upper == bits;
+        if (!exact) {
+            double d = _stringParseDoubleSlow(p + start, mantissaEnd - start, exponent - (int64_t)fractionDigits);
+            memcpy(&bits, &d, sizeof(bits));
+        }
+    }
+    *value = _stringDoubleFromBits(sign | bits);
+    if (bits == 0x7FF0000000000000ULL) return ERR_NUMBER_OVERFLOW;
+    return ERR_NO_ERROR;
+}
+
+EErrorCode _stringParseDouble(TStringView s, double *value) {
+    size_t used = 0;
+    EErrorCode e = _stringParseDoublePrefix(s, value, &used);
+    if (e == ERR_NO_ERROR && used != s.size) {
+        *value = 0;
+        return ERR_INVALID_NUMBER_REPR;
+    }
+    return e;
+}
+
+// Parses the longest floating-point prefix of `s`, correctly rounded.
+// `consumed` receives the bytes used, 0 if there is no number. Finite input
+// too large for a double gives +-infinity and ERR_NUMBER_OVERFLOW.
+double stringViewParseDouble(TStringView s, size_t *consumed) {
+    double value = 0;
+    size_t used = 0;
+    _stringReportParse(_stringParseDoublePrefix(s, &value, &used));
+    if (consumed != NULL) *consumed = used;
+    return value;
+}
+
+double stringViewToDouble(TStringView s) {
+    double value = 0;
+    _stringReportParse(_stringParseDouble(s, &value));
+    return value;
+}
+
+// 128-bit upper approximations g of 10^k for k in [-292, 324], high word
+// first: g = ceil(10^k / 2^r) with r chosen so that 2^127 <= g < 2^128.
+// Used by the Schubfach shortest-decimal conversion.
+#define POW10_128_MIN_EXP -292
+#define POW10_128_MAX_EXP 324
+
+static const uint64_t POW10_128[] = {
+    0xff77b1fcbebcdc4fULL, 0x25e8e89c13bb0f7bULL,
+    0x9faacf3df73609b1ULL, 0x77b191618c54e9adULL,
+    0xc795830d75038c1dULL, 0xd59df5b9ef6a2418ULL,
+    0xf97ae3d0d2446f25ULL, 0x4b0573286b44ad1eULL,
+    0x9becce62836ac577ULL, 0x4ee367f9430aec33ULL,
+    0xc2e801fb244576d5ULL, 0x229c41f793cda740ULL,
+    0xf3a20279ed56d48aULL, 0x6b43527578c11110ULL,
+    0x9845418c345644d6ULL, 0x830a13896b78aaaaULL,
+    0xbe5691ef416bd60cULL, 0x23cc986bc656d554ULL,
+    0xedec366b11c6cb8fULL, 0x2cbfbe86b7ec8aa9ULL,
+    0x94b3a202eb1c3f39ULL, 0x7bf7d71432f3d6aaULL,
+    0xb9e08a83a5e34f07ULL, 0xdaf5ccd93fb0cc54ULL,
+    0xe858ad248f5c22c9ULL, 0xd1b3400f8f9cff69ULL,
+    0x91376c36d99995beULL, 0x23100809b9c21fa2ULL,
+    0xb58547448ffffb2dULL, 0xabd40a0c2832a78bULL,
+    0xe2e69915b3fff9f9ULL, 0x16c90c8f323f516dULL,
+    0x8dd01fad907ffc3bULL, 0xae3da7d97f6792e4ULL,
+    0xb1442798f49ffb4aULL, 0x99cd11cfdf41779dULL,
+    0xdd95317f31c7fa1dULL, 0x40405643d711d584ULL,
+    0x8a7d3eef7f1cfc52ULL, 0x482835ea666b2573ULL,
+    0xad1c8eab5ee43b66ULL, 0xda3243650005eed0ULL,
+    0xd863b256369d4a40ULL, 0x90bed43e40076a83ULL,
+    0x873e4f75e2224e68ULL, 0x5a7744a6e804a292ULL,
+    0xa90de3535aaae202ULL, 0x711515d0a205cb37ULL,
+    0xd3515c2831559a83ULL, 0x0d5a5b44ca873e04ULL,
+    0x8412d9991ed58091ULL, 0xe858790afe9486c3ULL,
+    0xa5178fff668ae0b6ULL, 0x626e974dbe39a873ULL,
+    0xce5d73ff402d98e3ULL, 0xfb0a3d212dc81290ULL,
+    0x80fa687f881c7f8eULL, 0x7ce66634bc9d0b9aULL,
+    0xa139029f6a239f72ULL, 0x1c1fffc1ebc44e81ULL,
+    0xc987434744ac874eULL, 0xa327ffb266b56221ULL,
+    0xfbe9141915d7a922ULL, 0x4bf1ff9f0062baa9ULL,
+    0x9d71ac8fada6c9b5ULL, 0x6f773fc3603db4aaULL,
+    0xc4ce17b399107c22ULL, 0xcb550fb4384d21d4ULL,
+    0xf6019da07f549b2bULL, 0x7e2a53a146606a49ULL,
+    0x99c102844f94e0fbULL, 0x2eda7444cbfc426eULL,
+    0xc0314325637a1939ULL, 0xfa911155fefb5309ULL,
+    0xf03d93eebc589f88ULL, 0x793555ab7eba27cbULL,
+    0x96267c7535b763b5ULL, 0x4bc1558b2f3458dfULL,
+    0xbbb01b9283253ca2ULL, 0x9eb1aaedfb016f17ULL,
+    0xea9c227723ee8bcbULL, 0x465e15a979c1caddULL,
+    0x92a1958a7675175fULL, 0x0bfacd89ec191ecaULL,
+    0xb749faed14125d36ULL, 0xcef980ec671f667cULL,
+    0xe51c79a85916f484ULL, 0x82b7e12780e7401bULL,
+    0x8f31cc0937ae58d2ULL, 0xd1b2ecb8b0908811ULL,
+    0xb2fe3f0b8599ef07ULL, 0x861fa7e6dcb4aa16ULL,
+    0xdfbdcece67006ac9ULL, 0x67a791e093e1d49bULL,
+    0x8bd6a141006042bdULL, 0xe0c8bb2c5c6d24e1ULL,
+    0xaecc49914078536dULL, 0x58fae9f773886e19ULL,
+    0xda7f5bf590966848ULL, 0xaf39a475506a899fULL,
+    0x888f99797a5e012dULL, 0x6d8406c952429604ULL,
+    0xaab37fd7d8f58178ULL, 0xc8e5087ba6d33b84ULL,
+    0xd5605fcdcf32e1d6ULL, 0xfb1e4a9a90880a65ULL,
+    0x855c3be0a17fcd26ULL, 0x5cf2eea09a550680ULL,
+    0xa6b34ad8c9dfc06fULL, 0xf42faa48c0ea481fULL,
+    0xd0601d8efc57b08bULL, 0xf13b94daf124da27ULL,
+    0x823c12795db6ce57ULL, 0x76c53d08d6b70859ULL,
+    0xa2cb1717b52481edULL, 0x54768c4b0c64ca6fULL,
+    0xcb7ddcdda26da268ULL, 0xa9942f5dcf7dfd0aULL,
+    0xfe5d54150b090b02ULL, 0xd3f93b35435d7c4dULL,
+    0x9efa548d26e5a6e1ULL, 0xc47bc5014a1a6db0ULL,
+    0xc6b8e9b0709f109aULL, 0x359ab6419ca1091cULL,
+    0xf867241c8cc6d4c0ULL, 0xc30163d203c94b63ULL,
+    0x9b407691d7fc44f8ULL, 0x79e0de63425dcf1eULL,
+    0xc21094364dfb5636ULL, 0x985915fc12f542e5ULL,
+    0xf294b943e17a2bc4ULL, 0x3e6f5b7b17b2939eULL,
+    0x979cf3ca6cec5b5aULL, 0xa705992ceecf9c43ULL,
+    0xbd8430bd08277231ULL, 0x50c6ff782a838354ULL,
+    0xece53cec4a314ebdULL, 0xa4f8bf5635246429ULL,
+    0x940f4613ae5ed136ULL, 0x871b7795e136be9aULL,
+    0xb913179899f68584ULL, 0x28e2557b59846e40ULL,
+    0xe757dd7ec07426e5ULL, 0x331aeada2fe589d0ULL,
+    0x9096ea6f3848984fULL, 0x3ff0d2c85def7622ULL,
+    0xb4bca50b065abe63ULL, 0x0fed077a756b53aaULL,
+    0xe1ebce4dc7f16dfbULL, 0xd3e8495912c62895ULL,
+    0x8d3360f09cf6e4bdULL, 0x64712dd7abbbd95dULL,
+    0xb080392cc4349decULL, 0xbd8d794d96aacfb4ULL,
+    0xdca04777f541c567ULL, 0xecf0d7a0fc5583a1ULL,
+    0x89e42caaf9491b60ULL, 0xf41686c49db57245ULL,
+    0xac5d37d5b79b6239ULL, 0x311c2875c522ced6ULL,
+    0xd77485cb25823ac7ULL, 0x7d633293366b828cULL,
+    0x86a8d39ef77164bcULL, 0xae5dff9c02033198ULL,
+    0xa8530886b54dbdebULL, 0xd9f57f830283fdfdULL,
+    0xd267caa862a12d66ULL, 0xd072df63c324fd7cULL,
+    0x8380dea93da4bc60ULL, 0x4247cb9e59f71e6eULL,
+    0xa46116538d0deb78ULL, 0x52d9be85f074e609ULL,
+    0xcd795be870516656ULL, 0x67902e276c921f8cULL,
+    0x806bd9714632dff6ULL, 0x00ba1cd8a3db53b7ULL,
+    0xa086cfcd97bf97f3ULL, 0x80e8a40eccd228a5ULL,
+    0xc8a883c0fdaf7df0ULL, 0x6122cd128006b2ceULL,
+    0xfad2a4b13d1b5d6cULL, 0x796b805720085f82ULL,
+    0x9cc3a6eec6311a63ULL, 0xcbe3303674053bb1ULL,
+    0xc3f490aa77bd60fcULL, 0xbedbfc4411068a9dULL,
+    0xf4f1b4d515acb93bULL, 0xee92fb5515482d45ULL,
+    0x991711052d8bf3c5ULL, 0x751bdd152d4d1c4bULL,
+    0xbf5cd54678eef0b6ULL, 0xd262d45a78a0635eULL,
+    0xef340a98172aace4ULL, 0x86fb897116c87c35ULL,
+    0x9580869f0e7aac0eULL, 0xd45d35e6ae3d4da1ULL,
+    0xbae0a846d2195712ULL, 0x8974836059cca10aULL,
+    0xe998d258869facd7ULL, 0x2bd1a438703fc94cULL,
+    0x91ff83775423cc06ULL, 0x7b6306a34627ddd0ULL,
+    0xb67f6455292cbf08ULL, 0x1a3bc84c17b1d543ULL,
+    0xe41f3d6a7377eecaULL, 0x20caba5f1d9e4a94ULL,
+    0x8e938662882af53eULL, 0x547eb47b7282ee9dULL,
+    0xb23867fb2a35b28dULL, 0xe99e619a4f23aa44ULL,
+    0xdec681f9f4c31f31ULL, 0x6405fa00e2ec94d5ULL,
+    0x8b3c113c38f9f37eULL, 0xde83bc408dd3dd05ULL,
+    0xae0b158b4738705eULL, 0x9624ab50b148d446ULL,
+    0xd98ddaee19068c76ULL, 0x3badd624dd9b0958ULL,
+    0x87f8a8d4cfa417c9ULL, 0xe54ca5d70a80e5d7ULL,
+    0xa9f6d30a038d1dbcULL, 0x5e9fcf4ccd211f4dULL,
+    0xd47487cc8470652bULL, 0x7647c32000696720ULL,
+    0x84c8d4dfd2c63f3bULL, 0x29ecd9f40041e074ULL,
+    0xa5fb0a17c777cf09ULL, 0xf468107100525891ULL,
+    0xcf79cc9db955c2ccULL, 0x7182148d4066eeb5ULL,
+    0x81ac1fe293d599bfULL, 0xc6f14cd848405531ULL,
+    0xa21727db38cb002fULL, 0xb8ada00e5a506a7dULL,
+    0xca9cf1d206fdc03bULL, 0xa6d90811f0e4851dULL,
+    0xfd442e4688bd304aULL, 0x908f4a166d1da664ULL,
+    0x9e4a9cec15763e2eULL, 0x9a598e4e043287ffULL,
+    0xc5dd44271ad3cdbaULL, 0x40eff1e1853f29feULL,
+    0xf7549530e188c128ULL, 0xd12bee59e68ef47dULL,
+    0x9a94dd3e8cf578b9ULL, 0x82bb74f8301958cfULL,
+    0xc13a148e3032d6e7ULL, 0xe36a52363c1faf02ULL,
+    0xf18899b1bc3f8ca1ULL, 0xdc44e6c3cb279ac2ULL,
+    0x96f5600f15a7b7e5ULL, 0x29ab103a5ef8c0baULL,
+    0xbcb2b812db11a5deULL, 0x7415d448f6b6f0e8ULL,
+    0xebdf661791d60f56ULL, 0x111b495b3464ad22ULL,
+    0x936b9fcebb25c995ULL, 0xcab10dd900beec35ULL,
+    0xb84687c269ef3bfbULL, 0x3d5d514f40eea743ULL,
+    0xe65829b3046b0afaULL, 0x0cb4a5a3112a5113ULL,
+    0x8ff71a0fe2c2e6dcULL, 0x47f0e785eaba72acULL,
+    0xb3f4e093db73a093ULL, 0x59ed216765690f57ULL,
+    0xe0f218b8d25088b8ULL, 0x306869c13ec3532dULL,
+    0x8c974f7383725573ULL, 0x1e414218c73a13fcULL,
+    0xafbd2350644eeacfULL, 0xe5d1929ef90898fbULL,
+    0xdbac6c247d62a583ULL, 0xdf45f746b74abf3aULL,
+    0x894bc396ce5da772ULL, 0x6b8bba8c328eb784ULL,
+    0xab9eb47c81f5114fULL, 0x066ea92f3f326565ULL,
+    0xd686619ba27255a2ULL, 0xc80a537b0efefebeULL,
+    0x8613fd0145877585ULL, 0xbd06742ce95f5f37ULL,
+    0xa798fc4196e952e7ULL, 0x2c48113823b73705ULL,
+    0xd17f3b51fca3a7a0ULL, 0xf75a15862ca504c6ULL,
+    0x82ef85133de648c4ULL, 0x9a984d73dbe722fcULL,
+    0xa3ab66580d5fdaf5ULL, 0xc13e60d0d2e0ebbbULL,
+    0xcc963fee10b7d1b3ULL, 0x318df905079926a9ULL,
+    0xffbbcfe994e5c61fULL, 0xfdf17746497f7053ULL,
+    0x9fd561f1fd0f9bd3ULL, 0xfeb6ea8bedefa634ULL,
+    0xc7caba6e7c5382c8ULL, 0xfe64a52ee96b8fc1ULL,
+    0xf9bd690a1b68637bULL, 0x3dfdce7aa3c673b1ULL,
+    0x9c1661a651213e2dULL, 0x06bea10ca65c084fULL,
+    0xc31bfa0fe5698db8ULL, 0x486e494fcff30a63ULL,
+    0xf3e2f893dec3f126ULL, 0x5a89dba3c3efccfbULL,
+    0x986ddb5c6b3a76b7ULL, 0xf89629465a75e01dULL,
+    0xbe89523386091465ULL, 0xf6bbb397f1135824ULL,
+    0xee2ba6c0678b597fULL, 0x746aa07ded582e2dULL,
+    0x94db483840b717efULL, 0xa8c2a44eb4571cddULL,
+    0xba121a4650e4ddebULL, 0x92f34d62616ce414ULL,
+    0xe896a0d7e51e1566ULL, 0x77b020baf9c81d18ULL,
+    0x915e2486ef32cd60ULL, 0x0ace1474dc1d122fULL,
+    0xb5b5ada8aaff80b8ULL, 0x0d819992132456bbULL,
+    0xe3231912d5bf60e6ULL, 0x10e1fff697ed6c6aULL,
+    0x8df5efabc5979c8fULL, 0xca8d3ffa1ef463c2ULL,
+    0xb1736b96b6fd83b3ULL, 0xbd308ff8a6b17cb3ULL,
+    0xddd0467c64bce4a0ULL, 0xac7cb3f6d05ddbdfULL,
+    0x8aa22c0dbef60ee4ULL, 0x6bcdf07a423aa96cULL,
+    0xad4ab7112eb3929dULL, 0x86c16c98d2c953c7ULL,
+    0xd89d64d57a607744ULL, 0xe871c7bf077ba8b8ULL,
+    0x87625f056c7c4a8bULL, 0x11471cd764ad4973ULL,
+    0xa93af6c6c79b5d2dULL, 0xd598e40d3dd89bd0ULL,
+    0xd389b47879823479ULL, 0x4aff1d108d4ec2c4ULL,
+    0x843610cb4bf160cbULL, 0xcedf722a585139bbULL,
+    0xa54394fe1eedb8feULL, 0xc2974eb4ee658829ULL,
+    0xce947a3da6a9273eULL, 0x733d226229feea33ULL,
+    0x811ccc668829b887ULL, 0x0806357d5a3f5260ULL,
+    0xa163ff802a3426a8ULL, 0xca07c2dcb0cf26f8ULL,
+    0xc9bcff6034c13052ULL, 0xfc89b393dd02f0b6ULL,
+    0xfc2c3f3841f17c67ULL, 0xbbac2078d443ace3ULL,
+    0x9d9ba7832936edc0ULL, 0xd54b944b84aa4c0eULL,
+    0xc5029163f384a931ULL, 0x0a9e795e65d4df12ULL,
+    0xf64335bcf065d37dULL, 0x4d4617b5ff4a16d6ULL,
+    0x99ea0196163fa42eULL, 0x504bced1bf8e4e46ULL,
+    0xc06481fb9bcf8d39ULL, 0xe45ec2862f71e1d7ULL,
+    0xf07da27a82c37088ULL, 0x5d767327bb4e5a4dULL,
+    0x964e858c91ba2655ULL, 0x3a6a07f8d510f870ULL,
+    0xbbe226efb628afeaULL, 0x890489f70a55368cULL,
+    0xeadab0aba3b2dbe5ULL, 0x2b45ac74ccea842fULL,
+    0x92c8ae6b464fc96fULL, 0x3b0b8bc90012929eULL,
+    0xb77ada0617e3bbcbULL, 0x09ce6ebb40173745ULL,
+    0xe55990879ddcaabdULL, 0xcc420a6a101d0516ULL,
+    0x8f57fa54c2a9eab6ULL, 0x9fa946824a12232eULL,
+    0xb32df8e9f3546564ULL, 0x47939822dc96abfaULL,
+    0xdff9772470297ebdULL, 0x59787e2b93bc56f8ULL,
+    0x8bfbea76c619ef36ULL, 0x57eb4edb3c55b65bULL,
+    0xaefae51477a06b03ULL, 0xede622920b6b23f2ULL,
+    0xdab99e59958885c4ULL, 0xe95fab368e45eceeULL,
+    0x88b402f7fd75539bULL, 0x11dbcb0218ebb415ULL,
+    0xaae103b5fcd2a881ULL, 0xd652bdc29f26a11aULL,
+    0xd59944a37c0752a2ULL, 0x4be76d3346f04960ULL,
+    0x857fcae62d8493a5ULL, 0x6f70a4400c562ddcULL,
+    0xa6dfbd9fb8e5b88eULL, 0xcb4ccd500f6bb953ULL,
+    0xd097ad07a71f26b2ULL, 0x7e2000a41346a7a8ULL,
+    0x825ecc24c873782fULL, 0x8ed400668c0c28c9ULL,
+    0xa2f67f2dfa90563bULL, 0x728900802f0f32fbULL,
+    0xcbb41ef979346bcaULL, 0x4f2b40a03ad2ffbaULL,
+    0xfea126b7d78186bcULL, 0xe2f610c84987bfa9ULL,
+    0x9f24b832e6b0f436ULL, 0x0dd9ca7d2df4d7caULL,
+    0xc6ede63fa05d3143ULL, 0x91503d1c79720dbcULL,
+    0xf8a95fcf88747d94ULL, 0x75a44c6397ce912bULL,
+    0x9b69dbe1b548ce7cULL, 0xc986afbe3ee11abbULL,
+    0xc24452da229b021bULL, 0xfbe85badce996169ULL,
+    0xf2d56790ab41c2a2ULL, 0xfae27299423fb9c4ULL,
+    0x97c560ba6b0919a5ULL, 0xdccd879fc967d41bULL,
+    0xbdb6b8e905cb600fULL, 0x5400e987bbc1c921ULL,
+    0xed246723473e3813ULL, 0x290123e9aab23b69ULL,
+    0x9436c0760c86e30bULL, 0xf9a0b6720aaf6522ULL,
+    0xb94470938fa89bceULL, 0xf808e40e8d5b3e6aULL,
+    0xe7958cb87392c2c2ULL, 0xb60b1d1230b20e05ULL,
+    0x90bd77f3483bb9b9ULL, 0xb1c6f22b5e6f48c3ULL,
+    0xb4ecd5f01a4aa828ULL, 0x1e38aeb6360b1af4ULL,
+    0xe2280b6c20dd5232ULL, 0x25c6da63c38de1b1ULL,
+    0x8d590723948a535fULL, 0x579c487e5a38ad0fULL,
+    0xb0af48ec79ace837ULL, 0x2d835a9df0c6d852ULL,
+    0xdcdb1b2798182244ULL, 0xf8e431456cf88e66ULL,
+    0x8a08f0f8bf0f156bULL, 0x1b8e9ecb641b5900ULL,
+    0xac8b2d36eed2dac5ULL, 0xe272467e3d222f40ULL,
+    0xd7adf884aa879177ULL, 0x5b0ed81dcc6abb10ULL,
+    0x86ccbb52ea94baeaULL, 0x98e947129fc2b4eaULL,
+    0xa87fea27a539e9a5ULL, 0x3f2398d747b36225ULL,
+    0xd29fe4b18e88640eULL, 0x8eec7f0d19a03aaeULL,
+    0x83a3eeeef9153e89ULL, 0x1953cf68300424adULL,
+    0xa48ceaaab75a8e2bULL, 0x5fa8c3423c052dd8ULL,
+    0xcdb02555653131b6ULL, 0x3792f412cb06794eULL,
+    0x808e17555f3ebf11ULL, 0xe2bbd88bbee40bd1ULL,
+    0xa0b19d2ab70e6ed6ULL, 0x5b6aceaeae9d0ec5ULL,
+    0xc8de047564d20a8bULL, 0xf245825a5a445276ULL,
+    0xfb158592be068d2eULL, 0xeed6e2f0f0d56713ULL,
+    0x9ced737bb6c4183dULL, 0x55464dd69685606cULL,
+    0xc428d05aa4751e4cULL, 0xaa97e14c3c26b887ULL,
+    0xf53304714d9265dfULL, 0xd53dd99f4b3066a9ULL,
+    0x993fe2c6d07b7fabULL, 0xe546a8038efe402aULL,
+    0xbf8fdb78849a5f96ULL, 0xde98520472bdd034ULL,
+    0xef73d256a5c0f77cULL, 0x963e66858f6d4441ULL,
+    0x95a8637627989aadULL, 0xdde7001379a44aa9ULL,
+    0xbb127c53b17ec159ULL, 0x5560c018580d5d53ULL,
+    0xe9d71b689dde71afULL, 0xaab8f01e6e10b4a7ULL,
+    0x9226712162ab070dULL, 0xcab3961304ca70e9ULL,
+    0xb6b00d69bb55c8d1ULL, 0x3d607b97c5fd0d23ULL,
+    0xe45c10c42a2b3b05ULL, 0x8cb89a7db77c506bULL,
+    0x8eb98a7a9a5b04e3ULL, 0x77f3608e92adb243ULL,
+    0xb267ed1940f1c61cULL, 0x55f038b237591ed4ULL,
+    0xdf01e85f912e37a3ULL, 0x6b6c46dec52f6689ULL,
+    0x8b61313bbabce2c6ULL, 0x2323ac4b3b3da016ULL,
+    0xae397d8aa96c1b77ULL, 0xabec975e0a0d081bULL,
+    0xd9c7dced53c72255ULL, 0x96e7bd358c904a22ULL,
+    0x881cea14545c7575ULL, 0x7e50d64177da2e55ULL,
+    0xaa242499697392d2ULL, 0xdde50bd1d5d0b9eaULL,
+    0xd4ad2dbfc3d07787ULL, 0x955e4ec64b44e865ULL,
+    0x84ec3c97da624ab4ULL, 0xbd5af13bef0b113fULL,
+    0xa6274bbdd0fadd61ULL, 0xecb1ad8aeacdd58fULL,
+    0xcfb11ead453994baULL, 0x67de18eda5814af3ULL,
+    0x81ceb32c4b43fcf4ULL, 0x80eacf948770ced8ULL,
+    0xa2425ff75e14fc31ULL, 0xa1258379a94d028eULL,
+    0xcad2f7f5359a3b3eULL, 0x096ee45813a04331ULL,
+    0xfd87b5f28300ca0dULL, 0x8bca9d6e188853fdULL,
+    0x9e74d1b791e07e48ULL, 0x775ea264cf55347eULL,
+    0xc612062576589ddaULL, 0x95364afe032a819eULL,
+    0xf79687aed3eec551ULL, 0x3a83ddbd83f52205ULL,
+    0x9abe14cd44753b52ULL, 0xc4926a9672793543ULL,
+    0xc16d9a0095928a27ULL, 0x75b7053c0f178294ULL,
+    0xf1c90080baf72cb1ULL, 0x5324c68b12dd6339ULL,
+    0x971da05074da7beeULL, 0xd3f6fc16ebca5e04ULL,
+    0xbce5086492111aeaULL, 0x88f4bb1ca6bcf585ULL,
+    0xec1e4a7db69561a5ULL, 0x2b31e9e3d06c32e6ULL,
+    0x9392ee8e921d5d07ULL, 0x3aff322e62439fd0ULL,
+    0xb877aa3236a4b449ULL, 0x09befeb9fad487c3ULL,
+    0xe69594bec44de15bULL, 0x4c2ebe687989a9b4ULL,
+    0x901d7cf73ab0acd9ULL, 0x0f9d37014bf60a11ULL,
+    0xb424dc35095cd80fULL, 0x538484c19ef38c95ULL,
+    0xe12e13424bb40e13ULL, 0x2865a5f206b06fbaULL,
+    0x8cbccc096f5088cbULL, 0xf93f87b7442e45d4ULL,
+    0xafebff0bcb24aafeULL, 0xf78f69a51539d749ULL,
+    0xdbe6fecebdedd5beULL, 0xb573440e5a884d1cULL,
+    0x89705f4136b4a597ULL, 0x31680a88f8953031ULL,
+    0xabcc77118461cefcULL, 0xfdc20d2b36ba7c3eULL,
+    0xd6bf94d5e57a42bcULL, 0x3d32907604691b4dULL,
+    0x8637bd05af6c69b5ULL, 0xa63f9a49c2c1b110ULL,
+    0xa7c5ac471b478423ULL, 0x0fcf80dc33721d54ULL,
+    0xd1b71758e219652bULL, 0xd3c36113404ea4a9ULL,
+    0x83126e978d4fdf3bULL, 0x645a1cac083126eaULL,
+    0xa3d70a3d70a3d70aULL, 0x3d70a3d70a3d70a4ULL,
+    0xccccccccccccccccULL, 0xcccccccccccccccdULL,
+    0x8000000000000000ULL, 0x0000000000000000ULL,
+    0xa000000000000000ULL, 0x0000000000000000ULL,
+    0xc800000000000000ULL, 0x0000000000000000ULL,
+    0xfa00000000000000ULL, 0x0000000000000000ULL,
+    0x9c40000000000000ULL, 0x0000000000000000ULL,
+    0xc350000000000000ULL, 0x0000000000000000ULL,
+    0xf424000000000000ULL, 0x0000000000000000ULL,
+    0x9896800000000000ULL, 0x0000000000000000ULL,
+    0xbebc200000000000ULL, 0x0000000000000000ULL,
+    0xee6b280000000000ULL, 0x0000000000000000ULL,
+    0x9502f90000000000ULL, 0x0000000000000000ULL,
+    0xba43b74000000000ULL, 0x0000000000000000ULL,
+    0xe8d4a51000000000ULL, 0x0000000000000000ULL,
+    0x9184e72a00000000ULL, 0x0000000000000000ULL,
+    0xb5e620f480000000ULL, 0x0000000000000000ULL,
+    0xe35fa931a0000000ULL, 0x0000000000000000ULL,
+    0x8e1bc9bf04000000ULL, 0x0000000000000000ULL,
+    0xb1a2bc2ec5000000ULL, 0x0000000000000000ULL,
+    0xde0b6b3a76400000ULL, 0x0000000000000000ULL,
+    0x8ac7230489e80000ULL, 0x0000000000000000ULL,
+    0xad78ebc5ac620000ULL, 0x0000000000000000ULL,
+    0xd8d726b7177a8000ULL, 0x0000000000000000ULL,
+    0x878678326eac9000ULL, 0x0000000000000000ULL,
+    0xa968163f0a57b400ULL, 0x0000000000000000ULL,
+    0xd3c21bcecceda100ULL, 0x0000000000000000ULL,
+    0x84595161401484a0ULL, 0x0000000000000000ULL,
+    0xa56fa5b99019a5c8ULL, 0x0000000000000000ULL,
+    0xcecb8f27f4200f3aULL, 0x0000000000000000ULL,
+    0x813f3978f8940984ULL, 0x4000000000000000ULL,
+    0xa18f07d736b90be5ULL, 0x5000000000000000ULL,
+    0xc9f2c9cd04674edeULL, 0xa400000000000000ULL,
+    0xfc6f7c4045812296ULL, 0x4d00000000000000ULL,
+    0x9dc5ada82b70b59dULL, 0xf020000000000000ULL,
+    0xc5371912364ce305ULL, 0x6c28000000000000ULL,
+    0xf684df56c3e01bc6ULL, 0xc732000000000000ULL,
+    0x9a130b963a6c115cULL, 0x3c7f400000000000ULL,
+    0xc097ce7bc90715b3ULL, 0x4b9f100000000000ULL,
+    0xf0bdc21abb48db20ULL, 0x1e86d40000000000ULL,
+    0x96769950b50d88f4ULL, 0x1314448000000000ULL,
+    0xbc143fa4e250eb31ULL, 0x17d955a000000000ULL,
+    0xeb194f8e1ae525fdULL, 0x5dcfab0800000000ULL,
+    0x92efd1b8d0cf37beULL, 0x5aa1cae500000000ULL,
+    0xb7abc627050305adULL, 0xf14a3d9e40000000ULL,
+    0xe596b7b0c643c719ULL, 0x6d9ccd05d0000000ULL,
+    0x8f7e32ce7bea5c6fULL, 0xe4820023a2000000ULL,
+    0xb35dbf821ae4f38bULL, 0xdda2802c8a800000ULL,
+    0xe0352f62a19e306eULL, 0xd50b2037ad200000ULL,
+    0x8c213d9da502de45ULL, 0x4526f422cc340000ULL,
+    0xaf298d050e4395d6ULL, 0x9670b12b7f410000ULL,
+    0xdaf3f04651d47b4cULL, 0x3c0cdd765f114000ULL,
+    0x88d8762bf324cd0fULL, 0xa5880a69fb6ac800ULL,
+    0xab0e93b6efee0053ULL, 0x8eea0d047a457a00ULL,
+    0xd5d238a4abe98068ULL, 0x72a4904598d6d880ULL,
+    0x85a36366eb71f041ULL, 0x47a6da2b7f864750ULL,
+    0xa70c3c40a64e6c51ULL, 0x999090b65f67d924ULL,
+    0xd0cf4b50cfe20765ULL, 0xfff4b4e3f741cf6dULL,
+    0x82818f1281ed449fULL, 0xbff8f10e7a8921a5ULL,
+    0xa321f2d7226895c7ULL, 0xaff72d52192b6a0eULL,
+    0xcbea6f8ceb02bb39ULL, 0x9bf4f8a69f764491ULL,
+    0xfee50b7025c36a08ULL, 0x02f236d04753d5b5ULL,
+    0x9f4f2726179a2245ULL, 0x01d762422c946591ULL,
+    0xc722f0ef9d80aad6ULL, 0x424d3ad2b7b97ef6ULL,
+    0xf8ebad2b84e0d58bULL, 0xd2e0898765a7deb3ULL,
+    0x9b934c3b330c8577ULL, 0x63cc55f49f88eb30ULL,
+    0xc2781f49ffcfa6d5ULL, 0x3cbf6b71c76b25fcULL,
+    0xf316271c7fc3908aULL, 0x8bef464e3945ef7bULL,
+    0x97edd871cfda3a56ULL, 0x97758bf0e3cbb5adULL,
+    0xbde94e8e43d0c8ecULL, 0x3d52eeed1cbea318ULL,
+    0xed63a231d4c4fb27ULL, 0x4ca7aaa863ee4bdeULL,
+    0x945e455f24fb1cf8ULL, 0x8fe8caa93e74ef6bULL,
+    0xb975d6b6ee39e436ULL, 0xb3e2fd538e122b45ULL,
+    0xe7d34c64a9c85d44ULL, 0x60dbbca87196b617ULL,
+    0x90e40fbeea1d3a4aULL, 0xbc8955e946fe31ceULL,
+    0xb51d13aea4a488ddULL, 0x6babab6398bdbe42ULL,
+    0xe264589a4dcdab14ULL, 0xc696963c7eed2dd2ULL,
+    0x8d7eb76070a08aecULL, 0xfc1e1de5cf543ca3ULL,
+    0xb0de65388cc8ada8ULL, 0x3b25a55f43294bccULL,
+    0xdd15fe86affad912ULL, 0x49ef0eb713f39ebfULL,
+    0x8a2dbf142dfcc7abULL, 0x6e3569326c784338ULL,
+    0xacb92ed9397bf996ULL, 0x49c2c37f07965405ULL,
+    0xd7e77a8f87daf7fbULL, 0xdc33745ec97be907ULL,
+    0x86f0ac99b4e8dafdULL, 0x69a028bb3ded71a4ULL,
+    0xa8acd7c0222311bcULL, 0xc40832ea0d68ce0dULL,
+    0xd2d80db02aabd62bULL, 0xf50a3fa490c30191ULL,
+    0x83c7088e1aab65dbULL, 0x792667c6da79e0fbULL,
+    0xa4b8cab1a1563f52ULL, 0x577001b891185939ULL,
+    0xcde6fd5e09abcf26ULL, 0xed4c0226b55e6f87ULL,
+    0x80b05e5ac60b6178ULL, 0x544f8158315b05b5ULL,
+    0xa0dc75f1778e39d6ULL, 0x696361ae3db1c722ULL,
+    0xc913936dd571c84cULL, 0x03bc3a19cd1e38eaULL,
+    0xfb5878494ace3a5fULL, 0x04ab48a04065c724ULL,
+    0x9d174b2dcec0e47bULL, 0x62eb0d64283f9c77ULL,
+    0xc45d1df942711d9aULL, 0x3ba5d0bd324f8395ULL,
+    0xf5746577930d6500ULL, 0xca8f44ec7ee3647aULL,
+    0x9968bf6abbe85f20ULL, 0x7e998b13cf4e1eccULL,
+    0xbfc2ef456ae276e8ULL, 0x9e3fedd8c321a67fULL,
+    0xefb3ab16c59b14a2ULL, 0xc5cfe94ef3ea101fULL,
+    0x95d04aee3b80ece5ULL, 0xbba1f1d158724a13ULL,
+    0xbb445da9ca61281fULL, 0x2a8a6e45ae8edc98ULL,
+    0xea1575143cf97226ULL, 0xf52d09d71a3293beULL,
+    0x924d692ca61be758ULL, 0x593c2626705f9c57ULL,
+    0xb6e0c377cfa2e12eULL, 0x6f8b2fb00c77836dULL,
+    0xe498f455c38b997aULL, 0x0b6dfb9c0f956448ULL,
+    0x8edf98b59a373fecULL, 0x4724bd4189bd5eadULL,
+    0xb2977ee300c50fe7ULL, 0x58edec91ec2cb658ULL,
+    0xdf3d5e9bc0f653e1ULL, 0x2f2967b66737e3eeULL,
+    0x8b865b215899f46cULL, 0xbd79e0d20082ee75ULL,
+    0xae67f1e9aec07187ULL, 0xecd8590680a3aa12ULL,
+    0xda01ee641a708de9ULL, 0xe80e6f4820cc9496ULL,
+    0x884134fe908658b2ULL, 0x3109058d147fdcdeULL,
+    0xaa51823e34a7eedeULL, 0xbd4b46f0599fd416ULL,
+    0xd4e5e2cdc1d1ea96ULL, 0x6c9e18ac7007c91bULL,
+    0x850fadc09923329eULL, 0x03e2cf6bc604ddb1ULL,
+    0xa6539930bf6bff45ULL, 0x84db8346b786151dULL,
+    0xcfe87f7cef46ff16ULL, 0xe612641865679a64ULL,
+    0x81f14fae158c5f6eULL, 0x4fcb7e8f3f60c07fULL,
+    0xa26da3999aef7749ULL, 0xe3be5e330f38f09eULL,
+    0xcb090c8001ab551cULL, 0x5cadf5bfd3072cc6ULL,
+    0xfdcb4fa002162a63ULL, 0x73d9732fc7c8f7f7ULL,
+    0x9e9f11c4014dda7eULL, 0x2867e7fddcdd9afbULL,
+    0xc646d63501a1511dULL, 0xb281e1fd541501b9ULL,
+    0xf7d88bc24209a565ULL, 0x1f225a7ca91a4227ULL,
+    0x9ae757596946075fULL, 0x3375788de9b06959ULL,
+    0xc1a12d2fc3978937ULL, 0x0052d6b1641c83afULL,
+    0xf209787bb47d6b84ULL, 0xc0678c5dbd23a49bULL,
+    0x9745eb4d50ce6332ULL, 0xf840b7ba963646e1ULL,
+    0xbd176620a501fbffULL, 0xb650e5a93bc3d899ULL,
+    0xec5d3fa8ce427affULL, 0xa3e51f138ab4cebfULL,
+    0x93ba47c980e98cdfULL, 0xc66f336c36b10138ULL,
+    0xb8a8d9bbe123f017ULL, 0xb80b0047445d4185ULL,
+    0xe6d3102ad96cec1dULL, 0xa60dc059157491e6ULL,
+    0x9043ea1ac7e41392ULL, 0x87c89837ad68db30ULL,
+    0xb454e4a179dd1877ULL, 0x29babe4598c311fcULL,
+    0xe16a1dc9d8545e94ULL, 0xf4296dd6fef3d67bULL,
+    0x8ce2529e2734bb1dULL, 0x1899e4a65f58660dULL,
+    0xb01ae745b101e9e4ULL, 0x5ec05dcff72e7f90ULL,
+    0xdc21a1171d42645dULL, 0x76707543f4fa1f74ULL,
+    0x899504ae72497ebaULL, 0x6a06494a791c53a9ULL,
+    0xabfa45da0edbde69ULL, 0x0487db9d17636893ULL,
+    0xd6f8d7509292d603ULL, 0x45a9d2845d3c42b7ULL,
+    0x865b86925b9bc5c2ULL, 0x0b8a2392ba45a9b3ULL,
+    0xa7f26836f282b732ULL, 0x8e6cac7768d7141fULL,
+    0xd1ef0244af2364ffULL, 0x3207d795430cd927ULL,
+    0x8335616aed761f1fULL, 0x7f44e6bd49e807b9ULL,
+    0xa402b9c5a8d3a6e7ULL, 0x5f16206c9c6209a7ULL,
+    0xcd036837130890a1ULL, 0x36dba887c37a8c10ULL,
+    0x802221226be55a64ULL, 0xc2494954da2c978aULL,
+    0xa02aa96b06deb0fdULL, 0xf2db9baa10b7bd6dULL,
+    0xc83553c5c8965d3dULL, 0x6f92829494e5acc8ULL,
+    0xfa42a8b73abbf48cULL, 0xcb772339ba1f17faULL,
+    0x9c69a97284b578d7ULL, 0xff2a760414536efcULL,
+    0xc38413cf25e2d70dULL, 0xfef5138519684abbULL,
+    0xf46518c2ef5b8cd1ULL, 0x7eb258665fc25d6aULL,
+    0x98bf2f79d5993802ULL, 0xef2f773ffbd97a62ULL,
+    0xbeeefb584aff8603ULL, 0xaafb550ffacfd8fbULL,
+    0xeeaaba2e5dbf6784ULL, 0x95ba2a53f983cf39ULL,
+    0x952ab45cfa97a0b2ULL, 0xdd945a747bf26184ULL,
+    0xba756174393d88dfULL, 0x94f971119aeef9e5ULL,
+    0xe912b9d1478ceb17ULL, 0x7a37cd5601aab85eULL,
+    0x91abb422ccb812eeULL, 0xac62e055c10ab33bULL,
+    0xb616a12b7fe617aaULL, 0x577b986b314d600aULL,
+    0xe39c49765fdf9d94ULL, 0xed5a7e85fda0b80cULL,
+    0x8e41ade9fbebc27dULL, 0x14588f13be847308ULL,
+    0xb1d219647ae6b31cULL, 0x596eb2d8ae258fc9ULL,
+    0xde469fbd99a05fe3ULL, 0x6fca5f8ed9aef3bcULL,
+    0x8aec23d680043beeULL, 0x25de7bb9480d5855ULL,
+    0xada72ccc20054ae9ULL, 0xaf561aa79a10ae6bULL,
+    0xd910f7ff28069da4ULL, 0x1b2ba1518094da05ULL,
+    0x87aa9aff79042286ULL, 0x90fb44d2f05d0843ULL,
+    0xa99541bf57452b28ULL, 0x353a1607ac744a54ULL,
+    0xd3fa922f2d1675f2ULL, 0x42889b8997915ce9ULL,
+    0x847c9b5d7c2e09b7ULL, 0x69956135febada12ULL,
+    0xa59bc234db398c25ULL, 0x43fab9837e699096ULL,
+    0xcf02b2c21207ef2eULL, 0x94f967e45e03f4bcULL,
+    0x8161afb94b44f57dULL, 0x1d1be0eebac278f6ULL,
+    0xa1ba1ba79e1632dcULL, 0x6462d92a69731733ULL,
+    0xca28a291859bbf93ULL, 0x7d7b8f7503cfdcffULL,
+    0xfcb2cb35e702af78ULL, 0x5cda735244c3d43fULL,
+    0x9defbf01b061adabULL, 0x3a0888136afa64a8ULL,
+    0xc56baec21c7a1916ULL, 0x088aaa1845b8fdd1ULL,
+    0xf6c69a72a3989f5bULL, 0x8aad549e57273d46ULL,
+    0x9a3c2087a63f6399ULL, 0x36ac54e2f678864cULL,
+    0xc0cb28a98fcf3c7fULL, 0x84576a1bb416a7deULL,
+    0xf0fdf2d3f3c30b9fULL, 0x656d44a2a11c51d6ULL,
+    0x969eb7c47859e743ULL, 0x9f644ae5a4b1b326ULL,
+    0xbc4665b596706114ULL, 0x873d5d9f0dde1fefULL,
+    0xeb57ff22fc0c7959ULL, 0xa90cb506d155a7ebULL,
+    0x9316ff75dd87cbd8ULL, 0x09a7f12442d588f3ULL,
+    0xb7dcbf5354e9beceULL, 0x0c11ed6d538aeb30ULL,
+    0xe5d3ef282a242e81ULL, 0x8f1668c8a86da5fbULL,
+    0x8fa475791a569d10ULL, 0xf96e017d694487bdULL,
+    0xb38d92d760ec4455ULL, 0x37c981dcc395a9adULL,
+    0xe070f78d3927556aULL, 0x85bbe253f47b1418ULL,
+    0x8c469ab843b89562ULL, 0x93956d7478ccec8fULL,
+    0xaf58416654a6babbULL, 0x387ac8d1970027b3ULL,
+    0xdb2e51bfe9d0696aULL, 0x06997b05fcc0319fULL,
+    0x88fcf317f22241e2ULL, 0x441fece3bdf81f04ULL,
+    0xab3c2fddeeaad25aULL, 0xd527e81cad7626c4ULL,
+    0xd60b3bd56a5586f1ULL, 0x8a71e223d8d3b075ULL,
+    0x85c7056562757456ULL, 0xf6872d5667844e4aULL,
+    0xa738c6bebb12d16cULL, 0xb428f8ac016561dcULL,
+    0xd106f86e69d785c7ULL, 0xe13336d701beba53ULL,
+    0x82a45b450226b39cULL, 0xecc0024661173474ULL,
+    0xa34d721642b06084ULL, 0x27f002d7f95d0191ULL,
+    0xcc20ce9bd35c78a5ULL, 0x31ec038df7b441f5ULL,
+    0xff290242c83396ceULL, 0x7e67047175a15272ULL,
+    0x9f79a169bd203e41ULL, 0x0f0062c6e984d387ULL,
+    0xc75809c42c684dd1ULL, 0x52c07b78a3e60869ULL,
+    0xf92e0c3537826145ULL, 0xa7709a56ccdf8a83ULL,
+    0x9bbcc7a142b17ccbULL, 0x88a66076400bb692ULL,
+    0xc2abf989935ddbfeULL, 0x6acff893d00ea436ULL,
+    0xf356f7ebf83552feULL, 0x0583f6b8c4124d44ULL,
+    0x98165af37b2153deULL, 0xc3727a337a8b704bULL,
+    0xbe1bf1b059e9a8d6ULL, 0x744f18c0592e4c5dULL,
+    0xeda2ee1c7064130cULL, 0x1162def06f79df74ULL,
+    0x9485d4d1c63e8be7ULL, 0x8addcb5645ac2ba9ULL,
+    0xb9a74a0637ce2ee1ULL, 0x6d953e2bd7173693ULL,
+    0xe8111c87c5c1ba99ULL, 0xc8fa8db6ccdd0438ULL,
+    0x910ab1d4db9914a0ULL, 0x1d9c9892400a22a3ULL,
+    0xb54d5e4a127f59c8ULL, 0x2503beb6d00cab4cULL,
+    0xe2a0b5dc971f303aULL, 0x2e44ae64840fd61eULL,
+    0x8da471a9de737e24ULL, 0x5ceaecfed289e5d3ULL,
+    0xb10d8e1456105dadULL, 0x7425a83e872c5f48ULL,
+    0xdd50f1996b947518ULL, 0xd12f124e28f7771aULL,
+    0x8a5296ffe33cc92fULL, 0x82bd6b70d99aaa70ULL,
+    0xace73cbfdc0bfb7bULL, 0x636cc64d1001550cULL,
+    0xd8210befd30efa5aULL, 0x3c47f7e05401aa4fULL,
+    0x8714a775e3e95c78ULL, 0x65acfaec34810a72ULL,
+    0xa8d9d1535ce3b396ULL, 0x7f1839a741a14d0eULL,
+    0xd31045a8341ca07cULL, 0x1ede48111209a051ULL,
+    0x83ea2b892091e44dULL, 0x934aed0aab460433ULL,
+    0xa4e4b66b68b65d60ULL, 0xf81da84d56178540ULL,
+    0xce1de40642e3f4b9ULL, 0x36251260ab9d668fULL,
+    0x80d2ae83e9ce78f3ULL, 0xc1d72b7c6b42601aULL,
+    0xa1075a24e4421730ULL, 0xb24cf65b8612f820ULL,
+    0xc94930ae1d529cfcULL, 0xdee033f26797b628ULL,
+    0xfb9b7cd9a4a7443cULL, 0x169840ef017da3b2ULL,
+    0x9d412e0806e88aa5ULL, 0x8e1f289560ee864fULL,
+    0xc491798a08a2ad4eULL, 0xf1a6f2bab92a27e3ULL,
+    0xf5b5d7ec8acb58a2ULL, 0xae10af696774b1dcULL,
+    0x9991a6f3d6bf1765ULL, 0xacca6da1e0a8ef2aULL,
+    0xbff610b0cc6edd3fULL, 0x17fd090a58d32af4ULL,
+    0xeff394dcff8a948eULL, 0xddfc4b4cef07f5b1ULL,
+    0x95f83d0a1fb69cd9ULL, 0x4abdaf101564f98fULL,
+    0xbb764c4ca7a4440fULL, 0x9d6d1ad41abe37f2ULL,
+    0xea53df5fd18d5513ULL, 0x84c86189216dc5eeULL,
+    0x92746b9be2f8552cULL, 0x32fd3cf5b4e49bb5ULL,
+    0xb7118682dbb66a77ULL, 0x3fbc8c33221dc2a2ULL,
+    0xe4d5e82392a40515ULL, 0x0fabaf3feaa5334bULL,
+    0x8f05b1163ba6832dULL, 0x29cb4d87f2a7400fULL,
+    0xb2c71d5bca9023f8ULL, 0x743e20e9ef511013ULL,
+    0xdf78e4b2bd342cf6ULL, 0x914da9246b255417ULL,
+    0x8bab8eefb6409c1aULL, 0x1ad089b6c2f7548fULL,
+    0xae9672aba3d0c320ULL, 0xa184ac2473b529b2ULL,
+    0xda3c0f568cc4f3e8ULL, 0xc9e5d72d90a2741fULL,
+    0x8865899617fb1871ULL, 0x7e2fa67c7a658893ULL,
+    0xaa7eebfb9df9de8dULL, 0xddbb901b98feeab8ULL,
+    0xd51ea6fa85785631ULL, 0x552a74227f3ea566ULL,
+    0x8533285c936b35deULL, 0xd53a88958f872760ULL,
+    0xa67ff273b8460356ULL, 0x8a892abaf368f138ULL,
+    0xd01fef10a657842cULL, 0x2d2b7569b0432d86ULL,
+    0x8213f56a67f6b29bULL, 0x9c3b29620e29fc74ULL,
+    0xa298f2c501f45f42ULL, 0x8349f3ba91b47b90ULL,
+    0xcb3f2f7642717713ULL, 0x241c70a936219a74ULL,
+    0xfe0efb53d30dd4d7ULL, 0xed238cd383aa0111ULL,
+    0x9ec95d1463e8a506ULL, 0xf4363804324a40abULL,
+    0xc67bb4597ce2ce48ULL, 0xb143c6053edcd0d6ULL,
+    0xf81aa16fdc1b81daULL, 0xdd94b7868e94050bULL,
+    0x9b10a4e5e9913128ULL, 0xca7cf2b4191c8327ULL,
+    0xc1d4ce1f63f57d72ULL, 0xfd1c2f611f63a3f1ULL,
+    0xf24a01a73cf2dccfULL, 0xbc633b39673c8cedULL,
+    0x976e41088617ca01ULL, 0xd5be0503e085d814ULL,
+    0xbd49d14aa79dbc82ULL, 0x4b2d8644d8a74e19ULL,
+    0xec9c459d51852ba2ULL, 0xddf8e7d60ed1219fULL,
+    0x93e1ab8252f33b45ULL, 0xcabb90e5c942b504ULL,
+    0xb8da1662e7b00a17ULL, 0x3d6a751f3b936244ULL,
+    0xe7109bfba19c0c9dULL, 0x0cc512670a783ad5ULL,
+    0x906a617d450187e2ULL, 0x27fb2b80668b24c6ULL,
+    0xb484f9dc9641e9daULL, 0xb1f9f660802dedf7ULL,
+    0xe1a63853bbd26451ULL, 0x5e7873f8a0396974ULL,
+    0x8d07e33455637eb2ULL, 0xdb0b487b6423e1e9ULL,
+    0xb049dc016abc5e5fULL, 0x91ce1a9a3d2cda63ULL,
+    0xdc5c5301c56b75f7ULL, 0x7641a140cc7810fcULL,
+    0x89b9b3e11b6329baULL, 0xa9e904c87fcb0a9eULL,
+    0xac2820d9623bf429ULL, 0x546345fa9fbdcd45ULL,
+    0xd732290fbacaf133ULL, 0xa97c177947ad4096ULL,
+    0x867f59a9d4bed6c0ULL, 0x49ed8eabcccc485eULL,
+    0xa81f301449ee8c70ULL, 0x5c68f256bfff5a75ULL,
+    0xd226fc195c6a2f8cULL, 0x73832eec6fff3112ULL,
+    0x83585d8fd9c25db7ULL, 0xc831fd53c5ff7eacULL,
+    0xa42e74f3d032f525ULL, 0xba3e7ca8b77f5e56ULL,
+    0xcd3a1230c43fb26fULL, 0x28ce1bd2e55f35ecULL,
+    0x80444b5e7aa7cf85ULL, 0x7980d163cf5b81b4ULL,
+    0xa0555e361951c366ULL, 0xd7e105bcc3326220ULL,
+    0xc86ab5c39fa63440ULL, 0x8dd9472bf3fefaa8ULL,
+    0xfa856334878fc150ULL, 0xb14f98f6f0feb952ULL,
+    0x9c935e00d4b9d8d2ULL, 0x6ed1bf9a569f33d4ULL,
+    0xc3b8358109e84f07ULL, 0x0a862f80ec4700c9ULL,
+    0xf4a642e14c6262c8ULL, 0xcd27bb612758c0fbULL,
+    0x98e7e9cccfbd7dbdULL, 0x8038d51cb897789dULL,
+    0xbf21e44003acdd2cULL, 0xe0470a63e6bd56c4ULL,
+    0xeeea5d5004981478ULL, 0x1858ccfce06cac75ULL,
+    0x95527a5202df0ccbULL, 0x0f37801e0c43ebc9ULL,
+    0xbaa718e68396cffdULL, 0xd30560258f54e6bbULL,
+    0xe950df20247c83fdULL, 0x47c6b82ef32a206aULL,
+    0x91d28b7416cdd27eULL, 0x4cdc331d57fa5442ULL,
+    0xb6472e511c81471dULL, 0xe0133fe4adf8e953ULL,
+    0xe3d8f9e563a198e5ULL, 0x58180fddd97723a7ULL,
+    0x8e679c2f5e44ff8fULL, 0x570f09eaa7ea7649ULL,
+    0xb201833b35d63f73ULL, 0x2cd2cc6551e513dbULL,
+    0xde81e40a034bcf4fULL, 0xf8077f7ea65e58d2ULL,
+    0x8b112e86420f6191ULL, 0xfb04afaf27faf783ULL,
+    0xadd57a27d29339f6ULL, 0x79c5db9af1f9b564ULL,
+    0xd94ad8b1c7380874ULL, 0x18375281ae7822bdULL,
+    0x87cec76f1c830548ULL, 0x8f2293910d0b15b6ULL,
+    0xa9c2794ae3a3c69aULL, 0xb2eb3875504ddb23ULL,
+    0xd433179d9c8cb841ULL, 0x5fa60692a46151ecULL,
+    0x849feec281d7f328ULL, 0xdbc7c41ba6bcd334ULL,
+    0xa5c7ea73224deff3ULL, 0x12b9b522906c0801ULL,
+    0xcf39e50feae16befULL, 0xd768226b34870a01ULL,
+    0x81842f29f2cce375ULL, 0xe6a1158300d46641ULL,
+    0xa1e53af46f801c53ULL, 0x60495ae3c1097fd1ULL,
+    0xca5e89b18b602368ULL, 0x385bb19cb14bdfc5ULL,
+    0xfcf62c1dee382c42ULL, 0x46729e03dd9ed7b6ULL,
+    0x9e19db92b4e31ba9ULL, 0x6c07a2c26a8346d2ULL,
+};
+
+int32_t _stringFloorLog2Pow10(int32_t e) {
+    return (e * 1741647) >> 19;
+}
+
+int32_t _stringFloorLog10Pow2(int32_t e) {
+    return (e * 1262611) >> 22;
+}
+
+int32_t _stringFloorLog10ThreeQuartersPow2(int32_t e) {
+    return (e * 1262611 - 524031) >> 22;
+}
+
+// Top 64 bits of g * cp, with the lowest bit set when anything was cut off.
+uint64_t _stringRoundToOdd(const uint64_t *g, uint64_t cp) {
+    uint64_t xl = g[1];
+    uint64_t xh = cp;
+    _stringMul128(&xl, &xh);
+    uint64_t yl = g[0];
+    uint64_t yh = cp;
+    _stringMul128(&yl, &yh);
+    uint64_t z = yl + xh;
+    uint64_t vb = yh + (z < xh);
+    return vb | (z > 1);
+}
+
+// Schubfach: the shortest w * 10^k that reads back as the finite, non-zero
+// double with these fields. `w` may still end in zeros.
+void _stringShortestDecimal(uint64_t mantissa, uint32_t exponent, uint64_t *w, int32_t *k) {
+    uint64_t c = mantissa;
+    int32_t q = 1 - 1075;
+    if (exponent != 0) {
+        c |= 1ULL << 52;
+        q = (int32_t)exponent - 1075;
+    }
+    bool even = (c & 1) == 0;
+    bool closerBelow = mantissa == 0 && exponent > 1;
+    uint64_t cbl = 4 * c - 2 + closerBelow;
+    uint64_t cb = 4 * c;
+    uint64_t cbr = 4 * c + 2;
+    int32_t e10 = closerBelow ? _stringFloorLog10ThreeQuartersPow2(q) : _stringFloorLog10Pow2(q);
+    int32_t h = q + _stringFloorLog2Pow10(-e10) + 1;
+    const uint64_t *g = POW10_128 + 2 * (-e10 - POW10_128_MIN_EXP);
+    uint64_t vbl = _stringRoundToOdd(g, cbl << h);
+    uint64_t vb = _stringRoundToOdd(g, cb << h);
+    uint64_t vbr = _stringRoundToOdd(g, cbr << h);
+    uint64_t lower = vbl + !even;
+    uint64_t upper = vbr - !even;
+    uint64_t sd = vb / 4;
+    if (sd >= 10) {
+        uint64_t sp = sd / 10;
+        bool upInside = lower <= 40 * sp;
+        bool wpInside = 40 * sp + 40 <= upper;
+        if (upInside != wpInside) {
+            *w = sp + wpInside;
+            *k = e10 + 1;
+            return;
+        }
+    }
+    bool uInside = lower <= 4 * sd;
+    bool wInside = 4 * sd + 4 <= upper;
+    if (uInside != wInside) {
+        *w = sd + wInside;
+        *k = e10;
+        return;
+    }
+    uint64_t mid = 4 * sd + 2;
+    *w = sd + (vb > mid || (vb == mid && (sd & 1) != 0));
+    *k = e10;
+}
+
+// Writes w * 10^k the way ECMAScript's Number::toString does: plain notation
+// while the decimal point is at most 21 digits in or 6 zeros out, exponent
+// notation ("1.5e+300") otherwise.
+void _stringAppendDecimal(TString *s, bool negative, uint64_t w, int32_t k) {
+    char digits[20];
+    int32_t n = (int32_t)_stringCountDigits(w);
+    _stringWriteDigits(digits + n, w);
+    if (!_stringEnsureCap(s, s->size + 32)) return;
+    char *start = stringData(s) + s->size;
+    char *p = start;
+    if (negative) *p++ = '-';
+    int32_t point = n + k;
+    if (0 < point && point <= 21) {
+        if (k >= 0) {
+            memcpy(p, digits, (size_t)n);
+            memset(p + n, '0', (size_t)k);
+            p += point;
+        } else {
+            memcpy(p, digits, (size_t)point);
+            p[point] = '.';
+            memcpy(p + point + 1, digits + point, (size_t)-k);
+            p += n + 1;
+        }
+    } else if (-6 < point && point <= 0) {
+        *p++ = '0';
+        *p++ = '.';
+        memset(p, '0', (size_t)-point);
+        memcpy(p - point, digits, (size_t)n);
+        p += n - point;
+    } else {
+        *p++ = digits[0];
+        if (n > 1) {
+            *p++ = '.';
+            memcpy(p, digits + 1, (size_t)n - 1);
+            p += n - 1;
+        }
+        int32_t e = point - 1;
+        *p++ = 'e';
+        *p++ = e < 0 ? '-' : '+';
+        uint64_t mag = (uint64_t)(e < 0 ? -e : e);
+        size_t ed = _stringCountDigits(mag);
+        _stringWriteDigits(p + ed, mag);
+        p += ed;
+    }
+    s->size += (size_t)(p - start);
+}
+
+// Appends the shortest text that stringToDouble reads back as exactly `d`.
+// Infinities and NaN come out as "inf", "-inf" and "nan".
+void stringAppendDouble(TString *s, double d) {
+    if (s == NULL) {
+        setError(ERR_NULL_POINTER);
+        return;
+    }
+    clearError();
+    uint64_t bits;
+    memcpy(&bits, &d, sizeof(bits));
+    bool negative = (bits >> 63) != 0;
+    uint64_t mantissa = bits & ((1ULL << 52) - 1);
+    uint32_t exponent = (uint32_t)(bits >> 52) & 0x7FF;
+    if (exponent == 0x7FF) {
+        stringAppendCharArr(s, mantissa != 0 ? "nan" : negative ? "-inf" : "inf");
+        return;
+    }
+    if (exponent == 0 && mantissa == 0) {
+        stringAppendCharArr(s, negative ? "-0" : "0");
+        return;
+    }
+    uint64_t w;
+    int32_t k;
+    _stringShortestDecimal(mantissa, exponent, &w, &k);
+    while (w % 10 == 0) {
+        w /= 10;
+        ++k;
+    }
+    _stringAppendDecimal(s, negative, w, k);
+}
+
+// Appends `d` with exactly `precision` digits after the point, rounded like
+// "%.*f". While |d| * 10^precision fits in 64 bits the rounding is done
+// exactly in 128-bit arithmetic; anything larger goes through snprintf.
+void stringAppendDoubleFixed(TString *s, double d, size_t precision) {
+    if (s == NULL) {
+        setError(ERR_NULL_POINTER);
+        return;
+    }
+    clearError();
+    uint64_t bits;
+    memcpy(&bits, &d, sizeof(bits));
+    bool negative = (bits >> 63) != 0;
+    uint64_t mantissa = bits & ((1ULL << 52) - 1);
+    uint32_t exponent = (uint32_t)(bits >> 52) & 0x7FF;
+    if (exponent == 0x7FF) {
+        stringAppendCharArr(s, mantissa != 0 ? (negative ? "-nan" : "nan") : negative ? "-inf" : "inf");
+        return;
+    }
+#ifdef __SIZEOF_INT128__
+    if (precision <= 19) {
+        int32_t e2 = exponent != 0 ? (int32_t)exponent - 1075 : 1 - 1075;
+        if (exponent != 0) mantissa |= 1ULL << 52;
+        __uint128_t scaled = (__uint128_t)mantissa * POW10[precision];
+        bool fits = true;
+        uint64_t v = 0;
+        if (e2 >= 0) {
+            fits = e2 < 64 && (scaled >> (64 - e2)) == 0;
+            if (fits) v = (uint64_t)(scaled << e2);
+        } else if (e2 > -128) {
+            __uint128_t q = scaled >> -e2;
+            __uint128_t rem = scaled - (q << -e2);
+            __uint128_t half = (__uint128_t)1 << (-e2 - 1);
+            fits = (q >> 64) == 0;
+            v = (uint64_t)q + (rem > half || (rem == half && (q & 1) != 0));
+            fits = fits && v >= (uint64_t)q;
+        }
+        if (fits) {
+            char digits[21];
+            size_t n = _stringCountDigits(v);
+            size_t width = n > precision ? n : precision + 1;
+            memset(digits, '0', width);
+            _stringWriteDigits(digits + width, v);
+            size_t whole = width - precision;
+            size_t len = negative + whole + (precision > 0 ? precision + 1 : 0);
+            if (!_stringEnsureCap(s, s->size + len)) return;
+            char *p = stringData(s) + s->size;
+            if (negative) *p++ = '-';
+            memcpy(p, digits, whole);
+            if (precision > 0) {
+                p[whole] = '.';
+                memcpy(p + whole + 1, digits + whole, precision);
+            }
+            s->size += len;
+            return;
+        }
+    }
+#endif
+    int len = snprintf(NULL, 0, "%.*f", (int)precision, d);
+    if (len < 0 || !_stringEnsureCap(s, s->size + (size_t)len + 1)) return;
+    char *p = stringData(s) + s->size;
+    snprintf(p, (size_t)len + 1, "%.*f", (int)precision, d);
+    // the locale may have chosen another decimal point
+    for (int i = 0; i < len; ++i) {
+        if (p[i] != '-' && (p[i] < '0' || p[i] > '9')) p[i] = '.';
+    }
+    s->size += (size_t)len;
+}
+
+typedef enum EFormatLength {
+    FORMAT_LEN_DEFAULT,
+    FORMAT_LEN_HH,
+    FORMAT_LEN_H,
+    FORMAT_LEN_L,
+    FORMAT_LEN_LL,
+    FORMAT_LEN_Z,
+    FORMAT_LEN_J,
+    FORMAT_LEN_T,
+    FORMAT_LEN_LONG_DOUBLE,
+} EFormatLength;
+
+typedef struct TStringFormatSpec {
+    bool left;
+    bool plus;
+    bool space;
+    bool zero;
+    bool alt;
+    size_t width;
+    int precision;  // -1 when absent
+    EFormatLength length;
+    char conv;
+} TStringFormatSpec;
+
+// Parses the conversion after a '%', taking '*' widths and precisions from
+// `ap`. Returns the position after the conversion character.
+const char *_stringParseFormatSpec(const char *f, TStringFormatSpec *spec, va_list *ap) {
+    memset(spec, 0, sizeof(*spec));
+    spec->precision = -1;
+    for (;; ++f) {
+        if (*f == '-') spec->left = true;
+        else if (*f == '+') spec->plus = true;
+        else if (*f == ' ') spec->space = true;
+        else if (*f == '0') spec->zero = true;
+        else if (*f == '#') spec->alt = true;
+        else break;
+    }
+    if (*f == '*') {
+        int w = va_arg(*ap, int);
+        if (w < 0) {
+            spec->left = true;
+            w = -w;
+        }
+        spec->width = (size_t)w;
+        ++f;
+    } else {
+        while ('0' <= *f && *f <= '9') spec->width = spec->width * 10 + (size_t)(*f++ - '0');
+    }
+    if (*f == '.') {
+        ++f;
+        spec->precision = 0;
+        if (*f == '*') {
+            spec->precision = va_arg(*ap, int);
+            if (spec->precision < 0) spec->precision = -1;
+            ++f;
+        } else {
+            while ('0' <= *f && *f <= '9') spec->precision = spec->precision * 10 + (*f++ - '0');
+        }
+    }
+    switch (*f) {
+        case 'h':
+            spec->length = f[1] == 'h' ? FORMAT_LEN_HH : FORMAT_LEN_H;
+            f += 1 + (f[1] == 'h');
+            break;
+        case 'l':
+            spec->length = f[1] == 'l' ? FORMAT_LEN_LL : FORMAT_LEN_L;
+            f += 1 + (f[1] == 'l');
+            break;
+        case 'z': spec->length = FORMAT_LEN_Z; ++f; break;
+        case 'j': spec->length = FORMAT_LEN_J; ++f; break;
+        case 't': spec->length = FORMAT_LEN_T; ++f; break;
+        case 'L': spec->length = FORMAT_LEN_LONG_DOUBLE; ++f; break;
+        default: break;
+    }
+    spec->conv = *f;
+    return *f != '\0' ? f + 1 : f;
+}
+
+uint64_t _stringFormatFetchInt(const TStringFormatSpec *spec, va_list *ap, bool *negative) {
+    *negative = false;
+    if (spec->conv == 'd' || spec->conv == 'i') {
+        int64_t v;
+        switch (spec->length) {
+            case FORMAT_LEN_HH: v = (signed char)va_arg(*ap, int); break;
+            case FORMAT_LEN_H: v = (short)va_arg(*ap, int); break;
+            case FORMAT_LEN_L: v = va_arg(*ap, long); break;
+            case FORMAT_LEN_LL: v = va_arg(*ap, long long); break;
+            case FORMAT_LEN_Z:
+            case FORMAT_LEN_T: v = va_arg(*ap, ptrdiff_t); break;
+            case FORMAT_LEN_J: v = va_arg(*ap, intmax_t); break;
+            default: v = va_arg(*ap, int); break;
+        }
+        *negative = v < 0;
+        return v < 0 ? 0 - (uint64_t)v : (uint64_t)v;
+    }
+    if (spec->conv == 'p') return (uintptr_t)va_arg(*ap, void *);
+    switch (spec->length) {
+        case FORMAT_LEN_HH: return (unsigned char)va_arg(*ap, unsigned);
+        case FORMAT_LEN_H: return (unsigned short)va_arg(*ap, unsigned);
+        case FORMAT_LEN_L: return va_arg(*ap, unsigned long);
+        case FORMAT_LEN_LL: return va_arg(*ap, unsigned long long);
+        case FORMAT_LEN_Z:
+        case FORMAT_LEN_T: return va_arg(*ap, size_t);
+        case FORMAT_LEN_J: return va_arg(*ap, uintmax_t);
+        default: return va_arg(*ap, unsigned);
+    }
+}
+
+// Brings the conversion written from `start` up to the spec's width: spaces
+// on the left or right, or zeros after the first `skip` (sign or "0x") bytes.
+void _stringFormatPad(TString *s, size_t start, const TStringFormatSpec *spec, size_t skip, bool zeros) {
+    size_t len = s->size - start;
+    if (spec->width <= len) return;
+    size_t pad = spec->width - len;
+    char *p = stringData(s) + start;
+    if (spec->left) {
+        memset(p + len, ' ', pad);
+    } else if (zeros) {
+        memmove(p + skip + pad, p + skip, len - skip);
+        memset(p + skip, '0', pad);
+    } else {
+        memmove(p + pad, p, len);
+        memset(p, ' ', pad);
+    }
+    s->size += pad;
+}
+
+void _stringFormatInt(TString *s, const TStringFormatSpec *spec, bool negative, uint64_t v) {
+    const char *hex = spec->conv == 'X' ? "0123456789ABCDEF" : "0123456789abcdef";
+    unsigned base = spec->conv == 'o' ? 8 : (spec->conv == 'x' || spec->conv == 'X' || spec->conv == 'p') ? 16 : 10;
+    char digits[24];
+    size_t n = 0;
+    if (base == 10) {
+        n = _stringCountDigits(v);
+        _stringWriteDigits(digits + n, v);
+    } else {
+        char *end = digits + sizeof(digits);
+        uint64_t t = v;
+        do {
+            digits[sizeof(digits) - ++n] = hex[t % base];
+            t /= base;
+        } while (t != 0);
+        memmove(digits, end - n, n);
+    }
+    size_t precision = spec->precision >= 0 ? (size_t)spec->precision : 1;
+    if (precision == 0 && v == 0) n = 0;
+    if (base == 8 && spec->alt && precision <= n && (n == 0 || digits[0] != '0')) precision = n + 1;
+    bool signedConv = spec->conv == 'd' || spec->conv == 'i';
+    size_t start = s->size;
+    char *p = stringData(s) + start;
+    size_t skip = 0;
+    if (negative) p[skip++] = '-';
+    else if (spec->plus && signedConv) p[skip++] = '+';
+    else if (spec->space && signedConv) p[skip++] = ' ';
+    if (spec->conv == 'p' || (spec->alt && base == 16 && v != 0)) {
+        p[skip++] = '0';
+        p[skip++] = spec->conv == 'X' ? 'X' : 'x';
+    }
+    size_t zeros = precision > n ? precision - n : 0;
+    memset(p + skip, '0', zeros);
+    memcpy(p + skip + zeros, digits, n);
+    s->size += skip + zeros + n;
+    _stringFormatPad(s, start, spec, skip, spec->zero && spec->precision < 0);
+}
+
+void _stringFormatDouble(TString *s, const TStringFormatSpec *spec, double d) {
+    size_t start = s->size;
+    uint64_t bits;
+    memcpy(&bits, &d, sizeof(bits));
+    bool finite = d - d == 0;
+    if ((bits >> 63) == 0 && (spec->plus || spec->space)) stringPushBack(s, spec->plus ? '+' : ' ');
+    if (spec->conv == 'r') {
+        stringAppendDouble(s, d);
+    } else {
+        stringAppendDoubleFixed(s, d, spec->precision >= 0 ? (size_t)spec->precision : 6);
+        if (spec->alt && spec->precision == 0 && finite) stringPushBack(s, '.');
+    }
+    char *p = stringData(s);
+    if (spec->conv == 'F') {
+        for (size_t i = start; i < s->size; ++i) p[i] = stringCharToUpper(p[i]);
+    }
+    size_t skip = p[start] == '-' || p[start] == '+' || p[start] == ' ';
+    _stringFormatPad(s, start, spec, skip, spec->zero && finite);
+}
+
+// Hands a conversion the library does not implement itself (%e, %g, %a and
+// long doubles) to the C library, as a spec rebuilt without '*'.
+size_t _stringFormatExternal(char *out, size_t room, const TStringFormatSpec *spec, long double v) {
+    char fmt[48];
+    size_t n = 0;
+    fmt[n++] = '%';
+    if (spec->left) fmt[n++] = '-';
+    if (spec->plus) fmt[n++] = '+';
+    if (spec->space) fmt[n++] = ' ';
+    if (spec->zero) fmt[n++] = '0';
+    if (spec->alt) fmt[n++] = '#';
+    fmt[n++] = '*';
+    fmt[n++] = '.';
+    fmt[n++] = '*';
+    if (spec->length == FORMAT_LEN_LONG_DOUBLE) fmt[n++] = 'L';
+    fmt[n++] = spec->conv;
+    fmt[n] = '\0';
+    int len = spec->length == FORMAT_LEN_LONG_DOUBLE ? snprintf(out, room, fmt, (int)spec->width, spec->precision, v)
+                                                     : snprintf(out, room, fmt, (int)spec->width, spec->precision, (double)v);
+    return len < 0 ? 0 : (size_t)len;
+}
+
+// One walk over `format` and the arguments. Without `s` it only returns an
+// upper bound of the output length (SIZE_MAX for a bad conversion);
+// otherwise it writes into `s`, whose capacity the caller has reserved.
+size_t _stringFormatRun(TString *s, const char *format, va_list ap) {
+    va_list args;
+    va_copy(args, ap);
+    size_t bound = 0;
+    const char *f = format;
+    while (*f != '\0') {
+        const char *pct = strchr(f, '%');
+        size_t literal = pct != NULL ? (size_t)(pct - f) : strlen(f);
+        if (s != NULL) {
+            memcpy(stringData(s) + s->size, f, literal);
+            s->size += literal;
+        }
+        bound += literal;
+        if (pct == NULL) break;
+        TStringFormatSpec spec;
+        f = _stringParseFormatSpec(pct + 1, &spec, &args);
+        size_t body = 0;
+        switch (spec.conv) {
+            case '%':
+                if (s != NULL) stringData(s)[s->size++] = '%';
+                body = 1;
+                break;
+            case 'd': case 'i': case 'u': case 'x': case 'X': case 'o': case 'p': {
+                bool negative;
+                uint64_t v = _stringFormatFetchInt(&spec, &args, &negative);
+                if (s != NULL) _stringFormatInt(s, &spec, negative, v);
+                body = (spec.precision > 24 ? (size_t)spec.precision : 24) + 3;
+                break;
+            }
+            case 'c': {
+                char c = (char)va_arg(args, int);
+                if (s != NULL) {
+                    size_t start = s->size;
+                    stringData(s)[s->size++] = c;
+                    _stringFormatPad(s, start, &spec, 0, false);
+                }
+                body = 1;
+                break;
+            }
+            case 's':
+            case 'S': {
+                const char *p;
+                size_t n;
+                if (spec.conv == 'S') {
+                    TString str = va_arg(args, TString);
+                    p = stringData(&str);
+                    n = str.size;
+                    if (spec.precision >= 0 && (size_t)spec.precision < n) n = (size_t)spec.precision;
+                    if (s != NULL) {
+                        size_t start = s->size;
+                        memcpy(stringData(s) + s->size, p, n);
+                        s->size += n;
+                        _stringFormatPad(s, start, &spec, 0, false);
+                    }
+                } else {
+                    p = va_arg(args, const char *);
+                    if (p == NULL) p = "(null)";
+                    if (spec.precision >= 0) {
+                        const char *z = (const char *)memchr(p, '\0', (size_t)spec.precision);
+                        n = z != NULL ? (size_t)(z - p) : (size_t)spec.precision;
+                    } else {
+                        n = strlen(p);
+                    }
+                    if (s != NULL) {
+                        size_t start = s->size;
+                        memcpy(stringData(s) + s->size, p, n);
+                        s->size += n;
+                        _stringFormatPad(s, start, &spec, 0, false);
+                    }
+                }
+                body = n;
+                break;
+            }
+            case 'f': case 'F': case 'r':
+                if (spec.length != FORMAT_LEN_LONG_DOUBLE) {
+                    double d = va_arg(args, double);
+                    if (s != NULL) _stringFormatDouble(s, &spec, d);
+                    size_t precision = spec.precision >= 0 ? (size_t)spec.precision : 6;
+                    body = (d < 1e17 && d > -1e17 ? 32 : 320) + precision;
+                    break;
+                }
+                // fall through
+            case 'e': case 'E': case 'g': case 'G': case 'a': case 'A': {
+                long double v = spec.length == FORMAT_LEN_LONG_DOUBLE ? va_arg(args, long double) : va_arg(args, double);
+                if (spec.conv == 'r') spec.conv = 'g';
+                if (s != NULL) {
+                    s->size += _stringFormatExternal(stringData(s) + s->size, stringCapacity(s) - s->size, &spec, v);
+                } else {
+                    body = _stringFormatExternal(NULL, 0, &spec, v);
+                }
+                break;
+            }
+            default:
+                va_end(args);
+                return SIZE_MAX;
+        }
+        bound += body > spec.width ? body : spec.width;
+    }
+    va_end(args);
+    return bound;
+}
+
+// printf-style formatting appended to `s`. Besides the usual conversions,
+// %S takes a TString and %r a double printed like stringAppendDouble.
+// Integers, %f and %r use the library's own formatters; the output space is
+// measured up front so the buffer grows at most once.
+void stringAppendFormatV(TString *s, const char *format, va_list ap) {
+    if (s == NULL || format == NULL) {
+        setError(ERR_NULL_POINTER);
+        return;
+    }
+    clearError();
+    size_t bound = _stringFormatRun(NULL, format, ap);
+    if (bound == SIZE_MAX) {
+        setError(ERR_INVALID_FORMAT);
+        return;
+    }
+    size_t needed = s->size + bound + 1;
+    size_t capacity = stringCapacity(s);
+    if (needed <= capacity) {
+        _stringFormatRun(s, format, ap);
+        return;
+    }
+    // %S and %s arguments may point into s, so the old buffer is released only
+    // after the write pass has read them.
+    size_t newCap = capacity * 2;
+    if (newCap < capacity || newCap < needed) newCap = needed;
+    TString grown = stringInitWithAllocator(newCap, _stringAllocatorOf(s));
+    if (isError()) return;
+    if (s->size > 0) memcpy(stringData(&grown), stringData(s), s->size);
+    grown.size = s->size;
+    _stringFormatRun(&grown, format, ap);
+    stringDestroy(s);
+    *s = grown;
+}
+
+void stringAppendFormat(TString *s, const char *format, ...) {
+    va_list ap;
+    va_start(ap, format);
+    stringAppendFormatV(s, format, ap);
+    va_end(ap);
+}
+
+TString stringFormat(const char *format, ...) {
+    if (format == NULL) {
+        setError(ERR_NULL_POINTER);
+        return (TString){0};
+    }
+    clearError();
+    va_list ap;
+    va_start(ap, format);
+    size_t bound = _stringFormatRun(NULL, format, ap);
+    TString res = {0};
+    if (bound == SIZE_MAX) {
+        setError(ERR_INVALID_FORMAT);
+    } else {
+        res = stringInit(bound + 1);
+        if (!isError()) {
+            _stringFormatRun(&res, format, ap);
+        }
+    }
+    va_end(ap);
+    return res;
+}
+
+TStringView stringViewOf(const TString *s) {
+    TStringView v = {0};
+    if (s == NULL) return v;
+    v.data = stringData(s);
+    v.size = s->size;
+    return v;
+}
+
+TStringView stringViewFromCharArr(const char *s) {
+    TStringView v = {0};
+    if (s == NULL) return v;
+    v.data = s;
+    v.size = stringLenCharArr(s);
+    return v;
+}
+
+TString stringViewToString(TStringView v) {
+    clearError();
+    TString res = stringInit(v.size);
+    if (isError()) return (TString){0};
+    stringAppendChars(&res, v.data, v.size);
+    return res;
+}
+
+bool stringViewIsEqual(TStringView s1, TStringView s2) {
+    if (s1.size != s2.size) return false;
+    return _stringEqualBuf(s1.data, s2.data, s1.size);
+}
+
+bool stringViewIsEqualIgnoreCase(TStringView s1, TStringView s2) {
+    if (s1.size != s2.size) return false;
+    return _stringMismatchIgnoreCase(s1.data, s2.data, s1.size) == s1.size;
+}
+
+bool stringViewStartWith(TStringView s, TStringView pref) {
+    if (s.size < pref.size) return false;
+    return _stringEqualBuf(s.data, pref.data, pref.size);
+}
+
+bool stringViewEndWith(TStringView s, TStringView suffix) {
+    if (s.size < suffix.size) return false;
+    return _stringEqualBuf(s.data + s.size - suffix.size, suffix.data, suffix.size);
+}
+
+int stringViewCompare(TStringView s1, TStringView s2) {
+    return _stringCompareBuf(s1.data, s1.size, s2.data, s2.size, false /* caseSensitive */);
+}
+
+int64_t stringViewFindFirst(TStringView s, TStringView pattern) {
+    return _stringSearch(s.data, s.size, pattern.data, pattern.size);
+}
+
+TStringView stringViewSubstring(TStringView s, size_t pos, size_t len) {
+    if (pos > s.size) pos = s.size;
+    if (len > s.size - pos) len = s.size - pos;
+    if (pos > 0) s.data += pos;
+    s.size = len;
+    return s;
+}
+
+TStringView stringViewTrimLeft(TStringView s) {
+    size_t start = 0;
+    while (start < s.size && stringCharOneOf(s.data[start], " \t\n")) {
+        ++start;
+    }
+    return stringViewSubstring(s, start, s.size - start);
+}
+
+TStringView stringViewTrimRight(TStringView s) {
+    while (s.size > 0 && stringCharOneOf(s.data[s.size - 1], " \t\n")) {
+        --s.size;
+    }
+    return s;
+}
+
+TStringView stringViewTrim(TStringView s) {
+    return stringViewTrimLeft(stringViewTrimRight(s));
+}
+
+TStringView stringViewStripPrefix(TStringView s, TStringView pref) {
+    if (!stringViewStartWith(s, pref)) return s;
+    return stringViewSubstring(s, pref.size, s.size - pref.size);
+}
+
+TStringView stringViewStripSuffix(TStringView s, TStringView suffix) {
+    if (!stringViewEndWith(s, suffix)) return s;
+    s.size -= suffix.size;
+    return s;
+}
+
+TStringSplitIter stringSplitIter(TStringView s, char delim) {
+    TStringSplitIter it = {0};
+    it.rest = s;
+    it.mode = SPLIT_BY_CHAR;
+    it.delimChar = delim;
+    return it;
+}
+
+// `delims` is borrowed and must outlive the iterator.
+TStringSplitIter stringSplitIterAnyOf(TStringView s, const char *delims) {
+    TStringSplitIter it = {0};
+    it.rest = s;
+    it.mode = SPLIT_BY_ANY_OF;
+    it.delim = stringViewFromCharArr(delims);
+    for (size_t i = 0; i < it.delim.size; ++i) {
+        uint8_t c = (uint8_t)it.delim.data[i];
+        it.anyOf[c >> 3] |= (uint8_t)(1u << (c & 7));
+    }
+    return it;
+}
+
+// `delim` is borrowed and must outlive the iterator.
+TStringSplitIter stringSplitIterSubstring(TStringView s, TStringView delim) {
+    TStringSplitIter it = {0};
+    it.rest = s;
+    it.mode = SPLIT_BY_SUBSTRING;
+    it.delim = delim;
+    return it;
+}
+
+bool stringSplitNext(TStringSplitIter *it, TStringView *field) {
+    if (it == NULL || field == NULL) {
+        setError(ERR_NULL_POINTER);
+        return false;
+    }
+    while (!it->done) {
+        int64_t pos = -1;
+        size_t delimLen = 0;
+        if (it->maxSplits == 0 || it->splits < it->maxSplits) {
+            pos = _stringSplitFind(it, &delimLen);
+        }
+        if (pos < 0) {
+            *field = it->rest;
+            it->done = true;
+        } else {
+            *field = stringViewSubstring(it->rest, 0, (size_t)pos);
+            it->rest = stringViewSubstring(it->rest, (size_t)pos + delimLen, it->rest.size);
+        }
+        if (it->skipEmpty && field->size == 0) continue;
+        if (pos >= 0) ++it->splits;
+        return true;
+    }
+    return false;
+}
+
+// The fields are packed into one blob (at most s.size bytes), so splitting
+// costs a couple of allocations instead of one per field; read them with
+// stringVecGet.
+TStrVec stringSplit(TString s, TString delim) {
+    clearError();
+    TStrVec res = stringVecInitPacked(0, s.size);
+    if (isError()) {
+        stringVecDestroy(&res);
+        return res;
+    }
+    TStringSplitIter it = stringSplitIterSubstring(stringViewOf(&s), stringViewOf(&delim));
+    TStringView field;
+    while (stringSplitNext(&it, &field)) {
+        stringVecPushBackView(&res, field);
+        if (isError()) {
+            stringVecDestroy(&res);
+            return res;
+        }
+    }
+    return res;
+}
+
+TStrVec stringSplitCharArr(TString s, const char *delim) {
+    if (delim == NULL) {
+        setError(ERR_NULL_POINTER);
+        return (TStrVec){0};
+    }
+    TString view = {0};
+    view.data = (char *)delim;
+    view.size = stringLenCharArr(delim);
+    view.capacity = view.size;
+    return stringSplit(s, view);
+}
+
+typedef struct TStringColumn {
+    const char *set;
+    size_t setSize;
+    uint8_t bitmap[32];
+} TStringColumn;
+
+TStringColumn _stringColumnInit(const char *delims) {
+    TStringColumn col = {0};
+    col.set = delims;
+    col.setSize = stringLenCharArr(delims);
+    for (size_t i = 0; i < col.setSize; ++i) {
+        uint8_t c = (uint8_t)delims[i];
+        col.bitmap[c >> 3] |= (uint8_t)(1u << (c & 7));
+    }
+    return col;
+}
+
+bool _stringColumnIsDelim(const TStringColumn *col, char c) {
+    return (col->bitmap[(uint8_t)c >> 3] >> ((uint8_t)c & 7)) & 1;
+}
+
+size_t _stringColumnFieldEnd(const TStringColumn *col, const char *p, size_t n, size_t pos) {
+    int64_t found = _stringFindAnyOf(p + pos, n - pos, col->set, col->setSize, col->bitmap);
+    return found < 0 ? n : pos + (size_t)found;
+}
+
+bool _stringColumnCheck(TStringView *rest, const char *delims, const void *out) {
+    if (rest == NULL || delims == NULL || out == NULL || (rest->data == NULL && rest->size > 0)) {
+        setError(ERR_NULL_POINTER);
+        return false;
+    }
+    clearError();
+    return true;
+}
+
+void _stringColumnAdvance(TStringView *rest, size_t pos) {
+    if (pos == 0) return;
+    rest->data += pos;
+    rest->size -= pos;
+}
+
+// Numbers are parsed straight from the buffer and the delimiter is only
+// checked right after them, so well-formed fields are never scanned twice;
+// a malformed field is skipped with a vectorized delimiter search.
+size_t _stringParseIntColumn(TStringView *rest, const char *delims, bool isSigned, int64_t *signedOut,
+                             uint64_t *unsignedOut, uint8_t *errors, size_t capacity) {
+    const TStringColumn col = _stringColumnInit(delims);
+    const char *p = rest->data;
+    const size_t n = rest->size;
+    size_t pos = 0;
+    size_t count = 0;
+    while (count < capacity && pos < n) {
+        TStringView field = {p + pos, n - pos};
+        size_t used = 0;
+        int64_t value = 0;
+        uint64_t uvalue = 0;
+        EErrorCode e = isSigned ? _stringParseSigned(field, INT64_MIN, INT64_MAX, &value, &used)
+                                : _stringParseUnsigned(field, &uvalue, &used);
+        size_t end = pos + used;
+        if (end < n && !_stringColumnIsDelim(&col, p[end])) {
+            e = ERR_INVALID_NUMBER_REPR;
+            value = 0;
+            uvalue = 0;
+            end = _stringColumnFieldEnd(&col, p, n, end);
+        }
+        if (isSigned) {
+            signedOut[count] = value;
+        } else {
+            unsignedOut[count] = uvalue;
+        }
+        if (errors != NULL) errors[count] = (uint8_t)e;
+        ++count;
+        pos = end < n ? end + 1 : n;
+    }
+    _stringColumnAdvance(rest, pos);
+    return count;
+}
+
+// Parses up to `capacity` fields separated by any byte of `delims` into `out`
+// and advances `rest` past them, so a long buffer can be parsed in batches.
+// errors[i], when given, receives the EErrorCode of field i with the same
+// meaning as for stringViewToInt; a failed field stores 0 (or the saturated
+// value on overflow) and parsing goes on with the next one. A delimiter at
+// the very end of the buffer does not start an extra field.
+size_t stringParseInts(TStringView *rest, const char *delims, int64_t *out, uint8_t *errors, size_t capacity) {
+    if (!_stringColumnCheck(rest, delims, out)) return 0;
+    return _stringParseIntColumn(rest, delims, true, out, NULL, errors, capacity);
+}
+
+size_t stringParseUints(TStringView *rest, const char *delims, uint64_t *out, uint8_t *errors, size_t capacity) {
+    if (!_stringColumnCheck(rest, delims, out)) return 0;
+    return _stringParseIntColumn(rest, delims, false, NULL, out, errors, capacity);
+}
+
+size_t stringParseDoubles(TStringView *rest, const char *delims, double *out, uint8_t *errors, size_t capacity) {
+    if (!_stringColumnCheck(rest, delims, out)) return 0;
+    const TStringColumn col = _stringColumnInit(delims);
+    const char *p = rest->data;
+    const size_t n = rest->size;
+    size_t pos = 0;
+    size_t count = 0;
+    while (count < capacity && pos < n) {
+        TStringView field = {p + pos, n - pos};
+        size_t used = 0;
+        EErrorCode e = _stringParseDoublePrefix(field, &out[count], &used);
+        size_t end = pos + used;
+        if (end < n && !_stringColumnIsDelim(&col, p[end])) {
+            e = ERR_INVALID_NUMBER_REPR;
+            out[count] = 0;
+            end = _stringColumnFieldEnd(&col, p, n, end);
+        }
+        if (errors != NULL) errors[count] = (uint8_t)e;
+        ++count;
+        pos = end < n ? end + 1 : n;
+    }
+    _stringColumnAdvance(rest, pos);
+    return count;
+}
+
+#define STRING_READER_BLOCK (1 << 16)
+
+static const char READER_SPACES[] = " \t\n\r\v\f";
+static const uint8_t READER_SPACE_BITMAP[32] = {[1] = 0x3E, [4] = 0x01};
+
+void stringReaderInitFile(TStringReader *r, FILE *file) {
+    if (r == NULL || file == NULL) {
+        setError(ERR_NULL_POINTER);
+        return;
     }
+    clearError();
+    *r = (TStringReader){0};
+    r->file = file;
+    r->fd = -1;
+}
 
-    for (size_t i = 0; i < delimSize; ++i) {
-        res.data[s1.size + i] = delim[i];
+void stringReaderInitFd(TStringReader *r, int fd) {
+    if (r == NULL) {
+        setError(ERR_NULL_POINTER);
+        return;
     }
+    clearError();
+    *r = (TStringReader){0};
+    r->fd = fd;
+}
 
-    for (size_t i = 0; i < s2.size; ++i) {
-        res.data[s1.size + delimSize + i] = s2.data[i];
+// Moves the unread bytes to the front, grows the buffer if they fill it and
+// reads the next block behind them. False at the end of input or on error.
+bool _stringReaderFill(TStringReader *r) {
+    if (r->eof) return false;
+    if (r->begin > 0) {
+        memmove(r->buf, r->buf + r->begin, r->end - r->begin);
+        r->end -= r->begin;
+        r->begin = 0;
+    }
+    if (r->end == r->capacity) {
+        size_t cap = r->capacity == 0 ? STRING_READER_BLOCK : r->capacity * 2;
+        char *buf = (char *)realloc(r->buf, cap);
+        if (buf == NULL) {
+            setError(ERR_ALLOCATE_SPACE);
+            return false;
+        }
+        r->buf = buf;
+        r->capacity = cap;
+    }
+    size_t got = 0;
+    if (r->file != NULL) {
+        got = fread(r->buf + r->end, 1, r->capacity - r->end, r->file);
+        if (got == 0 && ferror(r->file)) setError(ERR_IO);
+    } else {
+#ifdef CSTRING_POSIX
+        ssize_t n;
+        do {
+            n = read(r->fd, r->buf + r->end, r->capacity - r->end);
+        } while (n < 0 && errno == EINTR);
+        if (n < 0) setError(ERR_IO);
+        got = n > 0 ? (size_t)n : 0;
+#else
+        setError(ERR_INVALID_STATE);
+#endif
     }
-    res.size = s1.size + delimSize + s2.size;
+    if (got == 0) {
+        r->eof = true;
+        return false;
+    }
+    r->end += got;
+    return true;
+}
 
-    return res;
+bool _stringReaderIsSpace(char c) {
+    return (READER_SPACE_BITMAP[(uint8_t)c >> 3] >> ((uint8_t)c & 7)) & 1;
 }
 
-TString stringArrJoin(const TString *s, size_t count, TString delim) {
-    if (s == NULL) {
+int64_t _stringReaderFind(const TStringReader *r, size_t from, bool line) {
+    size_t n = r->end - r->begin - from;
+    if (n == 0) return -1;
+    const char *p = r->buf + r->begin + from;
+    if (line) {
+        const char *c = (const char *)memchr(p, '\n', n);
+        return c == NULL ? -1 : (int64_t)(c - p + from);
+    }
+    int64_t found = _stringFindAnyOf(p, n, READER_SPACES, sizeof(READER_SPACES) - 1, READER_SPACE_BITMAP);
+    return found < 0 ? -1 : found + (int64_t)from;
+}
+
+// Copies buffered bytes into `out` up to the next newline or whitespace,
+// refilling the buffer as it drains. Returns false once nothing is left.
+bool _stringReadUntil(TStringReader *r, TString *out, bool line) {
+    out->size = 0;
+    bool got = false;
+    for (;;) {
+        int64_t found = _stringReaderFind(r, 0, line);
+        size_t len = found < 0 ? r->end - r->begin : (size_t)found;
+        if (len > 0) {
+            stringAppendChars(out, r->buf + r->begin, len);
+            if (isError()) return false;
+            got = true;
+        }
+        r->begin += len;
+        if (found >= 0) {
+            if (line) {
+                ++r->begin;
+                if (out->size > 0 && stringData(out)[out->size - 1] == '\r') --out->size;
+            }
+            return true;
+        }
+        if (!_stringReaderFill(r)) return got && !isError();
+    }
+}
+
+// Reads the next line without its "\n" or "\r\n" into `line`, reusing its
+// capacity. The last line does not need a newline. Returns false at the end
+// of input; ERR_IO is set if reading failed.
+bool stringReadLine(TStringReader *r, TString *line) {
+    if (r == NULL || line == NULL) {
         setError(ERR_NULL_POINTER);
-        return (TString){0};
+        return false;
     }
+    clearError();
+    return _stringReadUntil(r, line, true);
+}
 
+// Like stringReadLine, but without a copy: `line` points into the reader's
+// buffer and stays valid until the next read.
+bool stringReadLineView(TStringReader *r, TStringView *line) {
+    if (r == NULL || line == NULL) {
+        setError(ERR_NULL_POINTER);
+        return false;
+    }
     clearError();
-    size_t totalSize = 0;
-    for (size_t i = 0; i < count; ++i) {
-        totalSize += s[i].size;
-        if (i + 1 < count) totalSize += delim.size;
+    size_t scanned = 0;
+    int64_t found;
+    while ((found = _stringReaderFind(r, scanned, true)) < 0) {
+        scanned = r->end - r->begin;
+        if (!_stringReaderFill(r)) break;
     }
+    if (isError()) return false;
+    size_t len = found < 0 ? r->end - r->begin : (size_t)found;
+    if (found < 0 && len == 0) return false;
+    *line = (TStringView){r->buf + r->begin, len};
+    r->begin += len + (found >= 0);
+    if (found >= 0 && len > 0 && line->data[len - 1] == '\r') --line->size;
+    return true;
+}
 
-    TString res = stringInit(totalSize);
-    if (isError()) return (TString){0};
+// Reads the next run of non-whitespace bytes into `token`, reusing its
+// capacity. Returns false when only whitespace is left.
+bool stringReadToken(TStringReader *r, TString *token) {
+    if (r == NULL || token == NULL) {
+        setError(ERR_NULL_POINTER);
+        return false;
+    }
+    clearError();
+    for (;;) {
+        while (r->begin < r->end && _stringReaderIsSpace(r->buf[r->begin])) ++r->begin;
+        if (r->begin < r->end) break;
+        if (!_stringReaderFill(r)) {
+            token->size = 0;
+            return false;
+        }
+    }
+    return _stringReadUntil(r, token, false);
+}
 
-    size_t ind = 0;
-    for (size_t i = 0; i < count; ++i) {
-        for (size_t j = 0; j < s[i].size; ++j) {
-            res.data[ind++] = s[i].data[j];
+// Frees the buffer; the FILE* or descriptor stays open.
+void stringReaderDestroy(TStringReader *r) {
+    if (r == NULL) return;
+    free(r->buf);
+    *r = (TStringReader){0};
+    r->fd = -1;
+}
+
+bool _stringVecReserveItems(TStrVec *v, size_t capacity) {
+    if (capacity <= v->capacity) return true;
+    if (v->packed) {
+        // one extra slot holds the end offset of the last item
+        size_t *offsets = (size_t *)realloc(v->offsets, sizeof(size_t) * (capacity + 1));
+        if (offsets == NULL) {
+            setError(ERR_ALLOCATE_SPACE);
+            return false;
         }
-        if (i + 1 < count) {
-            for (size_t j = 0; j < delim.size; ++j) {
-                res.data[ind++] = delim.data[j];
-            }
+        if (v->offsets == NULL) offsets[0] = 0;
+        v->offsets = offsets;
+    } else {
+        TString *newData = (TString *)realloc(v->data, sizeof(TString) * capacity);
+        if (newData == NULL) {
+            setError(ERR_ALLOCATE_SPACE);
+            return false;
         }
+        v->data = newData;
+    }
+    v->capacity = capacity;
+    return true;
+}
+
+bool _stringVecReserveBytes(TStrVec *v, size_t bytes) {
+    if (bytes <= v->blobCapacity) return true;
+    char *blob = (char *)realloc(v->blob, bytes);
+    if (blob == NULL) {
+        setError(ERR_ALLOCATE_SPACE);
+        return false;
+    }
+    v->blob = blob;
+    v->blobCapacity = bytes;
+    return true;
+}
+
+void _stringVecPushPacked(TStrVec *v, const char *p, size_t n) {
+    if (v->size >= v->capacity && !_stringVecReserveItems(v, v->capacity > 0 ? v->capacity * 2 : 4)) return;
+    if (v->blobSize + n > v->blobCapacity) {
+        // p may point into the blob, which realloc can move. Comparing addresses
+        // as integers also keeps GCC's -Wuse-after-free from misfiring below.
+        size_t offset = (size_t)((uintptr_t)p - (uintptr_t)v->blob);
+        bool aliased = v->blob != NULL && offset < v->blobSize;
+        size_t bytes = v->blobCapacity * 2;
+        if (bytes < v->blobSize + n) bytes = v->blobSize + n;
+        if (!_stringVecReserveBytes(v, bytes)) return;
+        if (aliased) p = v->blob + offset;
+    }
+    if (n > 0) memcpy(v->blob + v->blobSize, p, n);
+    v->blobSize += n;
+    v->offsets[++v->size] = v->blobSize;
+}
+
+TStrVec stringVecInit(size_t capacity) {
+    clearError();
+    TStrVec v = {0};
+    _stringVecReserveItems(&v, capacity);
+    return v;
+}
+
+TStrVec stringVecInitPacked(size_t capacity, size_t bytes) {
+    clearError();
+    TStrVec v = {0};
+    v.packed = true;
+    if (!_stringVecReserveItems(&v, capacity > 0 ? capacity : 4)) return v;
+    _stringVecReserveBytes(&v, bytes);
+    return v;
+}
+
+// `bytes` is the blob size for packed vectors and is ignored otherwise.
+void stringVecReserve(TStrVec *v, size_t capacity, size_t bytes) {
+    if (v == NULL) {
+        setError(ERR_NULL_POINTER);
+        return;
+    }
+    clearError();
+    if (!_stringVecReserveItems(v, capacity)) return;
+    if (v->packed) _stringVecReserveBytes(v, bytes);
+}
+
+void stringVecPushBack(TStrVec *v, TString s) {
+    if (v == NULL) {
+        setError(ERR_NULL_POINTER);
+        return;
+    }
+    clearError();
+    if (v->packed) {
+        _stringVecPushPacked(v, stringData(&s), s.size);
+        return;
+    }
+    // copy first: s may be an inline string stored in v->data itself
+    TString copy = stringInit(s.size);
+    if (isError()) return;
+    if (s.size > 0) memcpy(stringData(&copy), stringData(&s), s.size);
+    copy.size = s.size;
+    if (v->size >= v->capacity && !_stringVecReserveItems(v, v->capacity > 0 ? v->capacity * 2 : 4)) {
+        stringDestroy(&copy);
+        return;
+    }
+    v->data[v->size++] = copy;
+}
+
+void stringVecPushBackCharArr(TStrVec *v, const char *s) {
+    if (s == NULL) {
+        setError(ERR_NULL_POINTER);
+        return;
+    }
+    TString view = {0};
+    view.data = (char *)s;
+    view.size = stringLenCharArr(s);
+    view.capacity = view.size;
+    stringVecPushBack(v, view);
+}
+
+void stringVecPushBackView(TStrVec *v, TStringView s) {
+    if (v != NULL && v->packed) {
+        clearError();
+        _stringVecPushPacked(v, s.data, s.size);
+        return;
+    }
+    TString view = {0};
+    view.data = (char *)s.data;
+    view.size = s.size;
+    view.capacity = s.size;
+    stringVecPushBack(v, view);
+}
+
+// Views into a packed vector are invalidated by any push that grows the blob.
+TStringView stringVecGet(const TStrVec *v, size_t i) {
+    if (v == NULL) {
+        setError(ERR_NULL_POINTER);
+        return (TStringView){0};
     }
-    res.size = totalSize;
+    if (i >= v->size) {
+        setError(ERR_BUFFER_OVERFLOW);
+        return (TStringView){0};
+    }
+    if (!v->packed) return stringViewOf(&v->data[i]);
+    TStringView res = {0};
+    res.data = v->blob + v->offsets[i];
+    res.size = v->offsets[i + 1] - v->offsets[i];
     return res;
 }
 
-TString stringArrJoinCharArr(const TString *s, size_t count, const char *delim) {
-    if (s == NULL || delim == NULL) {
+TStrVecIter stringVecIter(const TStrVec *v) {
+    TStrVecIter it = {0};
+    it.vec = v;
+    return it;
+}
+
+bool stringVecIterNext(TStrVecIter *it, TStringView *item) {
+    if (it == NULL || it->vec == NULL || item == NULL) {
         setError(ERR_NULL_POINTER);
-        return (TString){0};
+        return false;
+    }
+    if (it->pos >= it->vec->size) return false;
+    *item = stringVecGet(it->vec, it->pos++);
+    return true;
+}
+
+// Multikey quicksort over items that carry the next 8 bytes of their key as a
+// big-endian word, so one comparison covers 8 characters of a shared prefix.
+#define SORT_INSERTION_MAX 16
+
+typedef struct TStringSortItem {
+    const char *data;
+    size_t size;
+    size_t index;
+    uint64_t key;
+} TStringSortItem;
+
+uint64_t _stringSortKey(const char *p, size_t n, size_t depth, bool fold) {
+    uint64_t key = 0;
+    if (depth + 8 <= n) {
+        key = _stringLoad64(p + depth);
+    } else if (depth < n) {
+        memcpy(&key, p + depth, n - depth);
+    }
+    if (fold) key = _stringChangeCase64(key, 'A');
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    key = __builtin_bswap64(key);
+#endif
+    return key;
+}
+
+// Orders items that agree on their first `depth` bytes; equal keys keep input order.
+int _stringSortCompare(const TStringSortItem *a, const TStringSortItem *b, size_t depth, bool fold) {
+    if (depth < a->size && depth < b->size) {
+        int res = _stringCompareBuf(a->data + depth, a->size - depth, b->data + depth, b->size - depth, !fold);
+        if (res != 0) return res;
+    } else if (a->size != b->size) {
+        return a->size < b->size ? -1 : 1;
+    }
+    return a->index < b->index ? -1 : (a->index > b->index);
+}
+
+int _stringSortCompareLength(const void *x, const void *y) {
+    const TStringSortItem *a = (const TStringSortItem *)x;
+    const TStringSortItem *b = (const TStringSortItem *)y;
+    if (a->size != b->size) return a->size < b->size ? -1 : 1;
+    return a->index < b->index ? -1 : (a->index > b->index);
+}
+
+void _stringSortSwap(TStringSortItem *a, TStringSortItem *b) {
+    TStringSortItem tmp = *a;
+    *a = *b;
+    *b = tmp;
+}
+
+void _stringSortInsertion(TStringSortItem *a, size_t n, size_t depth, bool fold) {
+    for (size_t i = 1; i < n; ++i) {
+        TStringSortItem x = a[i];
+        size_t j = i;
+        while (j > 0 && _stringSortCompare(&x, &a[j - 1], depth, fold) < 0) {
+            a[j] = a[j - 1];
+            --j;
+        }
+        a[j] = x;
+    }
+}
+
+uint64_t _stringSortMedian(uint64_t a, uint64_t b, uint64_t c) {
+    if (a < b) {
+        if (b < c) return b;
+        return a < c ? c : a;
+    }
+    if (a < c) return a;
+    return b < c ? c : b;
+}
+
+// All items share the current 8-byte word. Those that end inside it differ
+// only in length: they are sorted and moved to the front. The rest get the
+// next word as their key. Returns how many ended.
+size_t _stringSortEqual(TStringSortItem *a, size_t n, size_t depth, bool fold) {
+    size_t ended = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (a[i].size - depth <= 8) _stringSortSwap(&a[i], &a[ended++]);
     }
+    if (ended > SORT_INSERTION_MAX) {
+        qsort(a, ended, sizeof(TStringSortItem), _stringSortCompareLength);
+    } else {
+        _stringSortInsertion(a, ended, depth, fold);
+    }
+    for (size_t i = ended; i < n; ++i) {
+        a[i].key = _stringSortKey(a[i].data, a[i].size, depth + 8, fold);
+    }
+    return ended;
+}
+
+void _stringSortRange(TStringSortItem *a, size_t n, size_t depth, bool fold) {
+    while (n > SORT_INSERTION_MAX) {
+        // ninther: Dijkstra partitioning leaves runs of sorted input rotated,
+        // which defeats a plain first/middle/last median
+        const size_t step = n / 8;
+        uint64_t pivot = _stringSortMedian(
+            _stringSortMedian(a[0].key, a[step].key, a[2 * step].key),
+            _stringSortMedian(a[3 * step].key, a[n / 2].key, a[5 * step].key),
+            _stringSortMedian(a[6 * step].key, a[7 * step].key, a[n - 1].key));
+        size_t lt = 0;
+        size_t i = 0;
+        size_t gt = n;
+        while (i < gt) {
+            if (a[i].key < pivot) {
+                _stringSortSwap(&a[lt++], &a[i++]);
+            } else if (a[i].key > pivot) {
+                _stringSortSwap(&a[i], &a[--gt]);
+            } else {
+                ++i;
+            }
+        }
+        // recurse into the two smaller parts and loop on the largest, so the
+        // stack stays O(log n) however long the shared prefixes are
+        TStringSortItem *eq = a + lt;
+        size_t eqSize = gt - lt;
+        if (eqSize >= lt && eqSize >= n - gt) {
+            _stringSortRange(a, lt, depth, fold);
+            _stringSortRange(a + gt, n - gt, depth, fold);
+            size_t ended = _stringSortEqual(eq, eqSize, depth, fold);
+            a = eq + ended;
+            n = eqSize - ended;
+            depth += 8;
+            continue;
+        }
+        size_t ended = _stringSortEqual(eq, eqSize, depth, fold);
+        _stringSortRange(eq + ended, eqSize - ended, depth + 8, fold);
+        if (lt < n - gt) {
+            _stringSortRange(a, lt, depth, fold);
+            a += gt;
+            n -= gt;
+        } else {
+            _stringSortRange(a + gt, n - gt, depth, fold);
+            n = lt;
+        }
+    }
+    _stringSortInsertion(a, n, depth, fold);
+}
 
+void _stringVecSort(TStrVec *v, bool fold) {
+    if (v == NULL) {
+        setError(ERR_NULL_POINTER);
+        return;
+    }
     clearError();
-    size_t totalSize = 0;
-    size_t delimSize = stringLenCharArr(delim);
-    for (size_t i = 0; i < count; ++i) {
-        totalSize += s[i].size;
-        if (i + 1 < count) totalSize += delimSize;
+    const size_t n = v->size;
+    if (n < 2) return;
+    TStringSortItem *items = (TStringSortItem *)malloc(sizeof(TStringSortItem) * n);
+    if (items == NULL) {
+        setError(ERR_ALLOCATE_SPACE);
+        return;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        TStringView item = stringVecGet(v, i);
+        items[i].data = item.data;
+        items[i].size = item.size;
+        items[i].index = i;
+        items[i].key = _stringSortKey(item.data, item.size, 0, fold);
     }
+    _stringSortRange(items, n, 0, fold);
+
+    if (v->packed) {
+        char *blob = (char *)malloc(v->blobCapacity > 0 ? v->blobCapacity : 1);
+        if (blob == NULL) {
+            setError(ERR_ALLOCATE_SPACE);
+            free(items);
+            return;
+        }
+        size_t pos = 0;
+        for (size_t i = 0; i < n; ++i) {
+            if (items[i].size > 0) memcpy(blob + pos, items[i].data, items[i].size);
+            v->offsets[i] = pos;
+            pos += items[i].size;
+        }
+        v->offsets[n] = pos;
+        free(v->blob);
+        v->blob = blob;
+    } else {
+        TString *sorted = (TString *)malloc(sizeof(TString) * n);
+        if (sorted == NULL) {
+            setError(ERR_ALLOCATE_SPACE);
+            free(items);
+            return;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            sorted[i] = v->data[items[i].index];
+        }
+        memcpy(v->data, sorted, sizeof(TString) * n);
+        free(sorted);
+    }
+    free(items);
+}
 
-    TString res = stringInit(totalSize);
-    if (isError()) return (TString){0};
+// Both sorts are stable and order bytes as unsigned, shorter prefixes first.
+void stringVecSort(TStrVec *v) {
+    _stringVecSort(v, false);
+}
 
-    size_t ind = 0;
-    for (size_t i = 0; i < count; ++i) {
-        for (size_t j = 0; j < s[i].size; ++j) {
-            res.data[ind++] = s[i].data[j];
+void stringVecSortIgnoreCase(TStrVec *v) {
+    _stringVecSort(v, true);
+}
+
+// Drops every item but keeps the allocated storage for reuse.
+void stringVecClear(TStrVec *v) {
+    if (v == NULL) return;
+    if (!v->packed) {
+        for (size_t i = 0; i < v->size; ++i) {
+            stringDestroy(&v->data[i]);
+        }
+    }
+    v->size = 0;
+    v->blobSize = 0;
+}
+
+void stringVecDestroy(TStrVec *v) {
+    if (v == NULL) return;
+    stringVecClear(v);
+    free(v->data);
+    free(v->blob);
+    free(v->offsets);
+    *v = (TStrVec){0};
+}
+
+#define STRVEC_WRITE_IOVECS 512
+
+#ifdef CSTRING_POSIX
+bool _stringWritevAll(int fd, struct iovec *iov, size_t count) {
+    while (count > 0) {
+        ssize_t written = writev(fd, iov, (int)count);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            setError(ERR_IO);
+            return false;
+        }
+        size_t left = (size_t)written;
+        while (count > 0 && left >= iov->iov_len) {
+            left -= iov->iov_len;
+            ++iov;
+            --count;
+        }
+        if (count > 0) {
+            iov->iov_base = (char *)iov->iov_base + left;
+            iov->iov_len -= left;
+        }
+    }
+    return true;
+}
+#endif
+
+// Writes the items separated by `delim` (which may be empty), like
+// stringArrJoin but without building the joined string: the pieces go out
+// in writev batches. A packed vector without a delimiter is a single write.
+bool stringVecWriteFd(int fd, const TStrVec *v, TStringView delim) {
+    if (v == NULL || (delim.data == NULL && delim.size > 0)) {
+        setError(ERR_NULL_POINTER);
+        return false;
+    }
+    clearError();
+    if (v->packed && delim.size == 0) return _stringWriteAllFd(fd, v->blob, v->blobSize);
+#ifdef CSTRING_POSIX
+    struct iovec iov[STRVEC_WRITE_IOVECS];
+    size_t count = 0;
+    for (size_t i = 0; i < v->size; ++i) {
+        TStringView item = stringVecGet(v, i);
+        if (i > 0 && delim.size > 0) iov[count++] = (struct iovec){(void *)delim.data, delim.size};
+        if (item.size > 0) iov[count++] = (struct iovec){(void *)item.data, item.size};
+        if (count + 2 > STRVEC_WRITE_IOVECS) {
+            if (!_stringWritevAll(fd, iov, count)) return false;
+            count = 0;
+        }
+    }
+    return _stringWritevAll(fd, iov, count);
+#else
+    setError(ERR_INVALID_STATE);
+    return false;
+#endif
+}
+
+// The stdio counterpart of stringVecWriteFd: the stream is locked once for
+// all the pieces instead of once per call. Without CSTRING_STDIO_LOCKING the
+// pieces are written one fwrite at a time and writes from other threads may
+// interleave with them.
+bool stringVecWriteFile(FILE *file, const TStrVec *v, TStringView delim) {
+    if (file == NULL || v == NULL || (delim.data == NULL && delim.size > 0)) {
+        setError(ERR_NULL_POINTER);
+        return false;
+    }
+    clearError();
+    if (v->packed && delim.size == 0) {
+        if (v->blobSize > 0 && fwrite(v->blob, 1, v->blobSize, file) != v->blobSize) {
+            setError(ERR_IO);
+            return false;
+        }
+        return true;
+    }
+#ifdef CSTRING_STDIO_LOCKING
+    flockfile(file);
+#endif
+    bool ok = true;
+    for (size_t i = 0; i < v->size && ok; ++i) {
+        TStringView item = stringVecGet(v, i);
+        if (i > 0 && delim.size > 0) ok = fwrite(delim.data, 1, delim.size, file) == delim.size;
+        if (ok && item.size > 0) ok = fwrite(item.data, 1, item.size, file) == item.size;
+    }
+#ifdef CSTRING_STDIO_LOCKING
+    funlockfile(file);
+#endif
+    if (!ok) setError(ERR_IO);
+    return ok;
+}
+
+// Renumbers states so that every state with something to report comes after
+// all silent ones, and stores transitions as row offsets. The matching loop then
+// needs neither a multiply nor a second table load to detect a match.
+bool _stringMultiMatcherFinalize(TStringMultiMatcher *m) {
+    const size_t numStates = m->numStates;
+    const size_t numClasses = m->numClasses;
+    int32_t *newId = (int32_t *)malloc(sizeof(int32_t) * numStates);
+    int32_t *delta = (int32_t *)malloc(sizeof(int32_t) * numStates * numClasses);
+    int32_t *emit = (int32_t *)malloc(sizeof(int32_t) * numStates);
+    int32_t *dictLink = (int32_t *)malloc(sizeof(int32_t) * numStates);
+    int32_t *output = (int32_t *)malloc(sizeof(int32_t) * numStates);
+    if (newId == NULL || delta == NULL || emit == NULL || dictLink == NULL || output == NULL) {
+        free(newId);
+        free(delta);
+        free(emit);
+        free(dictLink);
+        free(output);
+        return false;
+    }
+
+    int32_t next = 0;
+    for (size_t i = 0; i < numStates; ++i) {
+        if (m->emit[i] < 0) newId[i] = next++;
+    }
+    m->firstEmitRow = (size_t)next * numClasses;
+    for (size_t i = 0; i < numStates; ++i) {
+        if (m->emit[i] >= 0) newId[i] = next++;
+    }
+
+    for (size_t i = 0; i < numStates; ++i) {
+        size_t id = (size_t)newId[i];
+        for (size_t c = 0; c < numClasses; ++c) {
+            delta[id * numClasses + c] = newId[m->delta[i * numClasses + c]] * (int32_t)numClasses;
+        }
+        emit[id] = m->emit[i] >= 0 ? newId[m->emit[i]] : -1;
+        dictLink[id] = m->dictLink[i] >= 0 ? newId[m->dictLink[i]] : -1;
+        output[id] = m->output[i];
+    }
+
+    free(newId);
+    free(m->delta);
+    free(m->emit);
+    free(m->dictLink);
+    free(m->output);
+    m->delta = delta;
+    m->emit = emit;
+    m->dictLink = dictLink;
+    m->output = output;
+    return true;
+}
+
+// Aho-Corasick automaton. Bytes are compressed into equivalence classes (class 0
+// is "not in any pattern"), and the failure function is folded into a dense
+// numStates x numClasses DFA so matching costs one table load per byte.
+// emit[state] is the state itself if a pattern ends there, otherwise the nearest
+// state on its suffix chain that ends a pattern, or -1; dictLink[state] is the
+// same lookup starting from the failure state.
+TStringMultiMatcher stringMultiMatcherCompile(TStrVec patterns, bool caseSensitive) {
+    clearError();
+    TStringMultiMatcher m = {0};
+    size_t maxStates = 1;
+    for (size_t i = 0; i < patterns.size; ++i) {
+        maxStates += stringVecGet(&patterns, i).size;
+    }
+    if (maxStates > INT32_MAX || patterns.size > INT32_MAX) {
+        setError(ERR_BUFFER_OVERFLOW);
+        return m;
+    }
+
+    m.numClasses = 1;
+    for (size_t i = 0; i < patterns.size; ++i) {
+        TStringView p = stringVecGet(&patterns, i);
+        for (size_t j = 0; j < p.size; ++j) {
+            uint8_t c = (uint8_t)p.data[j];
+            if (!caseSensitive) c = (uint8_t)stringCharToLower((char)c);
+            if (m.classes[c] == 0) {
+                m.classes[c] = (uint8_t)m.numClasses++;
+            }
+        }
+    }
+    if (!caseSensitive) {
+        for (int c = 'A'; c <= 'Z'; ++c) {
+            m.classes[c] = m.classes[c - 'A' + 'a'];
+        }
+    }
+
+    const size_t numClasses = m.numClasses;
+    if (maxStates * numClasses > INT32_MAX) {
+        setError(ERR_BUFFER_OVERFLOW);
+        return (TStringMultiMatcher){0};
+    }
+    m.delta = (int32_t *)malloc(sizeof(int32_t) * maxStates * numClasses);
+    m.output = (int32_t *)malloc(sizeof(int32_t) * maxStates);
+    m.emit = (int32_t *)malloc(sizeof(int32_t) * maxStates);
+    m.dictLink = (int32_t *)malloc(sizeof(int32_t) * maxStates);
+    m.sameNext = (int32_t *)malloc(sizeof(int32_t) * (patterns.size + 1));
+    m.patternLens = (size_t *)malloc(sizeof(size_t) * (patterns.size + 1));
+    int32_t *fail = (int32_t *)malloc(sizeof(int32_t) * maxStates);
+    int32_t *queue = (int32_t *)malloc(sizeof(int32_t) * maxStates);
+    if (m.delta == NULL || m.output == NULL || m.emit == NULL || m.dictLink == NULL || m.sameNext == NULL ||
+        m.patternLens == NULL || fail == NULL || queue == NULL) {
+        free(fail);
+        free(queue);
+        stringMultiMatcherDestroy(&m);
+        setError(ERR_ALLOCATE_SPACE);
+        return m;
+    }
+
+    for (size_t i = 0; i < numClasses; ++i) {
+        m.delta[i] = -1;
+    }
+    m.output[0] = -1;
+    m.numStates = 1;
+    m.numPatterns = patterns.size;
+    for (size_t i = 0; i < patterns.size; ++i) {
+        TStringView p = stringVecGet(&patterns, i);
+        const char *pData = p.data;
+        int32_t state = 0;
+        m.patternLens[i] = p.size;
+        m.sameNext[i] = -1;
+        // an empty pattern never reports a match
+        if (p.size == 0) continue;
+        for (size_t j = 0; j < p.size; ++j) {
+            int32_t *edge = &m.delta[(size_t)state * numClasses + m.classes[(uint8_t)pData[j]]];
+            if (*edge < 0) {
+                int32_t next = (int32_t)m.numStates++;
+                for (size_t k = 0; k < numClasses; ++k) {
+                    m.delta[(size_t)next * numClasses + k] = -1;
+                }
+                m.output[next] = -1;
+                *edge = next;
+            }
+            state = *edge;
+        }
+        // identical patterns share a state and are chained in insertion order
+        if (m.output[state] < 0) {
+            m.output[state] = (int32_t)i;
+        } else {
+            int32_t last = m.output[state];
+            while (m.sameNext[last] >= 0) last = m.sameNext[last];
+            m.sameNext[last] = (int32_t)i;
+        }
+    }
+
+    size_t head = 0;
+    size_t tail = 0;
+    fail[0] = 0;
+    m.emit[0] = -1;
+    m.dictLink[0] = -1;
+    for (size_t c = 0; c < numClasses; ++c) {
+        int32_t child = m.delta[c];
+        if (child < 0) {
+            m.delta[c] = 0;
+        } else {
+            fail[child] = 0;
+            m.emit[child] = m.output[child] >= 0 ? child : -1;
+            m.dictLink[child] = -1;
+            queue[tail++] = child;
         }
-        if (i + 1 < count) {
-            for (size_t j = 0; j < delimSize; ++j) {
-                res.data[ind++] = delim[j];
+    }
+    while (head < tail) {
+        int32_t state = queue[head++];
+        int32_t *row = &m.delta[(size_t)state * numClasses];
+        const int32_t *failRow = &m.delta[(size_t)fail[state] * numClasses];
+        for (size_t c = 0; c < numClasses; ++c) {
+            int32_t child = row[c];
+            if (child < 0) {
+                row[c] = failRow[c];
+            } else {
+                fail[child] = failRow[c];
+                m.dictLink[child] = m.emit[fail[child]];
+                m.emit[child] = m.output[child] >= 0 ? child : m.dictLink[child];
+                queue[tail++] = child;
             }
         }
     }
-    res.size = totalSize;
-    return res;
+    free(fail);
+    free(queue);
+
+    if (!_stringMultiMatcherFinalize(&m)) {
+        stringMultiMatcherDestroy(&m);
+        setError(ERR_ALLOCATE_SPACE);
+    }
+    return m;
 }
 
-TString stringSubstring(TString s, size_t pos, size_t len) {
-    clearError();
-    TString res = stringInit(len);
-    if (isError()) return (TString){0};
-    for (size_t i = 0; i < len && pos + i < s.size; ++i) {
-        res.data[i] = s.data[pos + i];
+void _stringMultiMatcherReport(const TStringMultiMatcher *m, int32_t state, size_t end,
+                               void (*onMatch)(TStringMatch, void *), void *ctx, size_t *count) {
+    for (int32_t t = m->emit[state]; t >= 0; t = m->dictLink[t]) {
+        for (int32_t pid = m->output[t]; pid >= 0; pid = m->sameNext[pid]) {
+            ++*count;
+            if (onMatch != NULL) {
+                TStringMatch match = {end - m->patternLens[pid], (size_t)pid};
+                onMatch(match, ctx);
+            }
+        }
     }
-    res.size = len;
-    return res;
 }
 
-char* stringConvertToCharArr(TString s) {
-    if (s.data == NULL)
-        return NULL;
-
-    clearError();
-    char *res = (char *)malloc(s.size + 1);
-
-    if (res == NULL) {
+bool stringMultiMatcherFindFirst(const TStringMultiMatcher *m, TString s, TStringMatch *match) {
+    if (m == NULL || match == NULL) {
         setError(ERR_NULL_POINTER);
-        return NULL;
+        return false;
     }
-    memcpy(res, s.data, s.size * sizeof(char));
-    res[s.size] = '\0';
-    return res;
+    if (m->delta == NULL) return false;
+    const int32_t *delta = m->delta;
+    const char *data = stringData(&s);
+    size_t row = 0;
+    for (size_t i = 0; i < s.size; ++i) {
+        row = (size_t)delta[row + m->classes[(uint8_t)data[i]]];
+        if (row >= m->firstEmitRow) {
+            // the emitting state nearest to the current one is the longest match ending here
+            int32_t t = m->emit[row / m->numClasses];
+            match->pattern = (size_t)m->output[t];
+            match->pos = i + 1 - m->patternLens[match->pattern];
+            return true;
+        }
+    }
+    return false;
 }
 
-void stringScan(TString *s) {
-    if (s == NULL) {
+size_t stringMultiMatcherFindAll(const TStringMultiMatcher *m, TString s,
+                                 void (*onMatch)(TStringMatch, void *), void *ctx) {
+    if (m == NULL) {
         setError(ERR_NULL_POINTER);
-        return;
-    }
-    clearError();
-    stringDestroy(s);
-    char c = getchar();
-    while ((c == ' ' || c == '\n' || c == '\t') && c != EOF) {
-        c = getchar();
+        return 0;
     }
-    if (c == EOF) {
-        setError(ERR_EOF_NOT_EXPECTED);
-        return;
+    size_t count = 0;
+    if (m->delta == NULL) return 0;
+    const int32_t *delta = m->delta;
+    const char *data = stringData(&s);
+    size_t row = 0;
+    for (size_t i = 0; i < s.size; ++i) {
+        row = (size_t)delta[row + m->classes[(uint8_t)data[i]]];
+        if (row >= m->firstEmitRow) {
+            _stringMultiMatcherReport(m, (int32_t)(row / m->numClasses), i + 1, onMatch, ctx, &count);
+        }
     }
+    return count;
+}
 
-    while (c != EOF &&
-           c != '\n' &&
-           c != ' ' &&
-           c != '\t') {
-        stringPushBack(s, c);
-        if (isError()) return;
-        c = getchar();
-    }
+void stringMultiMatcherDestroy(TStringMultiMatcher *m) {
+    if (m == NULL) return;
+    free(m->delta);
+    free(m->emit);
+    free(m->dictLink);
+    free(m->output);
+    free(m->sameNext);
+    free(m->patternLens);
+    *m = (TStringMultiMatcher){0};
 }
 
-void stringPrint(TString s) {
-    if (s.data == NULL) return;
-    for (size_t i = 0; i < s.size; ++i) {
-        putchar(s.data[i]);
+#define INTERN_FIRST_BLOCK 64
+#define INTERN_MIN_SLOTS 64
+#define INTERN_ARENA_CHUNK (1 << 16)
+
+struct TStringInternEntry {
+    uint64_t hash;
+    size_t size;
+    TStringAtom atom;
+    char data[];
+};
+
+struct TStringInternTable {
+    size_t mask;
+    TStringInternTable *retired;
+    _Atomic(TStringInternEntry *) slots[];
+};
+
+// Block b holds INTERN_FIRST_BLOCK << b entries.
+size_t _stringInternBlock(size_t index, size_t *offset) {
+    size_t block = 0;
+    size_t size = INTERN_FIRST_BLOCK;
+    while (index >= size) {
+        index -= size;
+        size <<= 1;
+        ++block;
     }
+    *offset = index;
+    return block;
 }
 
-void stringDebug(TString s) {
-    if (s.data == NULL) {
-        printf("[NULL, size = %zu, cap = %zu]\n", s.size, s.capacity);
-        return;
-    } else {
-        printf("[");
-        stringPrint(s);
-        printf(", size = %zu, cap = %zu]\n", s.size, s.capacity);
+TStringInternEntry *_stringInternProbe(TStringInternTable *table, uint64_t hash, TStringView s, size_t *slot) {
+    size_t i = (size_t)hash & table->mask;
+    for (;;) {
+        TStringInternEntry *e = atomic_load_explicit(&table->slots[i], memory_order_acquire);
+        if (e == NULL) {
+            if (slot != NULL) *slot = i;
+            return NULL;
+        }
+        if (e->hash == hash && e->size == s.size && _stringEqualBuf(e->data, s.data, s.size)) return e;
+        i = (i + 1) & table->mask;
     }
 }
 
-void stringRemoveChar(TString *s, char c) {
-    size_t newSize = 0;
-    for (size_t i = 0; i < s->size; ++i) {
-        if (s->data[i] != c) {
-            s->data[newSize] = s->data[i];
-            ++newSize;
+// Publishes a table twice as large. Readers may still be probing the old
+// one, so it is kept on the retired list until the interner is destroyed.
+bool _stringInternGrow(TStringInternShard *shard, TStringInternTable *old) {
+    size_t slots = old != NULL ? (old->mask + 1) * 2 : INTERN_MIN_SLOTS;
+    TStringInternTable *table = (TStringInternTable *)calloc(1, sizeof(TStringInternTable) + slots * sizeof(table->slots[0]));
+    if (table == NULL) return false;
+    table->mask = slots - 1;
+    if (old != NULL) {
+        for (size_t i = 0; i <= old->mask; ++i) {
+            TStringInternEntry *e = atomic_load_explicit(&old->slots[i], memory_order_relaxed);
+            if (e == NULL) continue;
+            size_t j = (size_t)e->hash & table->mask;
+            while (atomic_load_explicit(&table->slots[j], memory_order_relaxed) != NULL) {
+                j = (j + 1) & table->mask;
+            }
+            atomic_store_explicit(&table->slots[j], e, memory_order_relaxed);
         }
+        old->retired = shard->retired;
+        shard->retired = old;
     }
-    s->size = newSize;
+    atomic_store_explicit(&shard->table, table, memory_order_release);
+    return true;
 }
 
-void stringSwap(TString *s1, TString *s2) {
-    if (s1 == NULL || s2 == NULL) {
-        setError(ERR_NULL_POINTER);
-        return;
-    }
-    TString tmp = *s1;
-    *s1 = *s2;
-    *s2 = tmp;
+// Spin-wait hint for the shard lock: it frees the core for the sibling
+// hyperthread and avoids a pipeline flush when the lock is released.
+void _stringCpuRelax() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_ia32_pause();
+#elif defined(__GNUC__) && (defined(__aarch64__) || defined(__arm__))
+    __asm__ __volatile__("yield");
+#endif
 }
 
-void stringPushBack(TString *s, char c) {
-    if (s == NULL) {
-        setError(ERR_NULL_POINTER);
-        return;
+// Called with the shard lock held. The entry and its atom block are filled in
+// before the slot is published, so a reader that sees the slot sees both.
+TStringAtom _stringInternInsert(TStringInternShard *shard, size_t shardIndex, uint64_t hash, TStringView s) {
+    TStringInternTable *table = atomic_load_explicit(&shard->table, memory_order_relaxed);
+    size_t count = atomic_load_explicit(&shard->count, memory_order_relaxed);
+    size_t slot = 0;
+    if (table != NULL) {
+        TStringInternEntry *e = _stringInternProbe(table, hash, s, &slot);
+        if (e != NULL) return e->atom;
     }
-
-    clearError();
-    if (s->data == NULL) {
-        *s = stringInit(10);
-        if (isError()) return;
+    if (count >= (STRING_ATOM_INVALID >> INTERN_SHARD_BITS)) {
+        setError(ERR_BUFFER_OVERFLOW);
+        return STRING_ATOM_INVALID;
     }
-
-    if (s->size >= s->capacity) {
-        stringIncreaseCap(s);
+    if (table == NULL || (count + 1) * 2 > table->mask + 1) {
+        if (!_stringInternGrow(shard, table)) {
+            setError(ERR_ALLOCATE_SPACE);
+            return STRING_ATOM_INVALID;
+        }
+        table = atomic_load_explicit(&shard->table, memory_order_relaxed);
+        _stringInternProbe(table, hash, s, &slot);
     }
 
-    s->data[s->size] = c;
-    s->size++;
-}
-
-void stringPushFront(TString *s, char c) {
-    stringReverse(s);
-    stringPushBack(s, c);
-    stringReverse(s);
+    size_t offset = 0;
+    size_t block = _stringInternBlock(count, &offset);
+    TStringInternEntry **entries = atomic_load_explicit(&shard->blocks[block], memory_order_relaxed);
+    if (entries == NULL) {
+        entries = (TStringInternEntry **)malloc(sizeof(TStringInternEntry *) * ((size_t)INTERN_FIRST_BLOCK << block));
+        if (entries == NULL) {
+            setError(ERR_ALLOCATE_SPACE);
+            return STRING_ATOM_INVALID;
+        }
+        atomic_store_explicit(&shard->blocks[block], entries, memory_order_release);
+    }
+    TStringInternEntry *e = (TStringInternEntry *)_stringArenaAllocate(&shard->arena, sizeof(TStringInternEntry) + s.size);
+    if (e == NULL) {
+        setError(ERR_ALLOCATE_SPACE);
+        return STRING_ATOM_INVALID;
+    }
+    e->hash = hash;
+    e->size = s.size;
+    e->atom = (TStringAtom)((count << INTERN_SHARD_BITS) | shardIndex);
+    if (s.size > 0) memcpy(e->data, s.data, s.size);
+    entries[offset] = e;
+    atomic_store_explicit(&shard->count, count + 1, memory_order_release);
+    atomic_store_explicit(&table->slots[slot], e, memory_order_release);
+    return e->atom;
 }
 
-void stringPopBack(TString *s) {
-    if (s == NULL) {
+void stringInternerInit(TStringInterner *in) {
+    if (in == NULL) {
         setError(ERR_NULL_POINTER);
         return;
     }
-    if (stringIsEmpty(*s)) {
-        setError(ERR_EMPTY_STRING_POP);
-        return;
+    for (size_t i = 0; i < INTERN_SHARDS; ++i) {
+        TStringInternShard *shard = &in->shards[i];
+        atomic_flag_clear(&shard->lock);
+        atomic_init(&shard->table, NULL);
+        for (size_t b = 0; b < INTERN_MAX_BLOCKS; ++b) {
+            atomic_init(&shard->blocks[b], NULL);
+        }
+        atomic_init(&shard->count, 0);
+        shard->retired = NULL;
+        stringArenaInit(&shard->arena, INTERN_ARENA_CHUNK, NULL);
     }
-    --(s->size);
+    clearError();
 }
 
-void stringPopFront(TString *s) {
-    if (s == NULL) {
+// Returns the atom of the canonical copy of `s`, storing one on first sight.
+// Safe to call from several threads at once; lookups of strings that are
+// already interned take no lock.
+TStringAtom stringIntern(TStringInterner *in, TStringView s) {
+    if (in == NULL || (s.data == NULL && s.size > 0)) {
         setError(ERR_NULL_POINTER);
-        return;
+        return STRING_ATOM_INVALID;
     }
-    if (stringIsEmpty(*s)) {
-        setError(ERR_EMPTY_STRING_POP);
-        return;
+    uint64_t hash = _stringHash(s.data, s.size, 0);
+    size_t shardIndex = (size_t)(hash >> (64 - INTERN_SHARD_BITS));
+    TStringInternShard *shard = &in->shards[shardIndex];
+    TStringInternTable *table = atomic_load_explicit(&shard->table, memory_order_acquire);
+    if (table != NULL) {
+        TStringInternEntry *e = _stringInternProbe(table, hash, s, NULL);
+        if (e != NULL) return e->atom;
     }
-    for (size_t i = 1; i < s->size; ++i) {
-        s->data[i - 1] = s->data[i];
+    while (atomic_flag_test_and_set_explicit(&shard->lock, memory_order_acquire)) {
+        _stringCpuRelax();
     }
-    --(s->size);
+    TStringAtom res = _stringInternInsert(shard, shardIndex, hash, s);
+    atomic_flag_clear_explicit(&shard->lock, memory_order_release);
+    return res;
 }
 
-void stringTrimLeft(TString *s) {
-    if (s == NULL || s->size == 0) return;
-
-    size_t start = 0;
-    while (start < s->size && stringCharOneOf(s->data[start], " \t\n")) {
-        ++start;
+bool stringInternFind(TStringInterner *in, TStringView s, TStringAtom *atom) {
+    if (in == NULL || atom == NULL || (s.data == NULL && s.size > 0)) {
+        setError(ERR_NULL_POINTER);
+        return false;
     }
+    uint64_t hash = _stringHash(s.data, s.size, 0);
+    TStringInternShard *shard = &in->shards[hash >> (64 - INTERN_SHARD_BITS)];
+    TStringInternTable *table = atomic_load_explicit(&shard->table, memory_order_acquire);
+    if (table == NULL) return false;
+    TStringInternEntry *e = _stringInternProbe(table, hash, s, NULL);
+    if (e == NULL) return false;
+    *atom = e->atom;
+    return true;
+}
 
-    for (size_t i = 0; i + start < s->size; ++i) {
-        s->data[i] = s->data[i + start];
+TStringView stringInternGet(TStringInterner *in, TStringAtom atom) {
+    if (in == NULL) {
+        setError(ERR_NULL_POINTER);
+        return (TStringView){0};
     }
-    s->size -= start;
+    TStringInternShard *shard = &in->shards[atom & (INTERN_SHARDS - 1)];
+    size_t index = atom >> INTERN_SHARD_BITS;
+    if (atom == STRING_ATOM_INVALID || index >= atomic_load_explicit(&shard->count, memory_order_acquire)) {
+        setError(ERR_BUFFER_OVERFLOW);
+        return (TStringView){0};
+    }
+    size_t offset = 0;
+    size_t block = _stringInternBlock(index, &offset);
+    TStringInternEntry **entries = atomic_load_explicit(&shard->blocks[block], memory_order_acquire);
+    TStringInternEntry *e = entries[offset];
+    TStringView res = {0};
+    res.data = e->data;
+    res.size = e->size;
+    return res;
 }
 
-void stringTrimRight(TString *s) {
-    if (s == NULL || s->size == 0) return;
+size_t stringInternerSize(TStringInterner *in) {
+    if (in == NULL) return 0;
+    size_t res = 0;
+    for (size_t i = 0; i < INTERN_SHARDS; ++i) {
+        res += atomic_load_explicit(&in->shards[i].count, memory_order_acquire);
+    }
+    return res;
+}
 
-    int end = s->size - 1;
-    while (end >= 0 && stringCharOneOf(s->data[end], " \t\n")) {
-        --end;
+// Must not race with any other call on the same interner.
+void stringInternerDestroy(TStringInterner *in) {
+    if (in == NULL) return;
+    for (size_t i = 0; i < INTERN_SHARDS; ++i) {
+        TStringInternShard *shard = &in->shards[i];
+        free(atomic_load_explicit(&shard->table, memory_order_relaxed));
+        while (shard->retired != NULL) {
+            TStringInternTable *next = shard->retired->retired;
+            free(shard->retired);
+            shard->retired = next;
+        }
+        for (size_t b = 0; b < INTERN_MAX_BLOCKS; ++b) {
+            free(atomic_load_explicit(&shard->blocks[b], memory_order_relaxed));
+            atomic_store_explicit(&shard->blocks[b], NULL, memory_order_relaxed);
+        }
+        atomic_store_explicit(&shard->table, NULL, memory_order_relaxed);
+        atomic_store_explicit(&shard->count, 0, memory_order_relaxed);
+        stringArenaDestroy(&shard->arena);
     }
-    s->size = (end + 1);
 }
 
-void stringTrim(TString *s) {
-    stringTrimRight(s);
-    stringTrimLeft(s);
+uint64_t stringHash(TString s) {
+    return _stringHash(stringData(&s), s.size, 0);
 }
 
-void stringPadRight(TString *s, size_t newLen, char padChar) {
+uint64_t stringHashCharArr(const char *s) {
     if (s == NULL) {
         setError(ERR_NULL_POINTER);
-        return;
-    }
-    if (s->size >= newLen) return;
-    while (s->size < newLen) {
-        clearError();
-        stringPushBack(s, padChar);
-        if (isError()) return;
+        return 0;
     }
-    s->size = newLen;
+    return _stringHash(s, strlen(s), 0);
 }
 
-void stringPadLeft(TString *s, size_t newLen, char padChar) {
-    if (s == NULL) {
+uint64_t stringHashWithSeed(const char *p, size_t n, uint64_t seed) {
+    if (p == NULL && n > 0) {
         setError(ERR_NULL_POINTER);
-        return;
+        return 0;
     }
-    if (s->size >= newLen) return;
-    stringReverse(s);
-    stringPadRight(s, newLen, padChar);
-    stringReverse(s);
+    return _stringHash(p, n, seed);
 }
 
-void stringReplaceAll(TString *s, const char *oldS, const char *newS) {
-    if (s == NULL || s->size == 0 || newS == NULL || stringFindFirstCharArr(*s, oldS) < 0) return;
+uint64_t stringViewHash(TStringView s) {
+    return stringHashWithSeed(s.data, s.size, 0);
+}
 
-    TString res = {0};
-    size_t pos = 0;
-    TString copy = stringCopy(*s);
-    size_t newSubstrLen = stringLenCharArr(newS);
-    size_t oldSubstrLen = stringLenCharArr(oldS);
-    clearError();
-    while (pos != s->size) {
-        int64_t substrPos = stringFindFirstCharArr(copy, oldS);
-
-        if (substrPos < 0) {
-            for (size_t i = pos; i < s->size; ++i) {
-                stringPushBack(&res, s->data[i]);
-                if (isError()) {
-                    stringDestroy(&res);
-                    return;
-                }
-            }
-            break;
-        }
+#define MAP_GROUP 16
+#define MAP_EMPTY ((int8_t)-128)
+#define MAP_DELETED ((int8_t)-2)
+#define MAP_MIN_CAPACITY 16
 
-        for (int64_t i = 0; i < substrPos; ++i) {
-            stringPushBack(&res, copy.data[i]);
-            if (isError()) {
-                stringDestroy(&res);
-                return;
-            }
-        }
+size_t _stringMapMaxLoad(size_t capacity) {
+    return capacity - capacity / 8;
+}
 
-        for (size_t i = 0; i < newSubstrLen; ++i) {
-            stringPushBack(&res, newS[i]);
-            if (isError()) {
-                stringDestroy(&res);
-                return;
-            }
-        }
-        pos += oldSubstrLen + substrPos;
-        copy.data += oldSubstrLen + substrPos;
-        copy.size -= oldSubstrLen + substrPos;
-        copy.capacity -= oldSubstrLen + substrPos;
-    }
-    stringDestroy(s);
-    *s = res;
+// Bit i of each result is set when control byte i of the group qualifies.
+// Without SSE2 the 16 bytes are handled as two words; _stringMapMatch may then
+// report false positives, which the key comparison filters out.
+#if defined(CSTRING_X86_SIMD) && defined(__SSE2__)
+
+uint32_t _stringMapMatch(const int8_t *group, int8_t h2) {
+    __m128i ctrl = _mm_loadu_si128((const __m128i *)group);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(h2)));
 }
 
-void stringToUpper(TString *s) {
-    if (s == NULL || s->size == 0) return;
-    for (size_t i = 0; i < s->size; ++i) {
-        s->data[i] = stringCharToUpper(s->data[i]);
-    }
+uint32_t _stringMapMatchEmpty(const int8_t *group) {
+    __m128i ctrl = _mm_loadu_si128((const __m128i *)group);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(MAP_EMPTY)));
 }
 
-void stringToLower(TString *s) {
-    if (s == NULL || s->size == 0) return;
-    for (size_t i = 0; i < s->size; ++i) {
-        s->data[i] = stringCharToLower(s->data[i]);
+uint32_t _stringMapMatchFree(const int8_t *group) {
+    return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)group));
+}
+
+#else
+
+// Gathers the high bit of every byte into the low 8 bits.
+uint32_t _stringMapBits(uint64_t highs) {
+    return (uint32_t)(((highs >> 7) * 0x0102040810204080ULL) >> 56);
+}
+
+uint32_t _stringMapMatch(const int8_t *group, int8_t h2) {
+    uint32_t res = 0;
+    for (size_t half = 0; half < 2; ++half) {
+        uint64_t x = _stringLoad64Le((const char *)group + half * 8) ^ (SWAR_ONES * (uint8_t)h2);
+        res |= _stringMapBits((x - SWAR_ONES) & ~x & SWAR_HIGHS) << (half * 8);
     }
+    return res;
 }
 
-void stringReverse(TString *s) {
-    if (s == NULL || s->size == 0) return;
-    for (size_t i = 0; i < (s->size) / 2; ++i) {
-        char tmp = s->data[i];
-        s->data[i] = s->data[s->size - i - 1];
-        s->data[s->size - i - 1] = tmp;
+uint32_t _stringMapMatchEmpty(const int8_t *group) {
+    uint32_t res = 0;
+    for (size_t half = 0; half < 2; ++half) {
+        uint64_t x = _stringLoad64Le((const char *)group + half * 8);
+        res |= _stringMapBits(x & ~(x << 6) & SWAR_HIGHS) << (half * 8);
     }
+    return res;
 }
 
-void stringFilter(TString *s, bool (*predicate)(char)) {
-    if (s == NULL || predicate == NULL) {
-        setError(ERR_NULL_POINTER);
-        return;
+uint32_t _stringMapMatchFree(const int8_t *group) {
+    uint32_t res = 0;
+    for (size_t half = 0; half < 2; ++half) {
+        res |= _stringMapBits(_stringLoad64Le((const char *)group + half * 8) & SWAR_HIGHS) << (half * 8);
     }
-    size_t i = 0;
-    size_t j = 0;
+    return res;
+}
 
-    while (j < s->size) {
-        if (predicate(s->data[j])) {
-            s->data[i] = s->data[j];
-            ++i;
+#endif
+
+// The first MAP_GROUP control bytes are mirrored past the end, so a group can
+// be loaded at any slot without wrapping.
+void _stringMapSetCtrl(TStringMap *m, size_t i, int8_t c) {
+    m->ctrl[i] = c;
+    if (i < MAP_GROUP) m->ctrl[m->capacity + i] = c;
+}
+
+int64_t _stringMapFindIndex(const TStringMap *m, uint64_t hash, TStringView key) {
+    if (m->capacity == 0) return -1;
+    const size_t mask = m->capacity - 1;
+    const int8_t h2 = (int8_t)(hash & 0x7F);
+    size_t pos = (size_t)(hash >> 7) & mask;
+    for (size_t step = MAP_GROUP;; step += MAP_GROUP) {
+        const int8_t *group = m->ctrl + pos;
+        uint32_t match = _stringMapMatch(group, h2);
+        while (match != 0) {
+            size_t i = (pos + (size_t)__builtin_ctz(match)) & mask;
+            const TStringMapSlot *slot = &m->slots[i];
+            if (slot->hash == hash && slot->size == key.size && _stringEqualBuf(slot->key, key.data, key.size)) {
+                return (int64_t)i;
+            }
+            match &= match - 1;
         }
-        ++j;
+        if (_stringMapMatchEmpty(group) != 0) return -1;
+        pos = (pos + step) & mask;
     }
+}
 
-    s->size = i;
+size_t _stringMapFindFree(const TStringMap *m, uint64_t hash) {
+    const size_t mask = m->capacity - 1;
+    size_t pos = (size_t)(hash >> 7) & mask;
+    for (size_t step = MAP_GROUP;; step += MAP_GROUP) {
+        uint32_t freeMask = _stringMapMatchFree(m->ctrl + pos);
+        if (freeMask != 0) return (pos + (size_t)__builtin_ctz(freeMask)) & mask;
+        pos = (pos + step) & mask;
+    }
 }
 
-void stringMap(TString *s, char (*func)(char)) {
-    if (s == NULL || func == NULL) {
-        setError(ERR_NULL_POINTER);
-        return;
+// Rebuilds the table at `capacity`, dropping tombstones. Stored hashes make
+// this a pass over the slots without touching key bytes.
+bool _stringMapRehash(TStringMap *m, size_t capacity) {
+    int8_t *ctrl = (int8_t *)malloc(capacity + MAP_GROUP);
+    TStringMapSlot *slots = (TStringMapSlot *)malloc(sizeof(TStringMapSlot) * capacity);
+    if (ctrl == NULL || slots == NULL) {
+        free(ctrl);
+        free(slots);
+        setError(ERR_ALLOCATE_SPACE);
+        return false;
     }
-    for (size_t i = 0; i < s->size; ++i) {
-        s->data[i] = func(s->data[i]);
+    memset(ctrl, MAP_EMPTY, capacity + MAP_GROUP);
+    TStringMap next = *m;
+    next.ctrl = ctrl;
+    next.slots = slots;
+    next.capacity = capacity;
+    for (size_t i = 0; i < m->capacity; ++i) {
+        if (m->ctrl[i] < 0) continue;
+        size_t j = _stringMapFindFree(&next, m->slots[i].hash);
+        _stringMapSetCtrl(&next, j, m->ctrl[i]);
+        next.slots[j] = m->slots[i];
     }
+    free(m->ctrl);
+    free(m->slots);
+    m->ctrl = ctrl;
+    m->slots = slots;
+    m->capacity = capacity;
+    m->growthLeft = _stringMapMaxLoad(capacity) - m->size;
+    return true;
 }
 
-void stringMapIndex(TString *s, char (*func)(size_t, char)) {
-    if (s == NULL || func == NULL) {
+void stringMapInit(TStringMap *m, size_t capacity) {
+    if (m == NULL) {
         setError(ERR_NULL_POINTER);
         return;
     }
-    for (size_t i = 0; i < s->size; ++i) {
-        s->data[i] = func(i, s->data[i]);
-    }
+    *m = (TStringMap){0};
+    stringArenaInit(&m->keys, 0, NULL);
+    // the map's address is enough to vary the layout between instances and runs
+    uintptr_t addr = (uintptr_t)m;
+    m->seed = _stringHash((const char *)&addr, sizeof(addr), 0);
+    if (capacity == 0) return;
+    size_t cap = MAP_MIN_CAPACITY;
+    while (_stringMapMaxLoad(cap) < capacity) cap *= 2;
+    _stringMapRehash(m, cap);
 }
 
-void stringRemove(TString *s, size_t pos, size_t len) {
-    if (s == NULL) {
+// Returns the value stored under `key`, inserting a zero first if the key is
+// missing. The pointer stays valid until the next insertion.
+int64_t *stringMapUpsert(TStringMap *m, TStringView key) {
+    if (m == NULL || (key.data == NULL && key.size > 0)) {
         setError(ERR_NULL_POINTER);
-        return;
+        return NULL;
+    }
+    uint64_t hash = _stringHash(key.data, key.size, m->seed);
+    int64_t found = _stringMapFindIndex(m, hash, key);
+    if (found >= 0) return &m->slots[found].value;
+
+    if (m->growthLeft == 0) {
+        // tombstones alone can exhaust the room; then a same-size rebuild is enough
+        size_t cap = MAP_MIN_CAPACITY;
+        if (m->capacity > 0) cap = m->size * 2 >= _stringMapMaxLoad(m->capacity) ? m->capacity * 2 : m->capacity;
+        if (!_stringMapRehash(m, cap)) return NULL;
+    }
+    char *copy = (char *)_stringArenaAllocate(&m->keys, key.size);
+    if (copy == NULL) {
+        setError(ERR_ALLOCATE_SPACE);
+        return NULL;
     }
+    if (key.size > 0) memcpy(copy, key.data, key.size);
+    size_t i = _stringMapFindFree(m, hash);
+    if (m->ctrl[i] == MAP_EMPTY) --m->growthLeft;
+    _stringMapSetCtrl(m, i, (int8_t)(hash & 0x7F));
+    TStringMapSlot *slot = &m->slots[i];
+    slot->key = copy;
+    slot->size = key.size;
+    slot->hash = hash;
+    slot->value = 0;
+    ++m->size;
+    return &slot->value;
+}
 
-    if (pos >= s->size) return;
-    if (len > s->size - pos) len = s->size - pos;
-    for (size_t i = pos; i + len < s->size; ++i) {
-        s->data[i] = s->data[i + len];
+int64_t *stringMapFind(TStringMap *m, TStringView key) {
+    if (m == NULL || (key.data == NULL && key.size > 0)) {
+        setError(ERR_NULL_POINTER);
+        return NULL;
     }
-    s->size -= len;
+    int64_t i = _stringMapFindIndex(m, _stringHash(key.data, key.size, m->seed), key);
+    return i >= 0 ? &m->slots[i].value : NULL;
 }
 
-void stringDestroy(TString *s) {
-    if (s == NULL) return;
-    free(s->data);
-    *s = (TString){0};
+// The slot becomes a tombstone; the copied key bytes are only reclaimed by
+// stringMapClear or stringMapDestroy.
+bool stringMapRemove(TStringMap *m, TStringView key) {
+    if (m == NULL || (key.data == NULL && key.size > 0)) {
+        setError(ERR_NULL_POINTER);
+        return false;
+    }
+    int64_t i = _stringMapFindIndex(m, _stringHash(key.data, key.size, m->seed), key);
+    if (i < 0) return false;
+    _stringMapSetCtrl(m, (size_t)i, MAP_DELETED);
+    --m->size;
+    return true;
 }
 
-bool isSeparator(char symbol) {
-    return symbol == ' ' || symbol == '\t' || symbol == '\n' || symbol == ',' || symbol == '.';
+TStringMapIter stringMapIter(const TStringMap *m) {
+    TStringMapIter it = {0};
+    it.map = m;
+    return it;
 }
 
-void stringCapitalize(TString *s) {
-    if (s == NULL || s->size == 0) {
-        return;
-    }
-    if ('a' <= s->data[0] && s->data[0] <= 'z') {
-        s->data[0] = stringCharToUpper(s->data[0]);
+bool stringMapIterNext(TStringMapIter *it, TStringView *key, int64_t *value) {
+    if (it == NULL || it->map == NULL) {
+        setError(ERR_NULL_POINTER);
+        return false;
     }
-    for (size_t i = 1; i < s->size; ++i) {
-        if (isSeparator(s->data[i - 1]) && 'a' <= s->data[i] && s->data[i] <= 'z') {
-            s->data[i] = stringCharToUpper(s->data[i]);
-        }
+    const TStringMap *m = it->map;
+    while (it->pos < m->capacity && m->ctrl[it->pos] < 0) ++it->pos;
+    if (it->pos >= m->capacity) return false;
+    const TStringMapSlot *slot = &m->slots[it->pos++];
+    if (key != NULL) {
+        key->data = slot->key;
+        key->size = slot->size;
     }
+    if (value != NULL) *value = slot->value;
+    return true;
 }
 
-double stringToDouble(TString s) {
-    double number = 0;
-    double decimal = 0;
-    bool negative = false;
-    size_t i = 0;
-    if (s.data[0] == '-') {
-        negative = true;
-        i = 1;
-    }
-    for (; i < s.size && s.data[i] != '.'; ++i) {
-        if (stringCharIsDigit(s.data[i])) {
-            number *= 10.0;
-            number += (double)(s.data[i] - '0');
-        } else {
-            setError(ERR_INVALID_NUMBER_REPR);
-            return 0;
-        }
-    }
-    if (i < s.size && s.data[i] == '.') {
-        i = s.size - 1;
-        for (; s.data[i] != '.'; --i) {
-            if (stringCharIsDigit(s.data[i])) {
-                decimal += (double)(s.data[i] - '0');
-                decimal /= 10;
-            } else {
-                setError(ERR_INVALID_NUMBER_REPR);
-                return 0;
-            }
-        }
-    }
-    if (negative == true) {
-        return -(number + decimal);
-    }
-    return number + decimal;
+void stringMapClear(TStringMap *m) {
+    if (m == NULL) return;
+    if (m->ctrl != NULL) memset(m->ctrl, MAP_EMPTY, m->capacity + MAP_GROUP);
+    m->size = 0;
+    m->growthLeft = _stringMapMaxLoad(m->capacity);
+    stringArenaReset(&m->keys);
+}
+
+void stringMapDestroy(TStringMap *m) {
+    if (m == NULL) return;
+    free(m->ctrl);
+    free(m->slots);
+    stringArenaDestroy(&m->keys);
+    m->ctrl = NULL;
+    m->slots = NULL;
+    m->capacity = 0;
+    m->size = 0;
+    m->growthLeft = 0;
 }
 
 #endif
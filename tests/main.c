@@ -1,5 +1,6 @@
 #include <assert.h>
 #include <inttypes.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -44,6 +45,36 @@ void test_stringStartWith() {
     printGreen("test_stringStartWith\n");
 }
 
+void test_stringIsEqual() {
+    const char *base = "0123456789abcdefghijklmnopqrstuvwxyz";
+    for (size_t n = 0; n <= 36; ++n) {
+        TString a = stringInit(n + 1);
+        for (size_t i = 0; i < n; ++i) {
+            stringPushBack(&a, base[i]);
+        }
+        TString b = stringDeepCopy(a);
+        assertEq(stringIsEqual(a, b), true);
+        assertEq(stringStartWith(a, b), true);
+        assertEq(stringEndWith(a, b), true);
+        for (size_t i = 0; i < n; ++i) {
+            stringData(&b)[i] = '#';
+            assertEq(stringIsEqual(a, b), false);
+            assertEq(stringCompare(a, b), 1);
+            assertEq(stringCompare(b, a), -1);
+            stringData(&b)[i] = stringData(&a)[i];
+        }
+        stringPushBack(&b, 'x');
+        assertEq(stringIsEqual(a, b), false);
+        assertEq(stringStartWith(b, a), true);
+        assertEq(stringCompare(a, b), -1);
+
+        stringDestroy(&a);
+        stringDestroy(&b);
+    }
+
+    printGreen("test_stringIsEqual\n");
+}
+
 void test_stringStartWithCharArr() {
     TString str = stringInitWithCharArr("Hello, World!");
 
@@ -110,6 +141,88 @@ void test_stringFindFirst() {
     printGreen("test_stringFindFirst\n");
 }
 
+int64_t naiveFindFirst(TString s, TString pattern) {
+    for (size_t i = 0; i + pattern.size <= s.size; ++i) {
+        if (memcmp(stringData(&s) + i, stringData(&pattern), pattern.size) == 0) return i;
+    }
+    return -1;
+}
+
+void test_stringFindFirstPeriodic() {
+    TString str = stringInit(4096);
+    for (size_t i = 0; i < 4000; ++i) {
+        stringPushBack(&str, 'a');
+    }
+    TString pattern = stringInit(600);
+    for (size_t i = 0; i < 500; ++i) {
+        stringPushBack(&pattern, 'a');
+    }
+    stringPushBack(&pattern, 'b');
+    assertEq(stringFindFirst(str, pattern), -1);
+
+    stringPushBack(&str, 'b');
+    assertEq(stringFindFirst(str, pattern), 3500);
+
+    TString runs = stringInit(4000);
+    for (size_t i = 0; i < 4000; ++i) {
+        stringPushBack(&runs, i % 100 == 99 ? 'b' : 'a');
+    }
+    TString longRun = stringInit(150);
+    for (size_t i = 0; i < 150; ++i) {
+        stringPushBack(&longRun, 'a');
+    }
+    assertEq(stringFindFirst(runs, longRun), -1);
+    stringData(&longRun)[60] = 'b';
+    assertEq(stringFindFirst(runs, longRun), 39);
+    stringDestroy(&runs);
+    stringDestroy(&longRun);
+
+    TString empty = {0};
+    assertEq(stringFindFirst(str, empty), 0);
+    assertEq(stringFindFirst(empty, pattern), -1);
+
+    stringDestroy(&str);
+    stringDestroy(&pattern);
+
+    printGreen("test_stringFindFirstPeriodic\n");
+}
+
+void test_stringFindFirstRandom() {
+    srand(42);
+    ESimdLevel detected = stringGetSimdLevel();
+    for (size_t iter = 0; iter < 2000; ++iter) {
+        stringSetSimdLevel((ESimdLevel)(iter % (SIMD_AVX2 + 1)));
+        size_t n = rand() % 300;
+        size_t m = 1 + rand() % 40;
+        TString str = stringInit(n + 1);
+        TString pattern = stringInit(m);
+        for (size_t i = 0; i < n; ++i) {
+            stringPushBack(&str, "ab"[rand() % 2]);
+        }
+        for (size_t i = 0; i < m; ++i) {
+            stringPushBack(&pattern, "ab"[rand() % 2]);
+        }
+        int64_t expected = naiveFindFirst(str, pattern);
+        assertEq(stringFindFirst(str, pattern), expected);
+
+        TStringPattern exact = stringPatternCompile(pattern, true);
+        TStringPattern folded = stringPatternCompile(pattern, false);
+        if (m <= n) {
+            assertEq(_stringSearchTwoWayFrom(&exact, stringData(&str), n, 0), expected);
+        }
+        stringToUpper(&str);
+        assertEq(stringPatternFind(&folded, str), expected);
+        stringPatternDestroy(&exact);
+        stringPatternDestroy(&folded);
+
+        stringDestroy(&str);
+        stringDestroy(&pattern);
+    }
+    stringSetSimdLevel(detected);
+
+    printGreen("test_stringFindFirstRandom\n");
+}
+
 void test_stringFindFirstCharArr() {
     TString str = stringInitWithCharArr("Hello, World!");
 
@@ -121,10 +234,645 @@ void test_stringFindFirstCharArr() {
     printGreen("test_stringFindFirstCharArr\n");
 }
 
+void test_stringPattern() {
+    TString str = stringInitWithCharArr("Content-Type: text/html; content-length: 10; CONTENT");
+    TStringPattern sensitive = stringPatternCompileCharArr("content", true);
+    TStringPattern insensitive = stringPatternCompileCharArr("Content", false);
+
+    assertEq(stringPatternFind(&sensitive, str), 25);
+    assertEq(stringPatternFindNext(&sensitive, str, 26), -1);
+    assertEq(stringPatternFind(&insensitive, str), 0);
+    assertEq(stringPatternFindNext(&insensitive, str, 1), 25);
+    assertEq(stringPatternCount(&sensitive, str), 1);
+    assertEq(stringPatternCount(&insensitive, str), 3);
+
+    size_t expected[] = {0, 25, 45};
+    size_t found = 0;
+    size_t pos = 0;
+    TStringMatchIter it = stringPatternIter(&insensitive, str);
+    while (stringPatternIterNext(&it, &pos)) {
+        assertEq(pos, expected[found]);
+        ++found;
+    }
+    assertEq(found, 3);
+
+    TString upper = stringDeepCopy(str);
+    stringToUpper(&upper);
+    TString pattern = stringSubstring(str, 14, 30);
+    TStringPattern longPattern = stringPatternCompile(pattern, false);
+    assertEq(stringPatternFind(&longPattern, upper), 14);
+
+    stringPatternDestroy(&sensitive);
+    stringPatternDestroy(&insensitive);
+    stringPatternDestroy(&longPattern);
+    stringDestroy(&str);
+    stringDestroy(&upper);
+    stringDestroy(&pattern);
+
+    printGreen("test_stringPattern\n");
+}
+
+void test_stringCountSubstring() {
+    TString str = stringInitWithCharArr("aaaa abab ab");
+    TString p1 = stringInitWithCharArr("aa");
+    TString p2 = stringInitWithCharArr("ab");
+    TString p3 = stringInitWithCharArr("abc");
+
+    assertEq(stringCountSubstring(str, p1), 2);
+    assertEq(stringCountSubstring(str, p2), 3);
+    assertEq(stringCountSubstring(str, p3), 0);
+
+    stringDestroy(&str);
+    stringDestroy(&p1);
+    stringDestroy(&p2);
+    stringDestroy(&p3);
+
+    printGreen("test_stringCountSubstring\n");
+}
+
+void test_stringVec() {
+    TStrVec v = stringVecInit(0);
+    TString str = stringInitWithCharArr("first");
+    stringVecPushBack(&v, str);
+    for (size_t i = 0; i < 10; ++i) {
+        stringVecPushBackCharArr(&v, "next");
+    }
+
+    assertEq(v.size, 11);
+    assertEq(stringIsEqual(v.data[0], str), true);
+    assertNotEq(stringData(&v.data[0]), stringData(&str));
+    assertEq(stringCompare(v.data[10], (TString){.data = "next", .size = 4, .capacity = 4}), 0);
+
+    stringDestroy(&str);
+    stringVecDestroy(&v);
+    assertEq(v.size, 0);
+
+    printGreen("test_stringVec\n");
+}
+
+void test_stringVecPacked() {
+    TStrVec packed = stringVecInitPacked(0, 0);
+    TStrVec plain = stringVecInit(0);
+    char word[32];
+    for (size_t i = 0; i < 1000; ++i) {
+        size_t len = (size_t)(i % 17);
+        for (size_t j = 0; j < len; ++j) {
+            word[j] = (char)('a' + (i + j) % 26);
+        }
+        TStringView w = {word, len};
+        stringVecPushBackView(&packed, w);
+        stringVecPushBackView(&plain, w);
+    }
+    // pushing an item of the same vector survives the blob moving
+    for (size_t i = 0; i < 100; ++i) {
+        stringVecPushBackView(&packed, stringVecGet(&packed, packed.size - 1));
+        stringVecPushBackView(&plain, stringVecGet(&plain, plain.size - 1));
+    }
+    assertEq(packed.size, 1100);
+    assertEq(packed.data, NULL);
+
+    TStrVecIter a = stringVecIter(&packed);
+    TStrVecIter b = stringVecIter(&plain);
+    TStringView x;
+    TStringView y;
+    size_t total = 0;
+    while (stringVecIterNext(&a, &x)) {
+        assertEq(stringVecIterNext(&b, &y), true);
+        assertEq(stringViewIsEqual(x, y), true);
+        total += x.size;
+    }
+    assertEq(stringVecIterNext(&b, &y), false);
+    assertEq(packed.blobSize, total);
+
+    stringVecGet(&packed, packed.size);
+    assertEq(isError(), true);
+
+    TStrVec patterns = stringVecInitPacked(4, 64);
+    stringVecPushBackCharArr(&patterns, "he");
+    stringVecPushBackCharArr(&patterns, "she");
+    stringVecPushBackCharArr(&patterns, "hers");
+    TStringMultiMatcher m = stringMultiMatcherCompile(patterns, true);
+    TString text = stringInitWithCharArr("ushers");
+    TStringMatch match;
+    assertEq(stringMultiMatcherFindFirst(&m, text, &match), true);
+    assertEq(match.pattern, 1);
+    assertEq(match.pos, 1);
+    stringDestroy(&text);
+    stringMultiMatcherDestroy(&m);
+
+    char *blob = packed.blob;
+    stringVecClear(&packed);
+    stringVecClear(&plain);
+    assertEq(packed.size, 0);
+    assertEq(plain.size, 0);
+    stringVecPushBackCharArr(&packed, "again");
+    assertEq(packed.blob, blob);
+    assertEq(stringViewIsEqual(stringVecGet(&packed, 0), stringViewFromCharArr("again")), true);
+
+    stringVecDestroy(&patterns);
+    stringVecDestroy(&plain);
+    stringVecDestroy(&packed);
+    printGreen("test_stringVecPacked\n");
+}
+
+int compareBytes(const void *x, const void *y) {
+    const TString *a = (const TString *)x;
+    const TString *b = (const TString *)y;
+    size_t n = a->size < b->size ? a->size : b->size;
+    int res = n > 0 ? memcmp(stringData(a), stringData(b), n) : 0;
+    if (res != 0) return res;
+    return a->size < b->size ? -1 : (a->size > b->size);
+}
+
+void test_stringVecSort() {
+    for (int round = 0; round < 20; ++round) {
+        TStrVec plain = stringVecInit(0);
+        TStrVec packed = stringVecInitPacked(0, 0);
+        size_t n = (size_t)(rand() % 400);
+        char buf[40];
+        for (size_t i = 0; i < n; ++i) {
+            // long shared prefixes, a tiny alphabet and embedded zero bytes
+            size_t len = (size_t)(rand() % 30);
+            for (size_t j = 0; j < len; ++j) {
+                buf[j] = j < 12 && round % 2 ? 'p' : "ab\0\xff"[rand() % 4];
+            }
+            stringVecPushBackView(&plain, (TStringView){buf, len});
+            stringVecPushBackView(&packed, (TStringView){buf, len});
+        }
+        TString *expected = (TString *)malloc(sizeof(TString) * (n + 1));
+        for (size_t i = 0; i < n; ++i) {
+            expected[i] = plain.data[i];
+        }
+        qsort(expected, n, sizeof(TString), compareBytes);
+
+        stringVecSort(&plain);
+        stringVecSort(&packed);
+        for (size_t i = 0; i < n; ++i) {
+            TStringView want = stringViewOf(&expected[i]);
+            assertEq(stringViewIsEqual(stringVecGet(&plain, i), want), true);
+            assertEq(stringViewIsEqual(stringVecGet(&packed, i), want), true);
+        }
+        free(expected);
+        stringVecDestroy(&plain);
+        stringVecDestroy(&packed);
+    }
+
+    // case-insensitive keys that compare equal keep their input order
+    const char *words[] = {"beta", "Alpha", "ALPHA", "alphabet", "Beta", "alpha", "", "gamma-ray-burst-0001",
+                           "GAMMA-RAY-BURST-0001", "gamma-ray-burst-0000"};
+    const char *sorted[] = {"", "Alpha", "ALPHA", "alpha", "alphabet", "beta", "Beta", "gamma-ray-burst-0000",
+                            "gamma-ray-burst-0001", "GAMMA-RAY-BURST-0001"};
+    TStrVec v = stringVecInitPacked(0, 0);
+    for (size_t i = 0; i < sizeof(words) / sizeof(words[0]); ++i) {
+        stringVecPushBackCharArr(&v, words[i]);
+    }
+    stringVecSortIgnoreCase(&v);
+    for (size_t i = 0; i < v.size; ++i) {
+        assertEq(stringViewIsEqual(stringVecGet(&v, i), stringViewFromCharArr(sorted[i])), true);
+    }
+    stringVecSort(&v);
+    assertEq(stringViewIsEqual(stringVecGet(&v, 1), stringViewFromCharArr("ALPHA")), true);
+    assertEq(stringViewIsEqual(stringVecGet(&v, v.size - 1), stringViewFromCharArr("gamma-ray-burst-0001")), true);
+    stringVecDestroy(&v);
+
+    // many duplicates take the equal-key path
+    TStrVec dups = stringVecInit(0);
+    for (size_t i = 0; i < 1000; ++i) {
+        stringVecPushBackCharArr(&dups, i % 3 ? "same-long-key-shared-by-many" : "same");
+    }
+    stringVecSort(&dups);
+    assertEq(stringLen(dups.data[0]), 4);
+    assertEq(stringLen(dups.data[333]), 4);
+    assertEq(stringLen(dups.data[334]), 28);
+    stringVecDestroy(&dups);
+
+    // multi-megabyte keys that are identical or differ only at the end must
+    // not need stack in proportion to their length
+    const size_t longSize = 4 << 20;
+    char *longKey = (char *)malloc(longSize);
+    memset(longKey, 'k', longSize);
+    TStrVec longKeys = stringVecInitPacked(40, 40 * longSize);
+    for (size_t i = 0; i < 40; ++i) {
+        longKey[longSize - 1] = i % 2 ? 'k' : (char)('z' - i % 7);
+        stringVecPushBackView(&longKeys, (TStringView){longKey, longSize - (i % 3 == 0)});
+    }
+    stringVecSort(&longKeys);
+    for (size_t i = 1; i < longKeys.size; ++i) {
+        TStringView prev = stringVecGet(&longKeys, i - 1);
+        TStringView cur = stringVecGet(&longKeys, i);
+        size_t common = prev.size < cur.size ? prev.size : cur.size;
+        int cmp = memcmp(prev.data, cur.data, common);
+        assertEq(cmp < 0 || (cmp == 0 && prev.size <= cur.size), true);
+    }
+    stringVecDestroy(&longKeys);
+    free(longKey);
+    printGreen("test_stringVecSort\n");
+}
+
+void collectMatch(TStringMatch match, void *ctx) {
+    TStringMatch **out = (TStringMatch **)ctx;
+    **out = match;
+    ++*out;
+}
+
+void test_stringMultiMatcher() {
+    TStrVec patterns = stringVecInit(4);
+    stringVecPushBackCharArr(&patterns, "he");
+    stringVecPushBackCharArr(&patterns, "she");
+    stringVecPushBackCharArr(&patterns, "his");
+    stringVecPushBackCharArr(&patterns, "hers");
+    TStringMultiMatcher m = stringMultiMatcherCompile(patterns, true);
+
+    TString str = stringInitWithCharArr("ushers");
+    TStringMatch first = {0};
+    assertEq(stringMultiMatcherFindFirst(&m, str, &first), true);
+    assertEq(first.pos, 1);
+    assertEq(first.pattern, 1);
+
+    TStringMatch found[8];
+    TStringMatch *out = found;
+    assertEq(stringMultiMatcherFindAll(&m, str, collectMatch, &out), 3);
+    assertEq(found[0].pattern, 1);
+    assertEq(found[1].pattern, 0);
+    assertEq(found[1].pos, 2);
+    assertEq(found[2].pattern, 3);
+    assertEq(found[2].pos, 2);
+
+    TString upper = stringInitWithCharArr("USHERS AND HIS");
+    assertEq(stringMultiMatcherFindFirst(&m, upper, &first), false);
+    TStringMultiMatcher folded = stringMultiMatcherCompile(patterns, false);
+    assertEq(stringMultiMatcherFindAll(&folded, upper, NULL, NULL), 4);
+
+    stringMultiMatcherDestroy(&m);
+    stringMultiMatcherDestroy(&folded);
+    stringVecDestroy(&patterns);
+    stringDestroy(&str);
+    stringDestroy(&upper);
+
+    srand(7);
+    for (size_t iter = 0; iter < 200; ++iter) {
+        TStrVec randomPatterns = stringVecInit(0);
+        size_t count = 1 + rand() % 20;
+        for (size_t i = 0; i < count; ++i) {
+            TString p = stringInit(8);
+            size_t len = 1 + rand() % 6;
+            for (size_t j = 0; j < len; ++j) {
+                stringPushBack(&p, "abc"[rand() % 3]);
+            }
+            stringVecPushBack(&randomPatterns, p);
+            stringDestroy(&p);
+        }
+        TString hay = stringInit(200);
+        size_t n = rand() % 200;
+        for (size_t i = 0; i < n; ++i) {
+            stringPushBack(&hay, "abc"[rand() % 3]);
+        }
+
+        size_t expected = 0;
+        for (size_t i = 0; i < count; ++i) {
+            TString p = randomPatterns.data[i];
+            for (size_t j = 0; j + p.size <= hay.size; ++j) {
+                expected += memcmp(stringData(&hay) + j, stringData(&p), p.size) == 0;
+            }
+        }
+        TStringMultiMatcher rm = stringMultiMatcherCompile(randomPatterns, true);
+        assertEq(stringMultiMatcherFindAll(&rm, hay, NULL, NULL), expected);
+        assertEq(stringMultiMatcherFindFirst(&rm, hay, &first), expected > 0);
+
+        stringMultiMatcherDestroy(&rm);
+        stringVecDestroy(&randomPatterns);
+        stringDestroy(&hay);
+    }
+
+    printGreen("test_stringMultiMatcher\n");
+}
+
+#define INTERN_THREADS 4
+#define INTERN_KEYS 5000
+
+typedef struct {
+    TStringInterner *interner;
+    size_t offset;
+    TStringAtom atoms[INTERN_KEYS];
+} TInternJob;
+
+void *internKeys(void *arg) {
+    TInternJob *job = (TInternJob *)arg;
+    char key[32];
+    for (size_t i = 0; i < INTERN_KEYS; ++i) {
+        // every thread walks the same keys from a different starting point
+        size_t k = (i + job->offset) % INTERN_KEYS;
+        int len = snprintf(key, sizeof(key), "metric.%zu", k);
+        job->atoms[k] = stringIntern(job->interner, (TStringView){key, (size_t)len});
+    }
+    return NULL;
+}
+
+void test_stringInterner() {
+    TStringInterner in;
+    stringInternerInit(&in);
+    TStringAtom host = stringIntern(&in, stringViewFromCharArr("example.com"));
+    TStringAtom empty = stringIntern(&in, stringViewFromCharArr(""));
+    TString copy = stringInitWithCharArr("example.com");
+    assertEq(stringIntern(&in, stringViewOf(&copy)), host);
+    assertNotEq(host, empty);
+    assertEq(stringInternerSize(&in), 2);
+
+    TStringView v = stringInternGet(&in, host);
+    assertEq(stringViewIsEqual(v, stringViewFromCharArr("example.com")), true);
+    assertEq(stringInternGet(&in, empty).size, 0);
+
+    TStringAtom found = STRING_ATOM_INVALID;
+    assertEq(stringInternFind(&in, stringViewFromCharArr("example.com"), &found), true);
+    assertEq(found, host);
+    assertEq(stringInternFind(&in, stringViewFromCharArr("example.org"), &found), false);
+    stringInternGet(&in, STRING_ATOM_INVALID);
+    assertEq(isError(), true);
+    stringDestroy(&copy);
+    stringInternerDestroy(&in);
+
+    // concurrent inserts of overlapping keys agree on a single atom per key
+    stringInternerInit(&in);
+    TInternJob jobs[INTERN_THREADS];
+    pthread_t threads[INTERN_THREADS];
+    for (size_t t = 0; t < INTERN_THREADS; ++t) {
+        jobs[t].interner = &in;
+        jobs[t].offset = t * INTERN_KEYS / INTERN_THREADS;
+        pthread_create(&threads[t], NULL, internKeys, &jobs[t]);
+    }
+    for (size_t t = 0; t < INTERN_THREADS; ++t) {
+        pthread_join(threads[t], NULL);
+    }
+    assertEq(stringInternerSize(&in), INTERN_KEYS);
+    char key[32];
+    for (size_t k = 0; k < INTERN_KEYS; ++k) {
+        for (size_t t = 1; t < INTERN_THREADS; ++t) {
+            assertEq(jobs[t].atoms[k], jobs[0].atoms[k]);
+        }
+        int len = snprintf(key, sizeof(key), "metric.%zu", k);
+        TStringView got = stringInternGet(&in, jobs[0].atoms[k]);
+        assertEq(stringViewIsEqual(got, (TStringView){key, (size_t)len}), true);
+    }
+    stringInternerDestroy(&in);
+
+    printGreen("test_stringInterner\n");
+}
+
+void test_stringReadLine() {
+    // a line longer than the reader's block, CRLF, empty lines and no final newline
+    FILE *f = tmpfile();
+    assertNotEq(f, NULL);
+    TString longLine = stringInit(0);
+    stringAppendRepeat(&longLine, 'x', STRING_READER_BLOCK + 123);
+    fputs("first\r\n\nsecond line\n", f);
+    fwrite(stringData(&longLine), 1, longLine.size, f);
+    fputs("\n  tok1\t tok2\nlast", f);
+    const char *lines[] = {"first", "", "second line", NULL, "  tok1\t tok2", "last"};
+
+    for (size_t mode = 0; mode < 3; ++mode) {
+        rewind(f);
+        TStringReader r;
+        if (mode == 1) {
+            lseek(fileno(f), 0, SEEK_SET);
+            stringReaderInitFd(&r, fileno(f));
+        } else {
+            stringReaderInitFile(&r, f);
+        }
+        TString line = stringInit(4);
+        TStringView view;
+        for (size_t i = 0; i < sizeof(lines) / sizeof(lines[0]); ++i) {
+            TStringView expected = lines[i] != NULL ? stringViewFromCharArr(lines[i]) : stringViewOf(&longLine);
+            if (mode == 2) {
+                assertEq(stringReadLineView(&r, &view), true);
+            } else {
+                assertEq(stringReadLine(&r, &line), true);
+                view = stringViewOf(&line);
+            }
+            assertEq(stringViewIsEqual(view, expected), true);
+        }
+        assertEq(stringReadLine(&r, &line), false);
+        assertEq(isError(), false);
+        assertEq(stringReadLineView(&r, &view), false);
+        stringDestroy(&line);
+        stringReaderDestroy(&r);
+    }
+
+    rewind(f);
+    TStringReader r;
+    stringReaderInitFile(&r, f);
+    TString token = stringInit(0);
+    const char *tokens[] = {"first", "second", "line", NULL, "tok1", "tok2", "last"};
+    for (size_t i = 0; i < sizeof(tokens) / sizeof(tokens[0]); ++i) {
+        assertEq(stringReadToken(&r, &token), true);
+        TStringView expected = tokens[i] != NULL ? stringViewFromCharArr(tokens[i]) : stringViewOf(&longLine);
+        assertEq(stringViewIsEqual(stringViewOf(&token), expected), true);
+    }
+    assertEq(stringReadToken(&r, &token), false);
+    assertEq(token.size, 0);
+    stringReaderDestroy(&r);
+    stringDestroy(&token);
+    stringDestroy(&longLine);
+    fclose(f);
+
+    printGreen("test_stringReadLine\n");
+}
+
+// Checks that `f` holds exactly `expected`, then empties it.
+void assertFileContent(FILE *f, TString expected) {
+    fflush(f);
+    int fd = fileno(f);
+    assertEq((size_t)lseek(fd, 0, SEEK_END), expected.size);
+    char *buf = (char *)malloc(expected.size + 1);
+    assertEq((size_t)pread(fd, buf, expected.size, 0), expected.size);
+    assertEq(memcmp(buf, stringData(&expected), expected.size), 0);
+    free(buf);
+    assertEq(ftruncate(fd, 0), 0);
+    rewind(f);
+}
+
+void test_stringWrite() {
+    FILE *f = tmpfile();
+    assertNotEq(f, NULL);
+    TString s = stringInitWithCharArr("hello, writer");
+    assertEq(stringWriteFile(f, s), true);
+    assertFileContent(f, s);
+    assertEq(stringWriteFd(fileno(f), s), true);
+    assertFileContent(f, s);
+    stringDestroy(&s);
+
+    // more items than one writev batch, both layouts, with and without a delimiter
+    TStrVec plain = stringVecInit(0);
+    TStrVec packed = stringVecInitPacked(0, 0);
+    TString items[1500];
+    char key[32];
+    for (size_t i = 0; i < 1500; ++i) {
+        int len = snprintf(key, sizeof(key), i % 7 == 0 ? "" : "item-%zu", i);
+        items[i] = stringInitWithCharArr(key);
+        stringVecPushBackView(&plain, (TStringView){key, (size_t)len});
+        stringVecPushBackView(&packed, (TStringView){key, (size_t)len});
+    }
+    const char *delims[] = {"", "\n", ", "};
+    for (size_t d = 0; d < 3; ++d) {
+        TStringView delim = stringViewFromCharArr(delims[d]);
+        TString expected = stringArrJoinCharArr(items, 1500, delims[d]);
+        for (size_t k = 0; k < 2; ++k) {
+            const TStrVec *v = k == 0 ? &plain : &packed;
+            assertEq(stringVecWriteFile(f, v, delim), true);
+            assertFileContent(f, expected);
+            assertEq(stringVecWriteFd(fileno(f), v, delim), true);
+            assertFileContent(f, expected);
+        }
+        stringDestroy(&expected);
+    }
+    for (size_t i = 0; i < 1500; ++i) {
+        stringDestroy(&items[i]);
+    }
+    stringVecDestroy(&plain);
+    stringVecDestroy(&packed);
+
+    s = stringInitWithCharArr("lost");
+    assertEq(stringWriteFd(-1, s), false);
+    assertEq(ERROR_CODE, ERR_IO);
+    stringDestroy(&s);
+    fclose(f);
+
+    printGreen("test_stringWrite\n");
+}
+
+void *errorStateWorker(void *arg) {
+    EErrorCode *seen = (EErrorCode *)arg;
+    seen[0] = ERROR_CODE;
+    stringCharToInt('x');
+    seen[1] = ERROR_CODE;
+    stringCharToInt('7');
+    seen[2] = ERROR_CODE;
+    return NULL;
+}
+
+void test_errorState() {
+    stringCharToInt('x');
+    assertEq(ERROR_CODE, ERR_INVALID_NUMBER_REPR);
+
+    // every thread has its own state
+    EErrorCode seen[3];
+    pthread_t thread;
+    pthread_create(&thread, NULL, errorStateWorker, seen);
+    pthread_join(thread, NULL);
+    assertEq(seen[0], ERR_NO_ERROR);
+    assertEq(seen[1], ERR_INVALID_NUMBER_REPR);
+    assertEq(seen[2], ERR_NO_ERROR);
+    assertEq(ERROR_CODE, ERR_INVALID_NUMBER_REPR);
+
+    assertEq(stringCharToInt('3'), 3);
+    assertEq(isError(), false);
+
+    printGreen("test_errorState\n");
+}
+
+void test_stringHash() {
+    char buf[80];
+    char shifted[81];
+    for (size_t i = 0; i < sizeof(buf); ++i) {
+        buf[i] = (char)('a' + i % 26);
+    }
+    memcpy(shifted + 1, buf, sizeof(buf));
+    uint64_t prev = stringHashWithSeed(buf, 0, 0);
+    for (size_t n = 1; n <= sizeof(buf); ++n) {
+        // every length takes its own path through the short/medium/long cases
+        uint64_t h = stringHashWithSeed(buf, n, 0);
+        assertNotEq(h, prev);
+        assertEq(stringHashWithSeed(shifted + 1, n, 0), h);
+        assertNotEq(stringHashWithSeed(buf, n, 1), h);
+        prev = h;
+    }
+
+    TString s = stringInitWithCharArr("metric_name_total");
+    assertEq(stringHash(s), stringHashCharArr("metric_name_total"));
+    assertEq(stringViewHash(stringViewOf(&s)), stringHash(s));
+    assertNotEq(stringHash(s), stringHashCharArr("metric_name_totaL"));
+    stringDestroy(&s);
+
+    printGreen("test_stringHash\n");
+}
+
+void test_stringHashMap() {
+    TStringMap m;
+    stringMapInit(&m, 0);
+    assertEq(stringMapFind(&m, stringViewFromCharArr("a")), NULL);
+    *stringMapUpsert(&m, stringViewFromCharArr("a")) += 5;
+    *stringMapUpsert(&m, stringViewFromCharArr("")) += 1;
+    *stringMapUpsert(&m, stringViewFromCharArr("a")) += 2;
+    assertEq(m.size, 2);
+    assertEq(*stringMapFind(&m, stringViewFromCharArr("a")), 7);
+    assertEq(*stringMapFind(&m, stringViewFromCharArr("")), 1);
+    assertEq(stringMapRemove(&m, stringViewFromCharArr("a")), true);
+    assertEq(stringMapRemove(&m, stringViewFromCharArr("a")), false);
+    assertEq(stringMapFind(&m, stringViewFromCharArr("a")), NULL);
+    assertEq(*stringMapUpsert(&m, stringViewFromCharArr("a")), 0);
+    stringMapDestroy(&m);
+
+    // growth and tombstone churn checked against a dense counter array
+    const size_t keys = 5000;
+    int64_t expected[5000] = {0};
+    char key[32];
+    stringMapInit(&m, 100);
+    srand(11);
+    for (size_t step = 0; step < 100000; ++step) {
+        size_t k = (size_t)rand() % keys;
+        int len = snprintf(key, sizeof(key), "key-%zu", k);
+        TStringView v = {key, (size_t)len};
+        if (rand() % 4 == 0) {
+            assertEq(stringMapRemove(&m, v), expected[k] != 0);
+            expected[k] = 0;
+        } else {
+            int64_t *value = stringMapUpsert(&m, v);
+            assertEq(*value, expected[k]);
+            *value += 1;
+            ++expected[k];
+        }
+    }
+    size_t live = 0;
+    for (size_t k = 0; k < keys; ++k) {
+        int len = snprintf(key, sizeof(key), "key-%zu", k);
+        int64_t *value = stringMapFind(&m, (TStringView){key, (size_t)len});
+        if (expected[k] == 0) {
+            assertEq(value, NULL);
+        } else {
+            ++live;
+            assertEq(*value, expected[k]);
+        }
+    }
+    assertEq(m.size, live);
+
+    size_t seen = 0;
+    int64_t total = 0;
+    int64_t expectedTotal = 0;
+    TStringMapIter it = stringMapIter(&m);
+    TStringView k;
+    int64_t value;
+    while (stringMapIterNext(&it, &k, &value)) {
+        assertEq(stringViewStartWith(k, stringViewFromCharArr("key-")), true);
+        ++seen;
+        total += value;
+    }
+    for (size_t i = 0; i < keys; ++i) {
+        expectedTotal += expected[i];
+    }
+    assertEq(seen, live);
+    assertEq(total, expectedTotal);
+
+    stringMapClear(&m);
+    assertEq(m.size, 0);
+    assertEq(stringMapFind(&m, (TStringView){key, strlen(key)}), NULL);
+    stringMapDestroy(&m);
+
+    printGreen("test_stringHashMap\n");
+}
+
 void test_stringInit() {
     TString str = stringInit(10);
 
-    assertEq(str.capacity, 10);
+    assertEq(stringCapacity(&str), CSTRING_SSO_CAPACITY > 10 ? CSTRING_SSO_CAPACITY : 10);
     assertEq(str.size, 0);
 
     stringDestroy(&str);
@@ -137,7 +885,7 @@ void test_stringInitWithCharArr() {
     TString str = stringInitWithCharArr(testStr);
 
     assertEq(stringLen(str), strlen(testStr));
-    assertEq(strncmp(str.data, testStr, str.size), 0);
+    assertEq(strncmp(stringData(&str), testStr, str.size), 0);
 
     stringDestroy(&str);
 
@@ -150,20 +898,98 @@ void test_stringInitWithInt() {
 
     TString expectedString = stringInitWithCharArr("12345678");
     assertEq(stringLen(str), stringLen(expectedString));
-    assertEq(strncmp(str.data, expectedString.data, str.size), 0);
+    assertEq(strncmp(stringData(&str), stringData(&expectedString), str.size), 0);
 
     stringDestroy(&str);
     stringDestroy(&expectedString);
 
+    const int64_t values[] = {0, -1, 7, -2132456, INT64_MAX, INT64_MIN};
+    const char *expected[] = {"0", "-1", "7", "-2132456", "9223372036854775807", "-9223372036854775808"};
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i) {
+        str = stringInitWithInt(values[i]);
+        assertEq(stringLen(str), strlen(expected[i]));
+        assertEq(strncmp(stringData(&str), expected[i], str.size), 0);
+        stringDestroy(&str);
+    }
+
+    str = stringInitWithUint(UINT64_MAX);
+    assertEq(strncmp(stringData(&str), "18446744073709551615", str.size), 0);
+    stringAppendChars(&str, " ", 1);
+    stringAppendIntPadded(&str, -42, 6);
+    stringAppendChars(&str, " ", 1);
+    stringAppendUintPadded(&str, 7, 3);
+    stringAppendChars(&str, " ", 1);
+    stringAppendUintPadded(&str, 12345, 2);
+    assertEq(stringViewIsEqual(stringViewOf(&str), stringViewFromCharArr("18446744073709551615 -00042 007 12345")), true);
+    stringDestroy(&str);
+
+    // every digit count, compared with snprintf
+    char buf[96];
+    str = stringInit(0);
+    for (size_t i = 0; i < 20000; ++i) {
+        uint64_t u = (((uint64_t)rand() << 42) ^ ((uint64_t)rand() << 21) ^ (uint64_t)rand()) >> (i % 64);
+        int64_t v = (int64_t)u * (i % 3 == 0 ? -1 : 1);
+        size_t width = i % 25;
+        str.size = 0;
+        stringAppendUint(&str, u);
+        stringAppendInt(&str, v);
+        stringAppendIntPadded(&str, v, width);
+        int len = snprintf(buf, sizeof(buf), "%" PRIu64 "%" PRId64 "%0*" PRId64, u, v, (int)width, v);
+        assertEq(str.size, (size_t)len);
+        assertEq(memcmp(stringData(&str), buf, str.size), 0);
+    }
+    stringDestroy(&str);
+
     printGreen("test_stringInitWithInt\n");
 }
 
+void test_stringInitWithDouble() {
+    const double values[] = {0.0, -0.0, 1.0, -2.5, 0.1, 0.3, 1e21, 1e20, 123456.789, 1e-6, 1e-7, 5e-324,
+                             1.7976931348623157e308, 9007199254740993.0, 1.0 / 0.0, -1.0 / 0.0, 0.0 / 0.0};
+    const char *expected[] = {"0", "-0", "1", "-2.5", "0.1", "0.3", "1e+21", "100000000000000000000", "123456.789",
+                              "0.000001", "1e-7", "5e-324", "1.7976931348623157e+308", "9007199254740992", "inf", "-inf", "nan"};
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i) {
+        TString str = stringInitWithDouble(values[i]);
+        assertEq(stringViewIsEqual(stringViewOf(&str), stringViewFromCharArr(expected[i])), true);
+        stringDestroy(&str);
+    }
+
+    // random bit patterns read back exactly
+    char buf[512];
+    TString str = stringInit(0);
+    for (size_t i = 0; i < 20000; ++i) {
+        uint64_t bits = ((uint64_t)rand() << 42) ^ ((uint64_t)rand() << 21) ^ (uint64_t)rand();
+        double d;
+        memcpy(&d, &bits, sizeof(d));
+        if (d != d || d - d != 0) continue;
+        str.size = 0;
+        stringAppendDouble(&str, d);
+        double back = stringViewToDouble(stringViewOf(&str));
+        assertEq(memcmp(&back, &d, sizeof(d)), 0);
+    }
+
+    // fixed precision matches "%.*f", including ties and the snprintf fallback
+    const double fixed[] = {0.5, 1.5, 2.5, -0.0001, 1.005, 2.675, 0.125, 1e-20, 123456789.987654321, 1e22, -3e300};
+    for (size_t i = 0; i < sizeof(fixed) / sizeof(fixed[0]); ++i) {
+        for (size_t precision = 0; precision <= 21; precision += 3) {
+            str.size = 0;
+            stringAppendDoubleFixed(&str, fixed[i], precision);
+            int len = snprintf(buf, sizeof(buf), "%.*f", (int)precision, fixed[i]);
+            assertEq(str.size, (size_t)len);
+            assertEq(memcmp(stringData(&str), buf, str.size), 0);
+        }
+    }
+    stringDestroy(&str);
+
+    printGreen("test_stringInitWithDouble\n");
+}
+
 void test_stringCopy() {
     TString original = stringInitWithCharArr("Test string for copy");
     TString copied = stringCopy(original);
 
     assertEq(stringLen(copied), stringLen(original));
-    assertEq(strncmp(copied.data, original.data, copied.size), 0);
+    assertEq(strncmp(stringData(&copied), stringData(&original), copied.size), 0);
     assertEq(copied.data, original.data);  // Ensure it's a shallow copy
 
     stringDestroy(&original);
@@ -176,8 +1002,8 @@ void test_stringDeepCopy() {
     TString deepCopy = stringDeepCopy(original);
 
     assertEq(stringLen(deepCopy), stringLen(original));
-    assertEq(strncmp(deepCopy.data, original.data, deepCopy.size), 0);
-    assertNotEq(deepCopy.data, original.data);  // Ensure it's a deep copy
+    assertEq(strncmp(stringData(&deepCopy), stringData(&original), deepCopy.size), 0);
+    assertNotEq(stringData(&deepCopy), stringData(&original));  // Ensure it's a deep copy
 
     stringDestroy(&original);
     stringDestroy(&deepCopy);
@@ -194,7 +1020,7 @@ void test_stringSubstring() {
 
     assertEq(stringLen(sub), length);
     assertEq(stringIsEqual(sub, ans), true);
-    assertEq(strncmp(sub.data, &str.data[startPos], length), 0);
+    assertEq(strncmp(stringData(&sub), &stringData(&str)[startPos], length), 0);
 
     stringDestroy(&str);
     stringDestroy(&sub);
@@ -209,7 +1035,7 @@ void test_stringConcat() {
     TString result = stringConcat(str1, str2);
 
     assertEq(stringLen(result), stringLen(str1) + stringLen(str2));
-    assertEq(strncmp(result.data, "Hello, World!", stringLen(result)), 0);
+    assertEq(strncmp(stringData(&result), "Hello, World!", stringLen(result)), 0);
 
     stringDestroy(&str1);
     stringDestroy(&str2);
@@ -233,7 +1059,7 @@ void test_stringArrConcat() {
     }
 
     assertEq(stringLen(result), expectedLength);
-    assertEq(strncmp(result.data, "OneTwoThree", stringLen(result)), 0);
+    assertEq(strncmp(stringData(&result), "OneTwoThree", stringLen(result)), 0);
 
     for (size_t i = 0; i < count; ++i) {
         stringDestroy(&strs[i]);
@@ -249,7 +1075,7 @@ void test_stringPushBack() {
     stringPushBack(&str, c);
 
     assertEq(stringLen(str), 6);
-    assertEq(str.data[stringLen(str) - 1], c);
+    assertEq(stringData(&str)[stringLen(str) - 1], c);
 
     stringDestroy(&str);
     printGreen("test_stringPushBack\n");
@@ -260,7 +1086,7 @@ void test_stringTrim() {
     stringTrim(&str);
 
     assertEq(stringLen(str), 5);
-    assertEq(strncmp(str.data, "hello", stringLen(str)), 0);
+    assertEq(strncmp(stringData(&str), "hello", stringLen(str)), 0);
 
     stringPushBack(&str, '\n');
     for (size_t i = 0; i < 100; ++i) {
@@ -269,7 +1095,7 @@ void test_stringTrim() {
     stringTrim(&str);
 
     assertEq(stringLen(str), 5);
-    assertEq(strncmp(str.data, "hello", stringLen(str)), 0);
+    assertEq(strncmp(stringData(&str), "hello", stringLen(str)), 0);
 
     stringDestroy(&str);
     printGreen("test_stringTrim\n");
@@ -283,19 +1109,480 @@ void test_stringReplaceAll() {
 
     TString expected = stringInitWithCharArr("hello C, C!");
     assertEq(stringLen(str), stringLen(expected));
-    assertEq(strncmp(str.data, expected.data, stringLen(expected)), 0);
+    assertEq(strncmp(stringData(&str), stringData(&expected), stringLen(expected)), 0);
 
     stringDestroy(&str);
     stringDestroy(&expected);
+
+    const char *cases[][4] = {
+        {"a-b-c-", "-", "", "abc"},
+        {"--", "-", "", ""},
+        {"xx", "x", "longer", "longerlonger"},
+        {"abcabc", "abc", "abc", "abcabc"},
+    };
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+        str = stringInitWithCharArr(cases[i][0]);
+        stringReplaceAll(&str, cases[i][1], cases[i][2]);
+        assertEq(isError(), false);
+        assertEq(stringViewIsEqual(stringViewOf(&str), stringViewFromCharArr(cases[i][3])), true);
+        stringDestroy(&str);
+    }
     printGreen("test_stringReplaceAll\n");
 }
 
+void test_stringReplaceAllGrow() {
+    TString str = stringInitWithCharArr("abcabca");
+    stringReplaceAll(&str, "a", "<a long replacement>");
+    assertEq(stringLen(str), 3 * 20 + 4);
+    assertEq(stringCapacity(&str), 3 * 20 + 4);
+    assertEq(strncmp(stringData(&str), "<a long replacement>bc<a long replacement>bc", 44), 0);
+
+    stringReplaceAll(&str, "<a long replacement>", "");
+    assertEq(stringLen(str), 4);
+    assertEq(strncmp(stringData(&str), "bcbc", 4), 0);
+
+    stringReplaceAll(&str, "", "x");
+    assertEq(stringLen(str), 4);
+
+    stringDestroy(&str);
+    printGreen("test_stringReplaceAllGrow\n");
+}
+
+void test_stringAppend() {
+    TString str = {0};
+    stringReserve(&str, 32);
+    assertEq(stringCapacity(&str), 32);
+    assertEq(str.size, 0);
+
+    stringAppendCharArr(&str, "id=");
+    stringAppendInt(&str, -42);
+    stringAppendRepeat(&str, '.', 3);
+    TString tail = stringInitWithCharArr("end");
+    stringAppendString(&str, tail);
+    assertEq(stringLen(str), 12);
+    assertEq(strncmp(stringData(&str), "id=-42...end", 12), 0);
+    assertEq(stringCapacity(&str), 32);
+
+    for (size_t i = 0; i < 5; ++i) {
+        stringAppendChars(&str, stringData(&str), str.size);
+    }
+    assertEq(stringLen(str), 12 * 32);
+    assertEq(strncmp(stringData(&str) + 12 * 31, "id=-42...end", 12), 0);
+
+    stringDestroy(&str);
+    stringDestroy(&tail);
+    printGreen("test_stringAppend\n");
+}
+
+typedef struct {
+    size_t allocations;
+    size_t frees;
+    size_t liveBytes;
+} TCountingHeap;
+
+void *countingAllocate(void *ctx, size_t size) {
+    TCountingHeap *heap = (TCountingHeap *)ctx;
+    ++heap->allocations;
+    heap->liveBytes += size;
+    return malloc(size);
+}
+
+void *countingReallocate(void *ctx, void *ptr, size_t oldSize, size_t newSize) {
+    TCountingHeap *heap = (TCountingHeap *)ctx;
+    ++heap->allocations;
+    heap->liveBytes += newSize - oldSize;
+    return realloc(ptr, newSize);
+}
+
+void countingDeallocate(void *ctx, void *ptr, size_t size) {
+    TCountingHeap *heap = (TCountingHeap *)ctx;
+    ++heap->frees;
+    heap->liveBytes -= size;
+    free(ptr);
+}
+
+void test_stringAllocator() {
+    TCountingHeap heap = {0};
+    TStringAllocator counting = {countingAllocate, countingReallocate, countingDeallocate, &heap};
+
+    TString s = stringInitWithAllocator(CSTRING_SSO_CAPACITY + 4, &counting);
+    assertEq(heap.allocations, 1);
+    assertEq(heap.liveBytes, CSTRING_SSO_CAPACITY + 4);
+    stringAppendCharArr(&s, "hello, allocator");
+    stringAppendInt(&s, 42);
+    assertEq(heap.liveBytes, s.capacity);
+    assertEq(strncmp(stringData(&s), "hello, allocator42", stringLen(s)), 0);
+    stringDestroy(&s);
+    assertEq(heap.liveBytes, 0);
+    assertEq(heap.frees, 1);
+
+    assertEq(stringGetDefaultAllocator(), stringMallocAllocator());
+    stringSetDefaultAllocator(&counting);
+    heap = (TCountingHeap){0};
+    TString a = stringInitWithCharArr("abc");
+    stringReserve(&a, CSTRING_SSO_CAPACITY + 1);
+    TString b = stringInitWithInt(-7);
+    TString empty = {0};
+    stringPushBack(&empty, 'x');
+    stringSetDefaultAllocator(NULL);
+    assertEq(stringGetDefaultAllocator(), stringMallocAllocator());
+
+    // strings keep the allocator they were created with
+    stringAppendRepeat(&a, 'z', 100);
+    assertEq(a.allocator, &counting);
+    assertEq(empty.allocator, &counting);
+    // inline strings never reach the allocator
+    size_t heapStrings = 1 + !stringIsInline(&b) + !stringIsInline(&empty);
+    assertEq(heap.liveBytes, a.capacity + (stringIsInline(&b) ? 0 : b.capacity) + (stringIsInline(&empty) ? 0 : empty.capacity));
+    stringDestroy(&a);
+    stringDestroy(&b);
+    stringDestroy(&empty);
+    assertEq(heap.liveBytes, 0);
+    assertEq(heap.frees, heapStrings);
+
+    heap = (TCountingHeap){0};
+    TString d = stringInitWithAllocator(4, &counting);
+    stringAppendCharArr(&d, "to a char array");
+    size_t live = heap.liveBytes;
+    char *arr = stringConvertToCharArr(d);
+    assertEq(strcmp(arr, "to a char array"), 0);
+    assertEq(heap.liveBytes, live + stringLen(d) + 1);
+    stringFreeCharArr(&d, arr);
+    assertEq(heap.liveBytes, live);
+    stringDestroy(&d);
+    assertEq(heap.liveBytes, 0);
+
+    TString c = stringInit(8);
+    assertEq(c.allocator, stringMallocAllocator());
+    stringDestroy(&c);
+    printGreen("test_stringAllocator\n");
+}
+
+void test_stringFormat() {
+    TString name = stringInitWithCharArr("worker-7");
+    TString str = stringFormat("%s %S id=%05d hex=%#x f=%.3f r=%r %-4c| %%", "job", name, 42, 255, 2.5, 0.1, 'z');
+    assertEq(isError(), 0);
+    assertEq(stringViewIsEqual(stringViewOf(&str), stringViewFromCharArr("job worker-7 id=00042 hex=0xff f=2.500 r=0.1 z   | %")), true);
+
+    stringAppendFormat(&str, " [%*.*S] %lld %zu", 6, 3, name, (long long)INT64_MIN, (size_t)7);
+    assertEq(stringViewIsEqual(stringViewOf(&str),
+                               stringViewFromCharArr("job worker-7 id=00042 hex=0xff f=2.500 r=0.1 z   | % [   wor] -9223372036854775808 7")),
+             true);
+    stringDestroy(&str);
+
+    // everything except %S and %r must match snprintf
+    const char *formats[] = {"%d|%+d|% d|%8d|%-8d|%.5d|%08.3d", "%u|%x|%X|%o|%#o|%#X|%10.4x", "%f|%.0f|%#.0f|%+.2f|%012.4f|%-9.1f|",
+                             "%e|%.3g|%G|%10.2e", "%c%5c%-3c|", "%s|%.2s|%8s|%-8s|"};
+    char buf[256];
+    for (size_t i = 0; i < 200; ++i) {
+        int v = rand() - RAND_MAX / 2;
+        double d = (double)v / 1000;
+        str = stringInit(1);
+        int len = 0;
+        switch (i % 6) {
+            case 0:
+                stringAppendFormat(&str, formats[0], v, v, v, v, v, v, v);
+                len = snprintf(buf, sizeof(buf), formats[0], v, v, v, v, v, v, v);
+                break;
+            case 1:
+                stringAppendFormat(&str, formats[1], v, v, v, v, v, v, v);
+                len = snprintf(buf, sizeof(buf), formats[1], v, v, v, v, v, v, v);
+                break;
+            case 2:
+                stringAppendFormat(&str, formats[2], d, d, d, d, d, d);
+                len = snprintf(buf, sizeof(buf), formats[2], d, d, d, d, d, d);
+                break;
+            case 3:
+                stringAppendFormat(&str, formats[3], d, d, d, d);
+                len = snprintf(buf, sizeof(buf), formats[3], d, d, d, d);
+                break;
+            case 4:
+                stringAppendFormat(&str, formats[4], 'a' + (int)i % 26, 'b', 'c');
+                len = snprintf(buf, sizeof(buf), formats[4], 'a' + (int)i % 26, 'b', 'c');
+                break;
+            default:
+                stringAppendFormat(&str, formats[5], "abc", "abc", "abc", "abc");
+                len = snprintf(buf, sizeof(buf), formats[5], "abc", "abc", "abc", "abc");
+                break;
+        }
+        assertEq(str.size, (size_t)len);
+        assertEq(memcmp(stringData(&str), buf, str.size), 0);
+        stringDestroy(&str);
+    }
+
+    // the buffer is grown once, however many conversions there are
+    TCountingHeap heap = {0};
+    TStringAllocator counting = {countingAllocate, countingReallocate, countingDeallocate, &heap};
+    str = stringInitWithAllocator(CSTRING_SSO_CAPACITY + 1, &counting);
+    stringAppendFormat(&str, "%s=%d %s=%d %s=%d %S", "alpha", 1, "beta", 2, "gamma", 3, name);
+    assertEq(heap.allocations, 2);
+    assertEq(str.size, strlen("alpha=1 beta=2 gamma=3 worker-7"));
+
+    stringAppendFormat(&str, "%q", 1);
+    assertEq(ERROR_CODE, ERR_INVALID_FORMAT);
+    assertEq(str.size, strlen("alpha=1 beta=2 gamma=3 worker-7"));
+    stringDestroy(&str);
+
+    // arguments may point into the string being appended to
+    str = stringInitWithCharArr("ab");
+    for (size_t i = 0; i < 6; ++i) {
+        stringAppendFormat(&str, "%S|%.2s", str, stringData(&str));
+    }
+    assertEq(str.size, 5 * 64 - 3);
+    assertEq(strncmp(stringData(&str), "abab|ababab|ab|ab", 17), 0);
+    stringDestroy(&str);
+    stringDestroy(&name);
+
+    printGreen("test_stringFormat\n");
+}
+
+void test_stringArena() {
+    TCountingHeap parentHeap = {0};
+    TStringAllocator parent = {countingAllocate, countingReallocate, countingDeallocate, &parentHeap};
+    TStringArena arena;
+    stringArenaInit(&arena, 64, &parent);
+    const TStringAllocator *a = stringArenaAllocator(&arena);
+
+    TString s = stringInitWithAllocator(CSTRING_SSO_CAPACITY + 4, a);
+    char *first = stringData(&s);
+    stringAppendCharArr(&s, "grows in place");
+    assertEq(stringData(&s), first);
+    assertEq(strncmp(stringData(&s), "grows in place", stringLen(s)), 0);
+
+    TString t = stringInitWithAllocator(CSTRING_SSO_CAPACITY + 8, a);
+    stringAppendCharArr(&t, "next");
+    stringAppendCharArr(&s, " and then moves");
+    assertNotEq(stringData(&s), first);
+    assertEq(strncmp(stringData(&s), "grows in place and then moves", stringLen(s)), 0);
+    assertEq(strncmp(stringData(&t), "next", stringLen(t)), 0);
+
+    // larger than a chunk
+    TString big = stringInitWithAllocator(1000, a);
+    stringAppendRepeat(&big, 'x', 1000);
+    assertEq(stringCount(big, 'x'), 1000);
+    stringDestroy(&big);
+
+    stringArenaReset(&arena);
+    TString again = stringInitWithAllocator(CSTRING_SSO_CAPACITY + 4, a);
+    assertEq(stringData(&again), first);
+
+    stringSetThreadAllocator(a);
+    TString hello = stringInitWithCharArr("hello");
+    TString world = stringInitWithCharArr("world");
+    TString joined = stringJoinCharArr(hello, world, ", ");
+    TString sub = stringSubstring(joined, 7, 5);
+    TString cat = stringConcat(sub, hello);
+    stringSetThreadAllocator(NULL);
+    assertEq(stringGetThreadAllocator(), NULL);
+    assertEq(joined.allocator, a);
+    assertEq(cat.allocator, a);
+    assertEq(strncmp(stringData(&joined), "hello, world", stringLen(joined)), 0);
+    assertEq(strncmp(stringData(&cat), "worldhello", stringLen(cat)), 0);
+
+    TString heap = stringInit(4);
+    assertEq(heap.allocator, stringMallocAllocator());
+    stringDestroy(&heap);
+
+    // chunks come from the parent allocator and go back to it
+    assertNotEq(parentHeap.allocations, 0);
+    size_t chunks = parentHeap.allocations;
+    stringArenaReset(&arena);
+    stringArenaDestroy(&arena);
+    assertEq(parentHeap.frees, chunks);
+    assertEq(parentHeap.liveBytes, 0);
+    printGreen("test_stringArena\n");
+}
+
+void test_stringSmallInline() {
+    TString s = stringInitWithCharArr("token");
+    TString n = stringInitWithInt(-12345);
+    if (CSTRING_SSO_CAPACITY >= 6) {
+        assertEq(stringIsInline(&s), true);
+        assertEq(stringIsInline(&n), true);
+    }
+    assertEq(strncmp(stringData(&n), "-12345", 6), 0);
+
+    TString copy = stringDeepCopy(s);
+    stringToUpper(&copy);
+    assertEq(strncmp(stringData(&s), "token", 5), 0);
+    assertEq(strncmp(stringData(&copy), "TOKEN", 5), 0);
+    assertEq(stringIsEqualIgnoreCase(s, copy), true);
+
+    char expected[128] = "token";
+    for (size_t i = 5; i < 100; ++i) {
+        stringPushBack(&s, (char)('a' + i % 26));
+        expected[i] = (char)('a' + i % 26);
+        assertEq(stringLen(s), i + 1);
+        assertEq(memcmp(stringData(&s), expected, i + 1), 0);
+        if (i + 1 > CSTRING_SSO_CAPACITY) assertEq(stringIsInline(&s), false);
+    }
+    assertEq(stringFindFirstCharArr(s, "fgh"), 5);
+    assertEq(stringFindFirstCharArr(s, "xyzab"), 23);
+
+    TString joined = stringJoinCharArr(copy, n, "=");
+    assertEq(strncmp(stringData(&joined), "TOKEN=-12345", stringLen(joined)), 0);
+    TString sub = stringSubstring(s, 0, 5);
+    assertEq(stringIsEqual(sub, copy), false);
+    assertEq(stringIsEqualIgnoreCase(sub, copy), true);
+
+    TStrVec v = stringVecInit(2);
+    stringVecPushBack(&v, n);
+    stringVecPushBackCharArr(&v, "x");
+    assertEq(stringIsEqual(v.data[0], n), true);
+    assertEq(stringLen(v.data[1]), 1);
+    stringVecDestroy(&v);
+
+    char *arr = stringConvertToCharArr(sub);
+    assertEq(strcmp(arr, "token"), 0);
+    stringFreeCharArr(&sub, arr);
+
+    stringDestroy(&sub);
+    stringDestroy(&joined);
+    stringDestroy(&copy);
+    stringDestroy(&n);
+    stringDestroy(&s);
+    printGreen("test_stringSmallInline\n");
+}
+
+void test_stringView() {
+    TString owner = stringInitWithCharArr("  key = -1234 ; name=  Alice\t\n");
+    TStringView all = stringViewOf(&owner);
+    assertEq(all.data, stringData(&owner));
+    assertEq(all.size, stringLen(owner));
+
+    TStringView trimmed = stringViewTrim(all);
+    assertEq(stringViewIsEqual(trimmed, stringViewFromCharArr("key = -1234 ; name=  Alice")), true);
+    assertEq(stringViewStartWith(trimmed, stringViewFromCharArr("key")), true);
+    assertEq(stringViewEndWith(trimmed, stringViewFromCharArr("Alice")), true);
+    assertEq(stringViewEndWith(trimmed, stringViewFromCharArr("alice")), false);
+
+    int64_t sep = stringViewFindFirst(trimmed, stringViewFromCharArr(";"));
+    assertEq(sep, 12);
+    TStringView first = stringViewTrim(stringViewSubstring(trimmed, 0, (size_t)sep));
+    TStringView value = stringViewTrim(stringViewStripPrefix(first, stringViewFromCharArr("key =")));
+    assertEq(stringViewToInt(value), -1234);
+    assertEq(isError(), false);
+    assertEq(stringViewStripPrefix(first, stringViewFromCharArr("nope")).size, first.size);
+
+    TStringView second = stringViewTrim(stringViewSubstring(trimmed, (size_t)sep + 1, trimmed.size));
+    TStringView name = stringViewStripSuffix(second, stringViewFromCharArr("Alice"));
+    assertEq(stringViewIsEqual(name, stringViewFromCharArr("name=  ")), true);
+    assertEq(stringViewIsEqualIgnoreCase(stringViewStripPrefix(second, name), stringViewFromCharArr("ALICE")), true);
+    assertEq(stringViewCompare(stringViewFromCharArr("abc"), stringViewFromCharArr("abd")), -1);
+    assertEq(stringViewCompare(stringViewFromCharArr("abc"), stringViewFromCharArr("ab")), 1);
+
+    // out of range slices are clamped
+    assertEq(stringViewSubstring(all, 100, 5).size, 0);
+    assertEq(stringViewSubstring(all, 2, 1000).size, all.size - 2);
+    assertEq(stringViewTrim(stringViewFromCharArr(" \t\n ")).size, 0);
+    assertEq(stringViewFromCharArr(NULL).size, 0);
+
+    TStringView num = stringViewFromCharArr("x3.25y");
+    assertEq(stringViewToDouble(stringViewSubstring(num, 1, 4)) == 3.25, true);
+
+    TString copy = stringViewToString(name);
+    assertEq(stringLen(copy), 7);
+    assertNotEq(stringData(&copy), name.data);
+    assertEq(stringStartWithCharArr(copy, "name"), true);
+
+    stringDestroy(&copy);
+    stringDestroy(&owner);
+    printGreen("test_stringView\n");
+}
+
+size_t collectFields(TStringSplitIter it, const char **expected, size_t count) {
+    TStringView field;
+    size_t n = 0;
+    while (stringSplitNext(&it, &field)) {
+        assert(n < count);
+        assertEq(stringViewIsEqual(field, stringViewFromCharArr(expected[n])), true);
+        ++n;
+    }
+    assertEq(stringSplitNext(&it, &field), false);
+    return n;
+}
+
+void test_stringSplit() {
+    TStringView csv = stringViewFromCharArr("a,b,,c,");
+    const char *byComma[] = {"a", "b", "", "c", ""};
+    assertEq(collectFields(stringSplitIter(csv, ','), byComma, 5), 5);
+
+    TStringSplitIter it = stringSplitIter(csv, ',');
+    it.skipEmpty = true;
+    const char *nonEmpty[] = {"a", "b", "c"};
+    assertEq(collectFields(it, nonEmpty, 3), 3);
+
+    it = stringSplitIter(csv, ',');
+    it.maxSplits = 2;
+    const char *limited[] = {"a", "b", ",c,"};
+    assertEq(collectFields(it, limited, 3), 3);
+
+    const char *whole[] = {""};
+    assertEq(collectFields(stringSplitIter(stringViewFromCharArr(""), ','), whole, 1), 1);
+    it = stringSplitIter(stringViewFromCharArr(""), ',');
+    it.skipEmpty = true;
+    assertEq(collectFields(it, whole, 0), 0);
+
+    it = stringSplitIterAnyOf(stringViewFromCharArr(" key=value;\tother = 2 "), " =;\t");
+    it.skipEmpty = true;
+    const char *tokens[] = {"key", "value", "other", "2"};
+    assertEq(collectFields(it, tokens, 4), 4);
+
+    TStringView text = stringViewFromCharArr("one::two:three::::four");
+    const char *bySub[] = {"one", "two:three", "", "four"};
+    assertEq(collectFields(stringSplitIterSubstring(text, stringViewFromCharArr("::")), bySub, 4), 4);
+    const char *noSplit[] = {"one::two:three::::four"};
+    assertEq(collectFields(stringSplitIterSubstring(text, stringViewFromCharArr("")), noSplit, 1), 1);
+
+    TString line = stringInitWithCharArr("GET /index.html HTTP/1.1");
+    TStrVec parts = stringSplitCharArr(line, " ");
+    assertEq(parts.size, 3);
+    assertEq(parts.packed, true);
+    assertEq(stringViewStartWith(stringVecGet(&parts, 1), stringViewFromCharArr("/index")), true);
+    assertEq(stringVecGet(&parts, 2).size, 8);
+    stringVecDestroy(&parts);
+
+    TString empty = {0};
+    parts = stringSplitCharArr(empty, ",");
+    assertEq(parts.size, 1);
+    assertEq(stringVecGet(&parts, 0).size, 0);
+    stringVecDestroy(&parts);
+    stringDestroy(&line);
+
+    // the vector kernels agree with a scalar scan at every alignment
+    const char *sets[] = {",", ",;", " \t\n\r", ",;:|/\\-_", "abcdefghijklmnop"};
+    ESimdLevel detected = stringGetSimdLevel();
+    char buf[300];
+    for (size_t t = 0; t < 200; ++t) {
+        size_t n = (size_t)(rand() % 300);
+        for (size_t i = 0; i < n; ++i) {
+            buf[i] = (char)('A' + rand() % 20);
+        }
+        if (n > 0 && rand() % 2) buf[rand() % n] = ',';
+        for (size_t k = 0; k < sizeof(sets) / sizeof(sets[0]); ++k) {
+            int64_t expected = -1;
+            for (size_t i = 0; i < n && expected < 0; ++i) {
+                if (strchr(sets[k], buf[i]) != NULL) expected = (int64_t)i;
+            }
+            for (int level = SIMD_SCALAR; level <= (int)detected; ++level) {
+                stringSetSimdLevel((ESimdLevel)level);
+                TStringView field;
+                TStringSplitIter scan = stringSplitIterAnyOf((TStringView){buf, n}, sets[k]);
+                assertEq(stringSplitNext(&scan, &field), true);
+                assertEq(field.size, expected < 0 ? n : (size_t)expected);
+            }
+        }
+    }
+    stringSetSimdLevel(detected);
+    printGreen("test_stringSplit\n");
+}
+
 void test_stringReverse() {
     TString str = stringInitWithCharArr("hello");
     stringReverse(&str);
 
     assertEq(stringLen(str), 5);
-    assertEq(strncmp(str.data, "olleh", stringLen(str)), 0);
+    assertEq(strncmp(stringData(&str), "olleh", stringLen(str)), 0);
 
     stringDestroy(&str);
     printGreen("test_stringReverse\n");
@@ -306,12 +1593,21 @@ void test_stringCompare() {
     TString s2 = stringInitWithCharArr("hello");
     TString s3 = stringInitWithCharArr("heaa");
 
+    TString s4 = stringInitWithCharArr("HELLO world");
+    TString empty = {0};
+
     assertEq(stringCompare(s1, s2), 0);
-    assertEq(stringCompare(s1, s3), -1);
+    assertEq(stringCompare(s1, s3), 1);
+    assertEq(stringCompare(s3, s1), -1);
+    assertEq(stringCompare(s1, s4), -1);
+    assertEq(stringCompare(s4, s1), 1);
+    assertEq(stringCompare(empty, s1), -1);
+    assertEq(stringCompare(empty, empty), 0);
 
     stringDestroy(&s1);
     stringDestroy(&s2);
     stringDestroy(&s3);
+    stringDestroy(&s4);
     printGreen("test_stringCompare\n");
 }
 
@@ -362,6 +1658,7 @@ void test_stringContains() {
 
     assertEq(stringContains(s, p1), true);
     assertEq(stringContains(s, p2), false);
+    assertEq(stringContainsCharArr(s, "hi good"), true);
 
     stringDestroy(&s);
     stringDestroy(&p1);
@@ -436,22 +1733,22 @@ void test_stringPad() {
     stringPadLeft(&str, 20, ' ');
 
     assertEq(stringLen(str), 20);
-    assertEq(strncmp(str.data, "       Hello, World!", stringLen(str)), 0);
+    assertEq(strncmp(stringData(&str), "       Hello, World!", stringLen(str)), 0);
 
     stringPadLeft(&str, 10, ' ');
     assertEq(stringLen(str), 20);
-    assertEq(strncmp(str.data, "       Hello, World!", stringLen(str)), 0);
+    assertEq(strncmp(stringData(&str), "       Hello, World!", stringLen(str)), 0);
 
     stringTrim(&str);
 
     stringPadRight(&str, 20, ' ');
 
     assertEq(stringLen(str), 20);
-    assertEq(strncmp(str.data, "Hello, World!       ", stringLen(str)), 0);
+    assertEq(strncmp(stringData(&str), "Hello, World!       ", stringLen(str)), 0);
 
     stringPadRight(&str, 10, ' ');
     assertEq(stringLen(str), 20);
-    assertEq(strncmp(str.data, "Hello, World!       ", stringLen(str)), 0);
+    assertEq(strncmp(stringData(&str), "Hello, World!       ", stringLen(str)), 0);
 
     stringDestroy(&str);
     printGreen("test_stringPad\n");
@@ -461,7 +1758,7 @@ void test_stringRemove() {
     TString s = stringInitWithCharArr("Hello, World! testing remove");
 
     stringRemove(&s, stringFindFirstCharArr(s, "test"), 8);
-    assertEq(strncmp(s.data, "Hello, World! remove", stringLen(s)), 0);
+    assertEq(strncmp(stringData(&s), "Hello, World! remove", stringLen(s)), 0);
 
     stringRemove(&s, 0, 10000);
     assertEq(stringIsEmpty(s), true);
@@ -486,10 +1783,129 @@ void test_stringToInt() {
     stringDestroy(&s2);
     stringDestroy(&s3);
     stringDestroy(&s4);
-  
+
+    assertEq(stringViewToInt(stringViewFromCharArr("+42")), 42);
+    assertEq(stringViewToInt(stringViewFromCharArr("-0")), 0);
+    assertEq(stringViewToInt(stringViewFromCharArr("0000000000000000000000000017")), 17);
+    assertEq(isError(), false);
+    const char *invalid[] = {"", "-", "+", "12a", "1 ", " 1", "--1", "+-1"};
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); ++i) {
+        assertEq(stringViewToInt(stringViewFromCharArr(invalid[i])), 0);
+        assertEq(ERROR_CODE, ERR_INVALID_NUMBER_REPR);
+    }
+    assertEq(stringViewToInt(stringViewFromCharArr("9223372036854775808")), INT64_MAX);
+    assertEq(ERROR_CODE, ERR_NUMBER_OVERFLOW);
+    assertEq(stringViewToInt(stringViewFromCharArr("-9223372036854775809")), INT64_MIN);
+    assertEq(ERROR_CODE, ERR_NUMBER_OVERFLOW);
+
+    assertEq(stringViewToUint(stringViewFromCharArr("18446744073709551615")), UINT64_MAX);
+    assertEq(isError(), false);
+    stringViewToUint(stringViewFromCharArr("18446744073709551616"));
+    assertEq(ERROR_CODE, ERR_NUMBER_OVERFLOW);
+    stringViewToUint(stringViewFromCharArr("99999999999999999999"));
+    assertEq(ERROR_CODE, ERR_NUMBER_OVERFLOW);
+    stringViewToUint(stringViewFromCharArr("-1"));
+    assertEq(ERROR_CODE, ERR_INVALID_NUMBER_REPR);
+
+    assertEq(stringViewToInt32(stringViewFromCharArr("-2147483648")), INT32_MIN);
+    assertEq(stringViewToInt32(stringViewFromCharArr("2147483647")), INT32_MAX);
+    assertEq(isError(), false);
+    assertEq(stringViewToInt32(stringViewFromCharArr("2147483648")), INT32_MAX);
+    assertEq(ERROR_CODE, ERR_NUMBER_OVERFLOW);
+
+    size_t consumed = 0;
+    assertEq(stringViewParseInt(stringViewFromCharArr("-123,456"), &consumed), -123);
+    assertEq(consumed, 4);
+    assertEq(stringViewParseUint(stringViewFromCharArr("12345678901234567x"), &consumed), 12345678901234567ULL);
+    assertEq(consumed, 17);
+    assertEq(stringViewParseInt32(stringViewFromCharArr("x1"), &consumed), 0);
+    assertEq(consumed, 0);
+    assertEq(ERROR_CODE, ERR_INVALID_NUMBER_REPR);
+    // an overflowing run is consumed whole
+    stringViewParseInt(stringViewFromCharArr("123456789012345678901234567890;"), &consumed);
+    assertEq(consumed, 30);
+    assertEq(ERROR_CODE, ERR_NUMBER_OVERFLOW);
+
+    char buf[32];
+    srand(5);
+    for (size_t i = 0; i < 10000; ++i) {
+        int64_t expected = (int64_t)(((uint64_t)rand() << 42) ^ ((uint64_t)rand() << 21) ^ (uint64_t)rand());
+        expected >>= rand() % 63;
+        if (rand() % 2) expected = -expected;
+        int len = snprintf(buf, sizeof(buf), "%" PRId64 "!", expected);
+        assertEq(stringViewParseInt(stringViewFromCharArr(buf), &consumed), expected);
+        assertEq(consumed, (size_t)len - 1);
+    }
+
     printGreen("test_stringToInt\n");
 }
 
+void test_stringParseColumn() {
+    int64_t ints[8];
+    uint8_t errors[8];
+    TStringView rest = stringViewFromCharArr("1,-2\n+3,,x7,99999999999999999999\n42\n");
+    assertEq(stringParseInts(&rest, ",\n", ints, errors, 8), 7);
+    assertEq(rest.size, 0);
+    int64_t expected[] = {1, -2, 3, 0, 0, INT64_MAX, 42};
+    uint8_t expectedErrors[] = {ERR_NO_ERROR, ERR_NO_ERROR, ERR_NO_ERROR, ERR_INVALID_NUMBER_REPR,
+                                ERR_INVALID_NUMBER_REPR, ERR_NUMBER_OVERFLOW, ERR_NO_ERROR};
+    for (size_t i = 0; i < 7; ++i) {
+        assertEq(ints[i], expected[i]);
+        assertEq(errors[i], expectedErrors[i]);
+    }
+
+    // batches resume where the previous one stopped
+    uint64_t uints[2];
+    rest = stringViewFromCharArr("10;20;30;-1");
+    assertEq(stringParseUints(&rest, ";", uints, NULL, 2), 2);
+    assertEq(uints[0], 10);
+    assertEq(uints[1], 20);
+    assertEq(stringViewIsEqual(rest, stringViewFromCharArr("30;-1")), true);
+    assertEq(stringParseUints(&rest, ";", uints, errors, 2), 2);
+    assertEq(uints[0], 30);
+    assertEq(errors[1], ERR_INVALID_NUMBER_REPR);
+    assertEq(stringParseUints(&rest, ";", uints, errors, 2), 0);
+
+    double doubles[4];
+    rest = stringViewFromCharArr("1.5|-0.25|abc|7");
+    assertEq(stringParseDoubles(&rest, "|", doubles, errors, 4), 4);
+    assertEq(doubles[0], 1.5);
+    assertEq(doubles[1], -0.25);
+    assertEq(errors[2], ERR_INVALID_NUMBER_REPR);
+    assertEq(doubles[3], 7);
+    assertEq(errors[3], ERR_NO_ERROR);
+
+    // cross-check against stringSplitNext + stringViewToInt on random columns
+    TString column = {0};
+    char buf[32];
+    srand(8);
+    for (size_t i = 0; i < 2000; ++i) {
+        int len = 0;
+        if (rand() % 10 == 0) {
+            len = snprintf(buf, sizeof(buf), "%dz", rand());
+        } else {
+            len = snprintf(buf, sizeof(buf), "%lld", (long long)rand() * (rand() % 2 ? -1 : 1) * rand());
+        }
+        stringAppendChars(&column, buf, (size_t)len);
+        stringPushBack(&column, "\n,"[rand() % 2]);
+    }
+    int64_t values[2000];
+    uint8_t flags[2000];
+    rest = stringViewOf(&column);
+    assertEq(stringParseInts(&rest, ",\n", values, flags, 2000), 2000);
+    TStringSplitIter it = stringSplitIterAnyOf(stringViewOf(&column), ",\n");
+    TStringView field;
+    for (size_t i = 0; i < 2000; ++i) {
+        assertEq(stringSplitNext(&it, &field), true);
+        int64_t v = stringViewToInt(field);
+        assertEq(flags[i], ERROR_CODE);
+        assertEq(values[i], v);
+    }
+    stringDestroy(&column);
+
+    printGreen("test_stringParseColumn\n");
+}
+
 void test_stringToDouble() {
     TString s1 = stringInitWithCharArr("0");
     TString s2 = stringInitWithCharArr("1.03459");
@@ -503,7 +1919,52 @@ void test_stringToDouble() {
     stringDestroy(&s2);
     stringDestroy(&s3);
 
-    printGreen("stringToDouble\n");
+    const char *valid[] = {"+.5", "5.", "-0.0", "1e10", "1E-5", "2.5e+3", "0.1", "123456789012345678901234567890",
+                           "2.2250738585072011e-308", "4.9e-324", "1.7976931348623157e308", "9007199254740993",
+                           "0.000000000000000000000000000000000000001", "1e-400"};
+    for (size_t i = 0; i < sizeof(valid) / sizeof(valid[0]); ++i) {
+        double got = stringViewToDouble(stringViewFromCharArr(valid[i]));
+        assertEq(isError(), false);
+        assertEq(got, strtod(valid[i], NULL));
+    }
+    const char *invalid[] = {"", ".", "-", "+e1", ".e1", "1.2.3", "1e5x", "0x10", " 1"};
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); ++i) {
+        assertEq(stringViewToDouble(stringViewFromCharArr(invalid[i])), 0);
+        assertEq(ERROR_CODE, ERR_INVALID_NUMBER_REPR);
+    }
+    assertEq(stringViewToDouble(stringViewFromCharArr("-Infinity")), -strtod("inf", NULL));
+    assertEq(stringViewToDouble(stringViewFromCharArr("INF")), strtod("inf", NULL));
+    double nan = stringViewToDouble(stringViewFromCharArr("nan"));
+    assertEq(nan != nan, true);
+    assertEq(stringViewToDouble(stringViewFromCharArr("1e400")), strtod("inf", NULL));
+    assertEq(ERROR_CODE, ERR_NUMBER_OVERFLOW);
+
+    size_t consumed = 0;
+    assertEq(stringViewParseDouble(stringViewFromCharArr("3.25e2ms"), &consumed), 325);
+    assertEq(consumed, 6);
+    assertEq(stringViewParseDouble(stringViewFromCharArr("7e"), &consumed), 7);
+    assertEq(consumed, 1);
+    assertEq(stringViewParseDouble(stringViewFromCharArr("infinite"), &consumed), strtod("inf", NULL));
+    assertEq(consumed, 3);
+
+    // bit-exact round trips of random doubles
+    char buf[64];
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    for (size_t i = 0; i < 100000; ++i) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        double expected;
+        memcpy(&expected, &state, sizeof(expected));
+        if (expected != expected) continue;
+        int len = snprintf(buf, sizeof(buf), i % 2 ? "%.17g" : "%.6e", expected);
+        double got = stringViewParseDouble((TStringView){buf, (size_t)len}, &consumed);
+        double reference = strtod(buf, NULL);
+        assertEq(memcmp(&got, &reference, sizeof(got)), 0);
+        assertEq(consumed, (size_t)len);
+    }
+
+    printGreen("test_stringToDouble\n");
 }
 
 void test_stringCapitalize(){
@@ -537,14 +1998,143 @@ void test_stringCapitalize(){
     printGreen("test_stringCapitalize\n");
 }
 
+void test_stringCharClassKernels() {
+    ESimdLevel detected = stringGetSimdLevel();
+    for (int level = SIMD_SCALAR; level <= SIMD_AVX2; ++level) {
+        if (stringSetSimdLevel((ESimdLevel)level) != (ESimdLevel)level) continue;
+        for (size_t n = 1; n < 150; ++n) {
+            TString digits = stringInit(n);
+            TString alphas = stringInit(n);
+            for (size_t i = 0; i < n; ++i) {
+                stringPushBack(&digits, '0' + i % 10);
+                stringPushBack(&alphas, (i % 3 == 0 ? 'A' : 'a') + i % 26);
+            }
+            assertEq(stringIsDigits(digits), true);
+            assertEq(stringIsAlphas(alphas), true);
+            assertEq(stringIsAlphas(digits), false);
+            assertEq(stringCount(digits, '7'), (n + 2) / 10);
+
+            for (size_t i = 0; i < n; ++i) {
+                const char bad[] = {'/', ':', 'a', '\x80', '\xb0'};
+                const char badAlpha[] = {'@', '[', '`', '{', '\xc1'};
+                char saved = stringData(&digits)[i];
+                stringData(&digits)[i] = bad[i % 5];
+                assertEq(stringIsDigits(digits), false);
+                stringData(&digits)[i] = saved;
+                saved = stringData(&alphas)[i];
+                stringData(&alphas)[i] = badAlpha[i % 5];
+                assertEq(stringIsAlphas(alphas), false);
+                stringData(&alphas)[i] = saved;
+            }
+
+            TString palindrome = stringDeepCopy(alphas);
+            for (size_t i = 0; i < n; ++i) {
+                stringPushBack(&palindrome, stringData(&alphas)[n - i - 1]);
+            }
+            assertEq(stringIsPalindrome(palindrome), true);
+            stringData(&palindrome)[n / 3] = '#';
+            assertEq(stringIsPalindrome(palindrome), false);
+            stringPopBack(&palindrome);
+            stringReverse(&palindrome);
+            palindrome.size = n - 1;
+            assertEq(stringIsPalindrome(palindrome), _stringIsPalindromeScalar(stringData(&palindrome), palindrome.size));
+
+            stringDestroy(&digits);
+            stringDestroy(&alphas);
+            stringDestroy(&palindrome);
+        }
+    }
+    stringSetSimdLevel(detected);
+    assertEq(stringGetSimdLevel(), detected);
+
+    printGreen("test_stringCharClassKernels\n");
+}
+
+void test_stringCaseKernels() {
+    ESimdLevel detected = stringGetSimdLevel();
+    for (int level = SIMD_SCALAR; level <= SIMD_AVX2; ++level) {
+        if (stringSetSimdLevel((ESimdLevel)level) != (ESimdLevel)level) continue;
+        TString all = stringInit(256 * 3);
+        for (size_t i = 0; i < 256 * 3; ++i) {
+            stringPushBack(&all, (char)(i % 256));
+        }
+        TString upper = stringDeepCopy(all);
+        TString lower = stringDeepCopy(all);
+        stringToUpper(&upper);
+        stringToLower(&lower);
+        for (size_t i = 0; i < all.size; ++i) {
+            assertEq(stringData(&upper)[i], stringCharToUpper(stringData(&all)[i]));
+            assertEq(stringData(&lower)[i], stringCharToLower(stringData(&all)[i]));
+        }
+        assertEq(stringIsEqualIgnoreCase(upper, lower), true);
+
+        for (size_t n = 0; n < 100; ++n) {
+            TString a = stringSubstring(upper, 60, n);
+            TString b = stringSubstring(lower, 60, n);
+            assertEq(stringIsEqualIgnoreCase(a, b), true);
+            for (size_t i = 0; i < n; ++i) {
+                char saved = stringData(&b)[i];
+                stringData(&b)[i] = '#';
+                assertEq(stringIsEqualIgnoreCase(a, b), false);
+                stringData(&b)[i] = saved;
+            }
+            stringDestroy(&a);
+            stringDestroy(&b);
+        }
+
+        stringDestroy(&all);
+        stringDestroy(&upper);
+        stringDestroy(&lower);
+    }
+    stringSetSimdLevel(detected);
+
+    printGreen("test_stringCaseKernels\n");
+}
+
+void test_stringIsEqualIgnoreCase() {
+    TString s1 = stringInitWithCharArr("Content-Length");
+    TString s2 = stringInitWithCharArr("content-length");
+    TString s3 = stringInitWithCharArr("content-length:");
+    TString s4 = stringInitWithCharArr("content_length");
+
+    assertEq(stringIsEqualIgnoreCase(s1, s2), true);
+    assertEq(stringIsEqualIgnoreCase(s1, s3), false);
+    assertEq(stringIsEqualIgnoreCase(s1, s4), false);
+    assertEq(stringIsEqual(s1, s2), false);
+
+    stringDestroy(&s1);
+    stringDestroy(&s2);
+    stringDestroy(&s3);
+    stringDestroy(&s4);
+
+    printGreen("test_stringIsEqualIgnoreCase\n");
+}
+
 int main() {
     test_stringStartWith();
+    test_stringStartWithCharArr();
+    test_stringEndWithCharArr();
+    test_stringIsEqual();
     test_stringEndWith();
     test_stringLen();
     test_stringFindFirst();
+    test_stringFindFirstPeriodic();
+    test_stringFindFirstRandom();
+    test_stringPattern();
+    test_stringCountSubstring();
+    test_stringVec();
+    test_stringVecPacked();
+    test_stringVecSort();
+    test_stringMultiMatcher();
+    test_stringInterner();
+    test_errorState();
+    test_stringHash();
+    test_stringHashMap();
     test_stringFindFirstCharArr();
     test_stringInit();
     test_stringInitWithInt();
+    test_stringInitWithDouble();
+    test_stringFormat();
     test_stringInitWithCharArr();
     test_stringCopy();
     test_stringDeepCopy();
@@ -554,6 +2144,13 @@ int main() {
     test_stringPushBack();
     test_stringTrim();
     test_stringReplaceAll();
+    test_stringReplaceAllGrow();
+    test_stringAppend();
+    test_stringAllocator();
+    test_stringArena();
+    test_stringSmallInline();
+    test_stringView();
+    test_stringSplit();
     test_stringReverse();
     test_stringCompare();
     test_stringToLower();
@@ -563,9 +2160,15 @@ int main() {
     test_stringContains();
     test_stringFilter();
     test_stringIsPalindrome();
+    test_stringCharClassKernels();
+    test_stringCaseKernels();
+    test_stringIsEqualIgnoreCase();
     test_stringPad();
     test_stringRemove();
     test_stringCapitalize();
     test_stringToInt();
+    test_stringParseColumn();
+    test_stringReadLine();
+    test_stringWrite();
     return 0;
 }